@@ -53,6 +53,13 @@
 ;;;        wrong ... otherwise will return the next available protion of solution
 ;;;      <solveMoreBubble>
 ;;;
+;;;    (solve-all) - used to acquire the whole solution to currently defined 
+;;;        problem in one turn
+;;;      returns a list of sections or an error message: the first section
+;;;        lists the solved variables, each of the others starts with a tag
+;;;        such as <PARTSLVV> or <UNSLVVARS> and lists the lines after it
+;;;      <solveAll>
+;;;
 ;;;    (power-solve strength varName dstSlot) - used to solve for specific variable
 ;;;        strength -- for now always 31
 ;;;	varName variable to solve for --- NOTE: CASE-SENSITIVE
@@ -152,32 +159,252 @@
 
 (defparameter *process* nil)
 
+;; Instead of starting a solver-program for each help session, all 
+;; sessions can share one solver-program, each with its own solver 
+;; session inside it.  Commands are then prefixed with "@name ".
+(defparameter *solver-shared-process* nil
+  "If true, help sessions share one solver-program process.")
+(defvar *shared-process* nil "The solver-program shared by all sessions.")
+(defvar *solver-session* nil "Name of the solver session inside a shared solver-program.")
+(defvar *solver-session-count* 0)
+(defvar *solver-lock* (sb-thread:make-mutex :name "solver-program"))
+
+;; Each request carries an id, "#id command", and its result comes back 
+;; as "#id //result", so requests can be sent without waiting for the 
+;; results of earlier ones (see solver-submit and solver-await).  
+;; Results not yet asked for are kept in *solver-replies*.
+;;
+;; With *solver-threads* set, the shared solver-program runs commands 
+;; for different sessions in parallel on that many threads.  A reader
+;; thread then reads all the results and hands each to the thread 
+;; waiting for it, so a slow command for one session doesn't hold up 
+;; the others.
+(defparameter *solver-threads* nil
+  "Number of worker threads in a shared solver-program, or nil for none.")
+(defvar *solver-replies* (make-hash-table :test #'equal)
+  "Results read from solver-program but not yet claimed, by request id.")
+(defvar *solver-replies-lock* (sb-thread:make-mutex :name "solver-replies"))
+(defvar *solver-replies-ready* (sb-thread:make-waitqueue))
+
+;; With *solver-framed* set, each request and result is a header line
+;; "id length" followed by exactly length characters, and the solver's
+;; debug output goes to stderr.  Results are then read without looking 
+;; for a line starting with "//", and an equation may contain anything, 
+;; even a newline.
+(defparameter *solver-framed* nil
+  "If true, talk to solver-program with length-prefixed frames.")
+(defvar *solver-request-id* 0)
+
+;; With *solver-cache-directory* set, the solution of each problem is 
+;; kept in that directory, and a problem sent again with the same 
+;; statements, by this or any other solver-program, is not solved again.
+(defparameter *solver-cache-directory* nil
+  "Directory where solver-program keeps solutions, or nil for none.")
+
+;; With *solver-problem-library* set, solver-program maps that library
+;; of problem images (made by solver-batch -library) when it starts,
+;; for solver-load-library-problem.  It is shared by all the solver
+;; processes on the machine.
+(defparameter *solver-problem-library* nil
+  "Problem library file for solver-program, or nil for none.")
+
+;; With *solver-in-process* set, no solver-program is started: libSolver
+;; is loaded into Lisp and called through its C interface (see
+;; solverapi.h), each help session with a solver context of its own.
+;; Results are copied straight into a buffer instead of being read from
+;; a pipe, and what the solver prints while debugging goes nowhere.
+(defparameter *solver-in-process* nil
+  "If true, call libSolver in this process instead of solver-program.")
+(defvar *solver-context* nil "This session's context in libSolver, in process.")
+(defvar *solver-library-loaded* nil)
+(defparameter *solver-buffer-size* 4096
+  "Room first given to a result of libSolver; a longer one is fetched after.")
+
+;; codes returned by solver_call, as in solverapi.h
+(defconstant +solver-ok+ 0)
+(defconstant +solver-failed+ 1)
+(defconstant +solver-too-small+ 2)
+
+(sb-alien:define-alien-routine ("solver_open" %solver-open)
+    sb-alien:system-area-pointer)
+(sb-alien:define-alien-routine ("solver_close" %solver-close) sb-alien:void
+  (context sb-alien:system-area-pointer))
+(sb-alien:define-alien-routine ("solver_call" %solver-call) sb-alien:int
+  (context sb-alien:system-area-pointer)
+  (command sb-alien:c-string)
+  (arg sb-alien:c-string)
+  (out (* sb-alien:char))
+  (size sb-alien:unsigned-long)
+  (length (* sb-alien:unsigned-long)))
+(sb-alien:define-alien-routine ("solver_fetch_result" %solver-fetch-result)
+    sb-alien:int
+  (context sb-alien:system-area-pointer)
+  (out (* sb-alien:char))
+  (size sb-alien:unsigned-long)
+  (length (* sb-alien:unsigned-long)))
+(sb-alien:define-alien-routine ("solver_code_name" %solver-code-name)
+    sb-alien:c-string
+  (code sb-alien:int))
+
+(defun load-solver-library ()
+  (unless *solver-library-loaded*
+    (sb-alien:load-shared-object 
+     (merge-pathnames #+darwin "libSolver.dylib" #-darwin "libSolver.so"
+		      *Andes-Path*))
+    (setf *solver-library-loaded* t)))
+
+(defun solver-call-in-process (command)
+  "Do command in this session's context, returning the result as solver-program would."
+  (let* ((space (position #\Space command))
+	 (name (subseq command 0 space))
+	 (arg (when space (subseq command (+ space 1)))))
+    (if (string= name "sync")
+	"t"				;each call is done as it is made
+	(sb-alien:with-alien ((length sb-alien:unsigned-long))
+	  ;; A result too long for the buffer is kept by the context, and
+	  ;; fetched into one of the right size; the command is done once.
+	  (do ((size *solver-buffer-size* length)
+	       (first t nil))
+	      (nil)
+	    (let ((out (sb-alien:make-alien sb-alien:char size)))
+	      (unwind-protect
+		   (let ((code (if first
+				   (%solver-call *solver-context* name arg 
+						 out size
+						 (sb-alien:addr length))
+				   (%solver-fetch-result *solver-context* 
+							 out size
+							 (sb-alien:addr length)))))
+		     (cond 
+		       ((= code +solver-ok+)
+			(return (sb-alien:cast out sb-alien:c-string)))
+		       ;; as solver-program gives it, for my-read-answer
+		       ((= code +solver-failed+)
+			(return (format nil "(solverError ~A ~A \"~A\")" 
+					name (or arg "")
+					(sb-alien:cast out sb-alien:c-string))))
+		       ((/= code +solver-too-small+)
+			(error "solver ~A: ~A" name (%solver-code-name code)))))
+		(sb-alien:free-alien out))))))))
+
+(defun solver-threaded-p ()
+  (and *solver-shared-process* *solver-threads*))
+
+(defun start-solver-program ()
+  (let ((process
+	 (sb-ext:run-program 
+	  (merge-pathnames "solver-program" *Andes-Path*) 
+	  ;; can also add the debug flag like this: '("0x10")
+	  (append (when *solver-framed* (list "-framed"))
+		  (when (solver-threaded-p)
+		    (list "-threads" (format nil "~A" *solver-threads*)))
+		  (when *solver-cache-directory*
+		    (list "-cache" (namestring *solver-cache-directory*)))
+		  (when *solver-problem-library*
+		    (list "-library" (namestring *solver-problem-library*))))
+	  :search nil :wait nil
+	  ;; frame lengths are in bytes
+	  :external-format (if *solver-framed* :latin-1 :default)
+	  :input :stream :output :stream)))
+    (when (solver-threaded-p)
+      (sb-thread:make-thread #'read-solver-replies :arguments (list process)
+			     :name "solver-program replies"))
+    process))
+
+(defun read-solver-result (stream)
+  "Read the next result, returning its request id and the result, or nil at end."
+  (if *solver-framed*
+      (let ((header (read-line stream nil)))
+	(when header
+	  (let* ((space (position #\Space header))
+		 (length (parse-integer header :start (+ space 1)))
+		 (result (make-string length)))
+	    (read-sequence result stream)
+	    (values (subseq header 0 space) result))))
+      ;; solver has a lot of print statements, so we mark the actual 
+      ;; function return as a line "#id //result"
+      (loop for line = (read-line stream nil)
+	    while line
+	    do (let ((space (position #\Space line)))
+		 (when (and space (> (length line) (+ space 2))
+			    (char= (char line 0) #\#)
+			    (string= line "//" :start1 (+ space 1) 
+				     :end1 (+ space 3)))
+		   (return (values (subseq line 1 space) 
+				   (subseq line (+ space 3)))))))))
+
+(defun read-solver-replies (process)
+  "Read results from a threaded solver-program until it exits."
+  (let ((stream (sb-ext:process-output process)))
+    (loop (multiple-value-bind (id result) (read-solver-result stream)
+	    (unless id (return))
+	    (sb-thread:with-mutex (*solver-replies-lock*)
+	      (setf (gethash id *solver-replies*) result)
+	      (sb-thread:condition-broadcast *solver-replies-ready*))))))
+
+(defun send-solver-request (line)
+  "Write line to solver-program as a request, returning its request id."
+  (let ((stream (sb-ext:process-input *process*))
+	(id (format nil "~A" (incf *solver-request-id*))))
+    (if *solver-framed*
+	(format stream "~A ~A~%~A" id (length line) line)
+	(format stream "#~A ~A~%" id line))
+    ;; RUN-PROGRAM creates its PROCESS-INPUT streams with
+    ;; :BUFFERING :FULL by default, rather than :BUFFERING :LINE.  
+    ;; Thus, it must be explicitly flushed
+    (force-output stream)
+    id))
+
 (defun solver-load ()
   "load solver, if it isn't already loaded and running"
-  (unless (and (sb-ext:process-p *process*) 
-	       (sb-ext:process-alive-p *process*))
-    (setf *process* (sb-ext:run-program 
-		     (merge-pathnames "solver-program" *Andes-Path*) 
-		     ;; can also add the debug flag like this: '("0x10")
-		     nil
-		     :search nil :wait nil
-		     :input :stream :output :stream)))
+  (cond
+    (*solver-in-process*
+     (load-solver-library)
+     (unless *solver-context*
+       (let ((context (%solver-open)))
+	 (when (zerop (sb-sys:sap-int context))
+	   (error "no memory for a solver context."))
+	 (setf *solver-context* context))))
+    (*solver-shared-process*
+     (sb-thread:with-recursive-lock (*solver-lock*)
+       (unless (and (sb-ext:process-p *shared-process*) 
+		    (sb-ext:process-alive-p *shared-process*))
+	 (setf *shared-process* (start-solver-program)))
+       (setf *process* *shared-process*)
+       (unless *solver-session*
+	 (let ((name (format nil "s~A" (incf *solver-session-count*))))
+	   ;; sent as "@name solverCreateSession name"
+	   (let ((*solver-session* name))
+	     (solver-turn (format nil "solverCreateSession ~A" name)))
+	   (setf *solver-session* name)))))
+    (t
+     (unless (and (sb-ext:process-p *process*) 
+		  (sb-ext:process-alive-p *process*))
+       (setf *process* (start-solver-program)))))
   ;; set up mapping between equation id's and solver slots
   (reset-solver-slots)
   ;; on load, ensure logging set to Lisp variable value
   (solver-logging *solver-logging*))
  
 (defun solver-unload ()
-  (when *process* ;; nil if solver-load fails
-    (write-line "exit" (sb-ext:process-input *process*))
-    ;; see comment in do-solver-turn about buffering
-    (force-output (sb-ext:process-input *process*))
-    ;; Put in small sleep to give program time to exit.
-    ;; Otherwise, process-wait will always fail the first
-    ;; time and sleep 1 second.
-    (sb-sys:serve-all-events 0.01)
-    (sb-ext:process-wait *process*)
-    (sb-ext:process-close *process*)))
+  (cond 
+    (*solver-context*
+     (%solver-close *solver-context*)
+     (setf *solver-context* nil))
+    ((null *process*)) ;; nil if solver-load fails
+    ;; Shared process keeps running; just free this session.
+    (*solver-session*
+     (let ((name *solver-session*))
+       (solver-turn (format nil "solverDestroySession ~A" name))
+       (setf *solver-session* nil)))
+    (t
+     (send-solver-request "exit")
+     ;; Put in small sleep to give program time to exit.
+     ;; Otherwise, process-wait will always fail the first
+     ;; time and sleep 1 second.
+     (sb-sys:serve-all-events 0.01)
+     (sb-ext:process-wait *process*)
+     (sb-ext:process-close *process*))))
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ;; eq slot range defined in DLL. NB: must stay in sync w/DLL!
@@ -219,32 +446,105 @@
 (defmacro do-solver-turn (name &optional input)
   ;; Solver output is double-precision
   `(let ((*read-default-float-format* 'double-float))
-    (unless (and (sb-ext:process-p *process*) 
-		 (sb-ext:process-alive-p *process*))
-      (error "external program not running."))
-    (write-line 
-     ,(if input `(concatenate 'string ,name " " ,input) `,name) 
-     (sb-ext:process-input *process*))	
-    ;; RUN-PROGRAM creates its PROCESS-INPUT streams with
-    ;; :BUFFERING :FULL by default, rather than :BUFFERING :LINE.  
-    ;; Thus, it must be explicitly flushed
-    (force-output (sb-ext:process-input *process*))
-    (read-until-match (sb-ext:process-output *process*))))
-
-(defun read-until-match (stream)
-    "solver has a lot of print statements, so we mark the actual function return as a line starting with //"
-    (do ((line (read-line stream) (read-line stream)))
-	((and (> (length line) 1) (string= line "//" :end1 2))
-	  (my-read-answer (subseq line 2)))
-      ;;(format t "   solver print:  ~A~%" line)
-      ))
+    (solver-turn ,(if input `(concatenate 'string ,name " " ,input) `,name))))
+
+(defun solver-turn (command)
+  "Send command to solver-program and return its result."
+  (my-read-answer (solver-await (solver-submit command))))
+
+;; A caller may instead send several commands with solver-submit and 
+;; collect their results later with solver-await, doing its own work 
+;; in between; the solver does them in the order they were sent.  
+;; (do-solver-turn "sync") returns only once all earlier commands are 
+;; done.  Every command gets exactly one result, a (solverError ...) 
+;; string if it failed.
+
+(defun solver-submit (command)
+  "Send command to solver-program, returning an id for solver-await."
+  ;; in process, the result is there before solver-await asks for it
+  (when *solver-context*
+    (let ((result (solver-call-in-process command)))
+      (return-from solver-submit
+	(sb-thread:with-mutex (*solver-replies-lock*)
+	  (let ((id (format nil "~A" (incf *solver-request-id*))))
+	    (setf (gethash id *solver-replies*) result)
+	    id)))))
+  (unless (and (sb-ext:process-p *process*) 
+	       (sb-ext:process-alive-p *process*))
+    (error "external program not running."))
+  ;; A shared solver-program is used by several threads, so each 
+  ;; request must be written whole.
+  (sb-thread:with-recursive-lock (*solver-lock*)
+    (send-solver-request (if *solver-session* 
+			     (format nil "@~A ~A" *solver-session* command)
+			     command))))
+
+(defun solver-await (id)
+  "Wait for the result string of the command sent as id."
+  (if (or *solver-context* (solver-threaded-p))
+      (sb-thread:with-mutex (*solver-replies-lock*)
+	(loop until (nth-value 1 (gethash id *solver-replies*))
+	      do (sb-thread:condition-wait *solver-replies-ready* 
+					   *solver-replies-lock*))
+	(prog1 (gethash id *solver-replies*)
+	  (remhash id *solver-replies*)))
+      ;; read results, keeping those for other ids, until ours comes
+      (sb-thread:with-recursive-lock (*solver-lock*)
+	(loop
+	 (multiple-value-bind (result found) (gethash id *solver-replies*)
+	   (when found 
+	     (remhash id *solver-replies*)
+	     (return result)))
+	 (multiple-value-bind (rid result) 
+	     (read-solver-result (sb-ext:process-output *process*))
+	   (unless rid (error "solver-program stopped before answering."))
+	   (setf (gethash rid *solver-replies*) result))))))
    
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 
+(defun solver-sync ()
+  ;; returns t once the solver has done every command sent before
+  (do-solver-turn "sync"))
+
 (defun solver-logging (x)
   ; update Lisp-side state flag, and set in currently loaded solver
   (do-solver-turn "solverDoLog" (format nil "~A" x)))
 
+(defun solver-log-sessions (x)
+  ;; t gives each session its own log file
+  (do-solver-turn "solverLogSessions" (format nil "~A" x)))
+
+(defun solver-log-rotate (bytes)
+  ;; log files are rotated when they would grow past bytes; 0 never
+  (do-solver-turn "solverLogRotate" (format nil "~D" bytes)))
+
+(defun solver-checkpoint (file)
+  "Save the whole state of this session's problem to file."
+  (do-solver-turn "solverCheckpoint" (namestring file)))
+
+(defun solver-restore (file)
+  "Replace this session's problem by one saved with solver-checkpoint."
+  (do-solver-turn "solverRestore" (namestring file)))
+
+(defun solver-write-problem-image (file)
+  "Save this session's problem, without student equations, to file."
+  (do-solver-turn "solverWriteProblemImage" (namestring file)))
+
+(defun solver-load-problem-image (file)
+  "Replace this session's problem by one saved with solver-write-problem-image."
+  (do-solver-turn "solverLoadProblemImage" (namestring file)))
+
+(defun solver-load-library-problem (name)
+  "Replace this session's problem by problem name of the problem library."
+  (do-solver-turn "solverLoadLibraryProblem" (format nil "~A" name)))
+
+(defun solver-stats ()
+  "Counts and times of the solver calls, as a list of property lists."
+  (do-solver-turn "solverStats"))
+
+(defun solver-reset-stats ()
+  (do-solver-turn "solverResetStats"))
+
 ;;  Unused
 ;;(defun solver-log-new-name (x)
 ;;  (do-solver-turn "solverStartLog" (format nil "~A" x)))
@@ -259,6 +559,9 @@
 (defun solver-solve-more-problem ()
   (do-solver-turn "solveMoreBubble"))
 
+(defun solver-solve-all ()
+  (do-solver-turn "solveAll"))
+
 (defun solver-send-problem-statement (arg)
   ;; suppress pretty printing -- it may insert line breaks on 
   ;; very long equations
@@ -328,6 +631,28 @@
 		   (format nil "(~A ~A ~A)" strength varName 
 			   (id2solver-slot equationID))))
 
+;; Several problem loading calls can be sent as one solverBatch turn.
+;; Each item is a list of the solver command and its argument string,
+;; made by the functions below just as the single calls above make 
+;; them.  The result is a list with what each call would have returned.
+(defun solver-batch (items)
+  (let ((*read-default-float-format* 'double-float)
+	(answer (do-solver-turn "solverBatch"
+		  (format nil "~{(~{~A~^ ~})~^ ~}" items))))
+    (if (listp answer)
+	(mapcar #'my-read-answer answer)
+	answer)))		;error for the batch as a whole
+
+(defun solver-problem-statement-item (arg)
+  (list "solveAdd" (write-to-string arg :pretty NIL :escape T)))
+
+(defun solver-indyAddVar-item (arg)
+  (list "c_indyAddVariable" (write-to-string arg :pretty NIL :escape nil)))
+
+(defun solver-indyAddEquation-item (equationID equation)
+  (list "c_indyAddEquation" 
+	(write-to-string (list equationID equation) :pretty NIL :escape t)))
+
 ;;  Never called.
 ;; (defun solver-eqn-simplify (equationID destinationID)
 ;;  (do-solver-turn "c_simplifyEqn" 
@@ -22,6 +22,7 @@
 //  You should have received a copy of the GNU Lesser General Public License
 //  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////////
+#define SOLVERCONTEXT_MEMBERS	// the state is reached through ctx, below
 #include "Solver.h"
 #include "coldriver.h"
 #include <string>
@@ -29,28 +30,32 @@
 #include <cstdio>
 #include <iostream>
 #include "indysgg.h"
+#include "solvercontext.h"
+#include "solverstats.h"
 #include "dbg.h"
 #include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <cstdarg>
+#include <algorithm>
 #include <cstring>
 using namespace std;
 
 //////////////////////////////////////////////////////////////////////////////
 #define SOLVER_IS_DEBUGGING
 #ifdef SOLVER_IS_DEBUGGING
-#include <fstream>
-static ofstream joelLog;
-static string joelFileName = "Solver.log";
-static bool joelLogOn = false;
+#include "solverlog.h"
+#include <atomic>
+static atomic<bool> joelLogOn(false);
+// the log is written by solverlog.cpp, in the background
 #define SLog(s) if (joelLogOn) { \
-      joelLog.open(joelFileName.c_str(), ios::app); \
-      if (joelLog) {joelLog << s << ";" << endl; joelLog.close();} \
-      else cout << "Can't open log file " << joelFileName << endl; } 
-#define NewLog() if (joelLogOn) { \
-   joelLog.open(joelFileName.c_str()); \
-   if (joelLog) {joelLog << "Begin" << endl; joelLog.close();} \
-   else cout << "Can't open new log file " << joelFileName << endl; }
+      ostringstream joelLine; joelLine << s; logCall(joelLine.str()); }
+#define SLogResult(s) if (joelLogOn) { \
+      ostringstream joelLine; joelLine << s; logResult(joelLine.str()); }
+#define NewLog() if (joelLogOn) logRestart()
 #else // ifndef SOLVER_IS_DEBUGGING
 #define SLog(s)
+#define SLogResult(s)
 #define NewLog()
 #endif
 
@@ -83,6 +88,19 @@ string powersolve(const int howstrong, const string varname,
 bool handleInput(string& aLine);
 bool clearTheProblem();
 string itostr(int val);
+// in sessions.cpp
+void sessionCreate(const string & name);
+void sessionDestroy(const string & name);
+void sessionSelect(const string & name);
+// in solutioncache.cpp
+void setSolutionCache(const string & dir);
+// in checkpoint.cpp
+void checkpointProblem(const string & file);
+void restoreProblem(const string & file);
+void writeProblemImage(const string & file);
+void loadProblemImage(const string & file);
+void openProblemLibrary(const string & file);
+void loadLibraryProblem(const string & name);
 
 //////////////////////////////////////////////////////////////////////////////
 // local routines and variables not directly accessible from outside this file
@@ -104,31 +122,69 @@ char* remove0A0Ds(const char* const str) {
   return bfr;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// resultRoom - makes the result buffer of ctx hold at least n chars
+// note(s):
+//    may move the buffer, so pointers into result are invalid after it
+//////////////////////////////////////////////////////////////////////////////
+static void resultRoom(SolverContext * ctx, size_t n) {
+  vector<char> & bfr = ctx->result;
+  if (bfr.size() < n) bfr.resize(max(n, 2 * bfr.size()));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// formatResult - sprintf into the result buffer, making room as needed
+//////////////////////////////////////////////////////////////////////////////
+static void formatResult(SolverContext * ctx, const char* const format, ...) {
+  vector<char> & bfr = ctx->result;
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(&bfr[0], bfr.size(), format, args);
+  va_end(args);
+  if (n >= 0 && n >= (int) bfr.size()) {  // it didn't fit, so do it again
+    resultRoom(ctx, n + 1);
+    va_start(args, format);
+    vsnprintf(&bfr[0], bfr.size(), format, args);
+    va_end(args);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // result is buffer used:
 //  1) primary storage for values returned to lisp
 //  2) temp workspace for evaluation of data passed by lisp
-// size is chosen by the 'make it big enough rule' ... 4K should suffice
+// It starts at 4K and is grown (by resultRoom) whenever something
+// longer is put in it, so nothing is cut off; it is never shrunk, so 
+// once it is big enough there is no more allocation.
+// Each SolverContext has its own, so that the string returned for one
+// problem is not overwritten by calls for another. Each routine below
+// looks up the current context once, and passes it on.
 //////////////////////////////////////////////////////////////////////////////
-static char result[4096];
+static inline char* resultOf(SolverContext * ctx) {
+  return &ctx->result[0];
+}
 
 //////////////////////////////////////////////////////////////////////////////
 // setResult - used to copy a message to the result buffer
 // argument(s):
+//    ctx - whose buffer
 //    m - text to be placed in buffer
 // returns:
 //    NOTHING - no return value
 // note(s):
-//    mostly just a layer on top of sprintf 'cause I may need to alter the
+//    mostly just a layer on top of strcpy 'cause I may need to alter the
 //    implementation without altering the action
 //////////////////////////////////////////////////////////////////////////////
-static void setResult(const char* const message) {
-  sprintf(result, "%s", message);
+static void setResult(SolverContext * ctx, const char* const message) {
+  size_t n = strlen(message) + 1;
+  resultRoom(ctx, n);
+  memmove(resultOf(ctx), message, n);
 }
 
 //////////////////////////////////////////////////////////////////////////////
 // copyToResult - used to copy a portion of data to the result buffer
 // argument(s):
+//    ctx - whose buffer
 //    d - source buffer
 //    s - index in start of first item to copy
 //    e - index in start of last item to copy
@@ -138,8 +194,11 @@ static void setResult(const char* const message) {
 // note(s):
 //    used to get things into buffer for mangling before handing off to calls
 //////////////////////////////////////////////////////////////////////////////
-static void copyToResult(const char* const d, int s, int e, int sp = 0) {
+static void copyToResult(SolverContext * ctx, const char* const d, int s, int e,
+			 int sp = 0) {
   int j = 0;
+  resultRoom(ctx, sp + (e >= s ? e - s + 1 : 0) + 1);
+  char* result = resultOf(ctx);
   for (j=0; s<=e; s++, j++) {
     result[sp+j] = d[s];
   }
@@ -149,6 +208,7 @@ static void copyToResult(const char* const d, int s, int e, int sp = 0) {
 //////////////////////////////////////////////////////////////////////////////
 // makeError - used to form erros to return to lisp
 // argument(s):
+//    ctx - whose result buffer gets it
 //    m - message/description of error
 //    r - is name of routine/function that error caught in
 //    a - arguments passed to function when error occurred
@@ -156,9 +216,10 @@ static void copyToResult(const char* const d, int s, int e, int sp = 0) {
 //    NOTHING - no return value
 // note(s):
 //////////////////////////////////////////////////////////////////////////////
-static void makeError(const char* const m, const char* const r, const char* const a) {
+static void makeError(SolverContext * ctx, const char* const m, const char* const r,
+		      const char* const a) {
   // Make it look like a lisp expression:
-  sprintf(result, "(solverError %s %s \"%s\")", r, a, m);
+  formatResult(ctx, "(solverError %s %s \"%s\")", r, a, m);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -186,28 +247,76 @@ static int findChar(char toFind, const char* const data, int beginAt) {
 // routines supplied through interface (solver.h)
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING solverStartLog(const char* const src) {
-  string tmp = src;
-  joelFileName = tmp;
+  SolverContext * ctx = solverContext();
+  setLogFile(src);
   NewLog();
-  setResult("t");
-  return result;
+  setResult(ctx, "t");
+  return resultOf(ctx);
 }
 
 RETURN_CSTRING solverDoLog(const char* const src) {
+  SolverContext * ctx = solverContext();
   string flag = src;
   if ((flag == "T") || (flag == "t")) {
     joelLogOn = true;
   } else {
     joelLogOn = false;
+    logFlush();
   }
-  setResult("t");
-  return result;
+  setResult(ctx, "t");
+  return resultOf(ctx);
+}
+
+RETURN_CSTRING solverLogSessions(const char* const src) {
+  SolverContext * ctx = solverContext();
+  string flag = src;
+  setLogSessions((flag == "T") || (flag == "t"));
+  setResult(ctx, "t");
+  return resultOf(ctx);
+}
+
+RETURN_CSTRING solverLogRotate(const unsigned long int bytes) {
+  SolverContext * ctx = solverContext();
+  setLogRotate(bytes);
+  setResult(ctx, "t");
+  return resultOf(ctx);
 }
 
 RETURN_CSTRING solverDebugLevel(const unsigned long int x) {
+  SolverContext * ctx = solverContext();
   dbglevel = x;
-  setResult("t");
-  return result;
+  setResult(ctx, "t");
+  return resultOf(ctx);
+}
+
+RETURN_CSTRING solverSolutionCache(const char* const dir) {
+  SLog("solverSolutionCache(\"" << dir << "\")");
+  COMMAND_STATS("solverSolutionCache", strlen(dir));
+  SolverContext * ctx = solverContext();
+  string tmp = dir;
+  if (tmp == "nil" || tmp == "NIL") tmp = "";
+  setSolutionCache(tmp);
+  setResult(ctx, "t");
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+// the stats are not themselves counted
+RETURN_CSTRING solverStats() {
+  SLog("solverStats()");
+  SolverContext * ctx = solverContext();
+  setResult(ctx, statsReport().c_str());
+  SLogResult(resultOf(ctx));
+  return resultOf(ctx);
+}
+
+RETURN_CSTRING solverResetStats() {
+  SLog("solverResetStats()");
+  SolverContext * ctx = solverContext();
+  statsReset();
+  setResult(ctx, "t");
+  SLogResult(resultOf(ctx));
+  return resultOf(ctx);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -216,70 +325,105 @@ RETURN_CSTRING solverDebugLevel(const unsigned long int x) {
 
 RETURN_CSTRING solveBubble() {
   SLog("solveBubble()");
+  COMMAND_STATS("solveBubble", 0);
+  SolverContext * ctx = solverContext();
   try {
-    setResult(solveTheProblem());
+    setResult(ctx, solveTheProblem());
   } catch (string message) {
-    makeError(message.c_str(), "solveBubble", "");
+    makeError(ctx, message.c_str(), "solveBubble", "");
   } catch(...) {
-    makeError("unexpected and unhandled exception", "solveBubble", "");
+    makeError(ctx, "unexpected and unhandled exception", "solveBubble", "");
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING solveMoreBubble() {
   SLog("solveMoreBubble()");
+  COMMAND_STATS("solveMoreBubble", 0);
+  SolverContext * ctx = solverContext();
   try {
-    setResult(solveMoreOfTheProblem());
+    setResult(ctx, solveMoreOfTheProblem());
   } catch(string message) {
-    makeError(message.c_str(), "solveMoreBubble", "");
+    makeError(ctx, message.c_str(), "solveMoreBubble", "");
   } catch(...) {
-    makeError("unexpected and unhandled exception", "solveMoreBubble", "");
+    makeError(ctx, "unexpected and unhandled exception", "solveMoreBubble", "");
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING solveAdd(const char* const lispExpression) {
-  SLog("solveAdd(\"" << remove0A0Ds(lispExpression) << "\")");
+RETURN_CSTRING solveAll() {
+  SLog("solveAll()");
+  COMMAND_STATS("solveAll", 0);
+  SolverContext * ctx = solverContext();
+  try {
+    setResult(ctx, solveAllOfTheProblem());
+  } catch(string message) {
+    makeError(ctx, message.c_str(), "solveAll", "");
+  } catch(...) {
+    makeError(ctx, "unexpected and unhandled exception", "solveAll", "");
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// solveAdd without its log entry and stats, also used by solverBatch
+static void doSolveAdd(SolverContext * ctx, const char* const lispExpression) {
   try {
     string bfr = lispExpression;
     if (handleInput(bfr)) {
-      setResult("t");
+      setResult(ctx, "t");
     } else {
-      setResult("nil");
+      setResult(ctx, "nil");
     }
   } catch(string message) {
-    makeError(message.c_str(), "solveAdd", lispExpression);
+    makeError(ctx, message.c_str(), "solveAdd", lispExpression);
   } catch(...) {
-    makeError("unexpected and unhandled exception", "solveAdd", lispExpression);
+    makeError(ctx, "unexpected and unhandled exception", "solveAdd", lispExpression);
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solveAdd(const char* const lispExpression) {
+  SLog("solveAdd(\"" << remove0A0Ds(lispExpression) << "\")");
+  COMMAND_STATS("solveAdd", strlen(lispExpression));
+  SolverContext * ctx = solverContext();
+  doSolveAdd(ctx, lispExpression);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING solveClear() {
-  SLog("solveClear()");
+// likewise for solveClear
+static void doSolveClear(SolverContext * ctx) {
   try {
     if (clearTheProblem()) {
-      setResult("t");
+      setResult(ctx, "t");
     } else {
-      setResult("nil");
+      setResult(ctx, "nil");
     }
   } catch(string message) {
-    makeError(message.c_str(), "solveClear", "");
+    makeError(ctx, message.c_str(), "solveClear", "");
   } catch(...) {
-    makeError("unexpected and unhandled exception", "solveClear", "");
+    makeError(ctx, "unexpected and unhandled exception", "solveClear", "");
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solveClear() {
+  SLog("solveClear()");
+  COMMAND_STATS("solveClear", 0);
+  SolverContext * ctx = solverContext();
+  doSolveClear(ctx);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -287,138 +431,181 @@ RETURN_CSTRING solveClear() {
 //////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING c_indyAddVariable(const char* const data) {
-  SLog("c_indyAddVariable(\"" << remove0A0Ds(data) << "\")");
+// likewise for c_indyAddVariable
+static void doIndyAddVariable(SolverContext * ctx, const char* const data) {
   try {
     int p = findChar(' ', data, 1);
     int q = findChar(' ', data, p + 1);
-    copyToResult(data, p + 1, q - 1);
-    double value = atof(result);
-    copyToResult(data, 1, p - 1);
-    copyToResult(data, q + 1, strlen(data) - 2, p);
-    indyAddVar(result, value, &result[p]);
-    setResult("t");
+    copyToResult(ctx, data, p + 1, q - 1);
+    double value = atof(resultOf(ctx));
+    copyToResult(ctx, data, 1, p - 1);
+    copyToResult(ctx, data, q + 1, strlen(data) - 2, p);
+    indyAddVar(resultOf(ctx), value, &resultOf(ctx)[p]);
+    setResult(ctx, "t");
   } catch (string message) {
-    makeError(message.c_str(), "indyAddVariable", data);
+    makeError(ctx, message.c_str(), "indyAddVariable", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyAddVariable", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyAddVariable", data);
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING c_indyAddVariable(const char* const data) {
+  SLog("c_indyAddVariable(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_indyAddVariable", strlen(data));
+  SolverContext * ctx = solverContext();
+  doIndyAddVariable(ctx, data);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING c_indyDoneAddVariable() {
-  SLog("c_indyDoneAddVariable()");
+// likewise for c_indyDoneAddVariable
+static void doIndyDoneAddVariable(SolverContext * ctx) {
   try {
     indyDoneAddVar();
-    setResult("t");
+    setResult(ctx, "t");
   } catch (string message) {
-    makeError(message.c_str(), "indyDoneAddVariable", "");
+    makeError(ctx, message.c_str(), "indyDoneAddVariable", "");
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyDoneAddVariable", "");
+    makeError(ctx, "unexpected and unhandled exception", "indyDoneAddVariable", "");
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING c_indyDoneAddVariable() {
+  SLog("c_indyDoneAddVariable()");
+  COMMAND_STATS("c_indyDoneAddVariable", 0);
+  SolverContext * ctx = solverContext();
+  doIndyDoneAddVariable(ctx);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING c_indyAddEquation(const char* const data) {
-  SLog("c_indyAddEquation(\"" << remove0A0Ds(data) << "\")");
+// likewise for c_indyAddEquation
+static void doIndyAddEquation(SolverContext * ctx, const char* const data) {
   string tmp = "";
   try {
     int p = findChar(' ', data, 1);
-    copyToResult(data, 1, p - 1);
-    tmp += result;
-    int equationID = atoi(result);
-    copyToResult(data, p + 1, strlen(data) - 2);
+    copyToResult(ctx, data, 1, p - 1);
+    tmp += resultOf(ctx);
+    int equationID = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, strlen(data) - 2);
     tmp += " ";
-    tmp += result;
-    indyAddCanonEq(equationID, result);
-    setResult("t");
+    tmp += resultOf(ctx);
+    indyAddCanonEq(equationID, resultOf(ctx));
+    setResult(ctx, "t");
   } catch (string message) {
-    makeError(message.c_str(), "indyAddEquation", tmp.c_str()); //data);
+    makeError(ctx, message.c_str(), "indyAddEquation", tmp.c_str()); //data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyAddEquation", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyAddEquation", data);
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING c_indyAddEquation(const char* const data) {
+  SLog("c_indyAddEquation(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_indyAddEquation", strlen(data));
+  SolverContext * ctx = solverContext();
+  doIndyAddEquation(ctx, data);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING c_indyEmpty() {
-  SLog("c_indyEmpty()");
+// likewise for c_indyEmpty
+static void doIndyEmpty(SolverContext * ctx) {
   try {
     indyEmpty();
-    setResult("t");
+    setResult(ctx, "t");
   } catch (string message) {
-    makeError(message.c_str(), "indyEmpty", "");
+    makeError(ctx, message.c_str(), "indyEmpty", "");
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyEmpty", "");
+    makeError(ctx, "unexpected and unhandled exception", "indyEmpty", "");
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING c_indyEmpty() {
+  SLog("c_indyEmpty()");
+  COMMAND_STATS("c_indyEmpty", 0);
+  SolverContext * ctx = solverContext();
+  doIndyEmpty(ctx);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING c_indyAddEq2Set(const char* const data) {
-  SLog("c_indyAddEq2Set(\"" << remove0A0Ds(data) << "\")");
+// likewise for c_indyAddEq2Set
+static void doIndyAddEq2Set(SolverContext * ctx, const char* const data) {
   try {
     int p = findChar(' ', data, 1);
-    copyToResult(data, 1, p - 1);
-    int setID = atoi(result);
-    copyToResult(data, p + 1, strlen(data) - 2);
-    indyAddEq2CanSet(setID, atoi(result));
-    setResult("t");
+    copyToResult(ctx, data, 1, p - 1);
+    int setID = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, strlen(data) - 2);
+    indyAddEq2CanSet(setID, atoi(resultOf(ctx)));
+    setResult(ctx, "t");
   } catch (string message) {
-    makeError(message.c_str(), "indyAddEq2CanSet", data);
+    makeError(ctx, message.c_str(), "indyAddEq2CanSet", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyAddEq2CanSet", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyAddEq2CanSet", data);
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING c_indyAddEq2Set(const char* const data) {
+  SLog("c_indyAddEq2Set(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_indyAddEq2Set", strlen(data));
+  SolverContext * ctx = solverContext();
+  doIndyAddEq2Set(ctx, data);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-RETURN_CSTRING c_indyKeepNOfSet(const char* const data) {
-  SLog("c_indyKeepNOfSet(\"" << remove0A0Ds(data) << "\")");
+// likewise for c_indyKeepNOfSet
+static void doIndyKeepNOfSet(SolverContext * ctx, const char* const data) {
   try {
     int p = findChar(' ', data, 1);
-    copyToResult(data, 1, p - 1);
-    int setID = atoi(result);
-    copyToResult(data, p + 1, strlen(data) - 2);
-    indyKeepN(setID, atoi(result));
-    setResult("t");
+    copyToResult(ctx, data, 1, p - 1);
+    int setID = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, strlen(data) - 2);
+    indyKeepN(setID, atoi(resultOf(ctx)));
+    setResult(ctx, "t");
   } catch (string message) {
-    makeError(message.c_str(), "indyKeepNOfSet", data);
+    makeError(ctx, message.c_str(), "indyKeepNOfSet", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyKeepNOfSet", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyKeepNOfSet", data);
   }
+}
 
-  SLog("// " << result);
-  return result;
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING c_indyKeepNOfSet(const char* const data) {
+  SLog("c_indyKeepNOfSet(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_indyKeepNOfSet", strlen(data));
+  SolverContext * ctx = solverContext();
+  doIndyKeepNOfSet(ctx, data);
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_indyHowIndy(const int which, const char* const data) {
+  SolverContext * ctx = solverContext();
   try {
     int p = findChar(' ', data, 1);
-    copyToResult(data, p + 1, strlen(data) - 2);
-    int equationID = atoi(result);
-    copyToResult(data, 1, p - 1);
+    copyToResult(ctx, data, p + 1, strlen(data) - 2);
+    int equationID = atoi(resultOf(ctx));
+    copyToResult(ctx, data, 1, p - 1);
     vector<int> linexpand;
     vector<int> mightdepend;
     switch (which) {
     case 0:
-      p = indyCanonHowIndy(atoi(result), equationID, &linexpand, &mightdepend);
+      p = indyCanonHowIndy(atoi(resultOf(ctx)), equationID, &linexpand, &mightdepend);
       break;
     case 1:
-      p = indyStudHowIndy(atoi(result), equationID, &linexpand, &mightdepend);
+      p = indyStudHowIndy(atoi(resultOf(ctx)), equationID, &linexpand, &mightdepend);
       break;
     default:
       throw string("No third option in indyHowIndy");
@@ -435,150 +622,434 @@ RETURN_CSTRING c_indyHowIndy(const int which, const char* const data) {
       retstr += (itostr(mightdepend[k]) + " ");
     }
     retstr += "))";
-    setResult(retstr.c_str());
+    setResult(ctx, retstr.c_str());
   } catch (string message) {
-    makeError(message.c_str(), "indyHowIndy", data);
+    makeError(ctx, message.c_str(), "indyHowIndy", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyHowIndy", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyHowIndy", data);
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return resultOf(ctx);
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_indyCanonHowIndy(const char* const data) {
   SLog("c_indyCanonHowIndy(\"" << remove0A0Ds(data) << "\")");
-  return c_indyHowIndy(0, data);
+  COMMAND_STATS("c_indyCanonHowIndy", strlen(data));
+  return timer.done(c_indyHowIndy(0, data));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_indyStudHowIndy(const char* const data) {
   SLog("c_indyStudHowIndy(\"" << remove0A0Ds(data) << "\")");
-  return c_indyHowIndy(1, data);
+  COMMAND_STATS("c_indyStudHowIndy", strlen(data));
+  return timer.done(c_indyHowIndy(1, data));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_indyStudentAddEquationOkay(const char* const data) {
   SLog("c_indyStudentAddEquationOkay(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_indyStudentAddEquationOkay", strlen(data));
+  SolverContext * ctx = solverContext();
   try {
     int p = findChar(' ', data, 1);
-    copyToResult(data, 1, p - 1);
-    int equationID = atoi(result);
-    copyToResult(data, p + 1, strlen(data) - 2);
-    sprintf(result, "%d", indyAddStudEq(equationID, result));
+    copyToResult(ctx, data, 1, p - 1);
+    int equationID = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, strlen(data) - 2);
+    formatResult(ctx, "%d", indyAddStudEq(equationID, resultOf(ctx)));
   } catch (string message) {
-    makeError(message.c_str(), "indyStudentAddEquationOkay", data);
+    makeError(ctx, message.c_str(), "indyStudentAddEquationOkay", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyStudentAddEquationOkay", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyStudentAddEquationOkay", data);
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_indyIsStudentEquationOkay(const char* const data) {
   SLog("c_indyIsStudentEquationOkay(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_indyIsStudentEquationOkay", strlen(data));
+  SolverContext * ctx = solverContext();
   try {
-    copyToResult(data, 1, strlen(data) - 2);
-    sprintf(result, "%d", indyIsStudEqnOkay(result));
+    copyToResult(ctx, data, 1, strlen(data) - 2);
+    formatResult(ctx, "%d", indyIsStudEqnOkay(resultOf(ctx)));
   } catch (string message) {
-    makeError(message.c_str(), "indyIsStudentEquationOkay", data);
+    makeError(ctx, message.c_str(), "indyIsStudentEquationOkay", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "indyIsStudentEquationOkay", data);
+    makeError(ctx, "unexpected and unhandled exception", "indyIsStudentEquationOkay", data);
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_powersolve(const char* const data) {
   SLog("c_powersolve(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_powersolve", strlen(data));
+  SolverContext * ctx = solverContext();
   try {
     int p = findChar(' ', data, 1);
     int q = findChar(' ', data, p + 1);
-    copyToResult(data, 1, p - 1);
-    int strength = atoi(result);
-    copyToResult(data, q + 1, strlen(data) - 2);
-    int slot = atoi(result);
-    copyToResult(data, p + 1, q - 1);
-    setResult(powersolve(strength, result, slot).c_str());
+    copyToResult(ctx, data, 1, p - 1);
+    int strength = atoi(resultOf(ctx));
+    copyToResult(ctx, data, q + 1, strlen(data) - 2);
+    int slot = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, q - 1);
+    setResult(ctx, powersolve(strength, resultOf(ctx), slot).c_str());
   } catch (string message) {
-    makeError(message.c_str(), "powersolve", data);
+    makeError(ctx, message.c_str(), "powersolve", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "powersolve", data);
+    makeError(ctx, "unexpected and unhandled exception", "powersolve", data);
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_simplifyEqn(const char* const data) {
   SLog("c_simplifyEqn(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_simplifyEqn", strlen(data));
+  SolverContext * ctx = solverContext();
   try {
     int p = findChar(' ', data, 1);
-    copyToResult(data, 1, p - 1);
-    int sourceSlot = atoi(result);
-    copyToResult(data, p + 1, strlen(data) - 2);
-    int destSlot = atoi(result);
-    setResult(simplifyEqn(sourceSlot,destSlot).c_str());
+    copyToResult(ctx, data, 1, p - 1);
+    int sourceSlot = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, strlen(data) - 2);
+    int destSlot = atoi(resultOf(ctx));
+    setResult(ctx, simplifyEqn(sourceSlot,destSlot).c_str());
   } catch (string message) {
-    makeError(message.c_str(), "simplifyEqn", data);
+    makeError(ctx, message.c_str(), "simplifyEqn", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "simplifyEqn", data);
+    makeError(ctx, "unexpected and unhandled exception", "simplifyEqn", data);
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_solveOneEqn(const char* const data) {
   SLog("c_solveOneEqn(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_solveOneEqn", strlen(data));
+  SolverContext * ctx = solverContext();
   try {
     int p = findChar(' ', data, 1);
     int q = findChar(' ', data, p + 1);
-    copyToResult(data, q + 1, strlen(data) - 2);
-    int destSlot = atoi(result);
-    copyToResult(data, p + 1, q - 1);
-    int sourceSlot = atoi(result);
-    copyToResult(data, 1, p - 1);
-    setResult(solveOneEqn(result,sourceSlot,destSlot).c_str());
+    copyToResult(ctx, data, q + 1, strlen(data) - 2);
+    int destSlot = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, q - 1);
+    int sourceSlot = atoi(resultOf(ctx));
+    copyToResult(ctx, data, 1, p - 1);
+    setResult(ctx, solveOneEqn(resultOf(ctx),sourceSlot,destSlot).c_str());
   } catch (string message) {
-    makeError(message.c_str(), "solveOneEqn", data);
+    makeError(ctx, message.c_str(), "solveOneEqn", data);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "solveOneEqn", data);
+    makeError(ctx, "unexpected and unhandled exception", "solveOneEqn", data);
   }
 
-  SLog("// " << result);
-  return result;
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_subInOneEqn(const char* const data) {
   SLog("c_subInOneEqn(\"" << remove0A0Ds(data) << "\")");
+  COMMAND_STATS("c_subInOneEqn", strlen(data));
+  SolverContext * ctx = solverContext();
   try {
     int p = findChar(' ', data, 1);
     int q = findChar(' ', data, p + 1);
-    copyToResult(data, 1, p - 1);
-    int sourceSlot = atoi(result);
-    copyToResult(data, q + 1, strlen(data) - 2);
-    int destSlot = atoi(result);
-    copyToResult(data, p + 1, q - 1);
-    int targetSlot = atoi(result);
-    setResult(subInOneEqn(sourceSlot,targetSlot,destSlot).c_str());
+    copyToResult(ctx, data, 1, p - 1);
+    int sourceSlot = atoi(resultOf(ctx));
+    copyToResult(ctx, data, q + 1, strlen(data) - 2);
+    int destSlot = atoi(resultOf(ctx));
+    copyToResult(ctx, data, p + 1, q - 1);
+    int targetSlot = atoi(resultOf(ctx));
+    setResult(ctx, subInOneEqn(sourceSlot,targetSlot,destSlot).c_str());
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "subInOneEqn", data);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "subInOneEqn", data);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// batch of calls
+//////////////////////////////////////////////////////////////////////////////
+
+/************************************************************************
+ * splitBatch  splits "(command args) (command args) ..." into its	*
+ *	commands and their args, skipping over parentheses inside	*
+ *	strings "..." and symbols |...|. Throws if malformed.		*
+ ************************************************************************/
+static void splitBatch(const char* const items, vector<string> & commands,
+		       vector<string> & args)
+{
+  int k = 0;
+  int l = strlen(items);
+  while (true) {
+    while (k < l && isspace(items[k])) k++;
+    if (k == l) return;
+    if (items[k] != '(') throw string("batch item doesn't start with (");
+    int start = ++k;
+    int depth = 1;
+    char quote = 0;		// " or | while inside one
+    for (; k < l && depth > 0; k++) {
+      if (quote) {
+	if (items[k] == '\\' && k + 1 < l) k++;
+	else if (items[k] == quote) quote = 0;
+      }
+      else if (items[k] == '"' || items[k] == '|') quote = items[k];
+      else if (items[k] == '(') depth++;
+      else if (items[k] == ')') depth--;
+    }
+    if (depth > 0) throw string("batch item has no closing )");
+    string item(items + start, k - 1 - start);
+    string::size_type space = item.find_first_of(" \t\r\n");
+    commands.push_back(item.substr(0, space));
+    args.push_back(space == string::npos ? string() : item.substr(space + 1));
+  }
+}
+
+/************************************************************************
+ * batchCall  does one item of a batch, returning its result. The	*
+ *	items are not logged or counted themselves: the log and stats	*
+ *	have just the solverBatch call.					*
+ ************************************************************************/
+static string batchCall(SolverContext * ctx, const string & command, string & arg)
+{
+  const char* const data = arg.c_str();
+  if (command == "solveClear") doSolveClear(ctx);
+  else if (command == "solveAdd") doSolveAdd(ctx, data);
+  else if (command == "c_indyEmpty") doIndyEmpty(ctx);
+  else if (command == "c_indyAddVariable") doIndyAddVariable(ctx, data);
+  else if (command == "c_indyDoneAddVariable") doIndyDoneAddVariable(ctx);
+  else if (command == "c_indyAddEquation") doIndyAddEquation(ctx, data);
+  else if (command == "c_indyAddEq2Set") doIndyAddEq2Set(ctx, data);
+  else if (command == "c_indyKeepNOfSet") doIndyKeepNOfSet(ctx, data);
+  else makeError(ctx, "not allowed in a batch", "solverBatch", command.c_str());
+  return resultOf(ctx);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverBatch(const char* const items) {
+  SLog("solverBatch(\"" << remove0A0Ds(items) << "\")");
+  COMMAND_STATS("solverBatch", strlen(items));
+  SolverContext * ctx = solverContext();
+  string & answer = ctx->batchResult;
+  try {
+    vector<string> commands, args;
+    splitBatch(items, commands, args);
+    // make room at once for the variables and equations to come
+    int nvars = 0, neqs = 0;
+    for (size_t k = 0; k < commands.size(); k++) {
+      if (commands[k] == "c_indyAddVariable") nvars++;
+      else if (commands[k] == "c_indyAddEquation") neqs++;
+      else if (commands[k] == "solveAdd") { nvars++; neqs++; }
+    }
+    // (but not in those shared with other sessions, which are copied
+    // only if a command changes them)
+    if (ctx->numsols) ctx->numsols->reserve(ctx->numsols->size() + nvars);
+    if (!ctx->canonOwner) {
+      if (ctx->canonvars) ctx->canonvars->reserve(ctx->canonvars->size() + nvars);
+      if (ctx->canoneqf) ctx->canoneqf->reserve(ctx->canoneqf->size() + neqs);
+      if (ctx->canongrads) ctx->canongrads->reserve(ctx->canongrads->size() + neqs);
+    }
+
+    answer = "(";
+    for (size_t k = 0; k < commands.size(); k++) {
+      string r = batchCall(ctx, commands[k], args[k]);
+      answer += (k == 0) ? "\"" : " \"";
+      for (size_t j = 0; j < r.size(); j++) {
+	if (r[j] == '"' || r[j] == '\\') answer += '\\';
+	answer += r[j];
+      }
+      answer += "\"";
+    }
+    answer += ")";
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverBatch", items);
+    answer = resultOf(ctx);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverBatch", items);
+    answer = resultOf(ctx);
+  }
+
+  SLogResult(answer);
+  return timer.done(const_cast<char*>(answer.c_str()));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverCheckpoint(const char* const file) {
+  SLog("solverCheckpoint(\"" << file << "\")");
+  COMMAND_STATS("solverCheckpoint", strlen(file));
+  SolverContext * ctx = solverContext();
+  try {
+    checkpointProblem(file);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverCheckpoint", file);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverCheckpoint", file);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverRestore(const char* const file) {
+  SLog("solverRestore(\"" << file << "\")");
+  COMMAND_STATS("solverRestore", strlen(file));
+  SolverContext * ctx = solverContext();
+  try {
+    restoreProblem(file);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverRestore", file);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverRestore", file);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverWriteProblemImage(const char* const file) {
+  SLog("solverWriteProblemImage(\"" << file << "\")");
+  COMMAND_STATS("solverWriteProblemImage", strlen(file));
+  SolverContext * ctx = solverContext();
+  try {
+    writeProblemImage(file);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverWriteProblemImage", file);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverWriteProblemImage", file);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverLoadProblemImage(const char* const file) {
+  SLog("solverLoadProblemImage(\"" << file << "\")");
+  COMMAND_STATS("solverLoadProblemImage", strlen(file));
+  SolverContext * ctx = solverContext();
+  try {
+    loadProblemImage(file);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverLoadProblemImage", file);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverLoadProblemImage", file);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverOpenProblemLibrary(const char* const file) {
+  SLog("solverOpenProblemLibrary(\"" << file << "\")");
+  COMMAND_STATS("solverOpenProblemLibrary", strlen(file));
+  SolverContext * ctx = solverContext();
+  try {
+    openProblemLibrary(file);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverOpenProblemLibrary", file);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverOpenProblemLibrary", file);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverLoadLibraryProblem(const char* const name) {
+  SLog("solverLoadLibraryProblem(\"" << name << "\")");
+  COMMAND_STATS("solverLoadLibraryProblem", strlen(name));
+  SolverContext * ctx = solverContext();
+  try {
+    loadLibraryProblem(name);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverLoadLibraryProblem", name);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverLoadLibraryProblem", name);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverCreateSession(const char* const name) {
+  SLog("solverCreateSession(\"" << name << "\")");
+  COMMAND_STATS("solverCreateSession", strlen(name));
+  SolverContext * ctx = solverContext();
+  try {
+    sessionCreate(name);
+    setResult(ctx, "t");
+  } catch (string message) {
+    makeError(ctx, message.c_str(), "solverCreateSession", name);
+  } catch (...) {
+    makeError(ctx, "unexpected and unhandled exception", "solverCreateSession", name);
+  }
+
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverDestroySession(const char* const name) {
+  SLog("solverDestroySession(\"" << name << "\")");
+  COMMAND_STATS("solverDestroySession", strlen(name));
+  try {
+    sessionDestroy(name);
+    setResult(solverContext(), "t");
+  } catch (string message) {
+    makeError(solverContext(), message.c_str(), "solverDestroySession", name);
+  } catch (...) {
+    makeError(solverContext(), "unexpected and unhandled exception", "solverDestroySession", name);
+  }
+
+  // looked up after, as the call changes the current context
+  SolverContext * ctx = solverContext();
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverSelectSession(const char* const name) {
+  SLog("solverSelectSession(\"" << name << "\")");
+  COMMAND_STATS("solverSelectSession", strlen(name));
+  try {
+    sessionSelect(name);
+    setResult(solverContext(), "t");
   } catch (string message) {
-    makeError(message.c_str(), "subInOneEqn", data);
+    makeError(solverContext(), message.c_str(), "solverSelectSession", name);
   } catch (...) {
-    makeError("unexpected and unhandled exception", "subInOneEqn", data);
+    makeError(solverContext(), "unexpected and unhandled exception", "solverSelectSession", name);
   }
 
-  SLog("// " << result);
-  return result;
+  // looked up after, as the call changes the current context
+  SolverContext * ctx = solverContext();
+  SLogResult(resultOf(ctx));
+  return timer.done(resultOf(ctx));
 }
 
 #ifdef _USRDLL
@@ -67,6 +67,7 @@
 // solve-problem-file     - solveBubbleFile              - doColAnderMain
 // solve-problem          - solveBubble                  - solveTheProblem
 // solve-more-problem     - solveMoreBubble              - solveMoreOfTheProblem
+// solve-all-problem      - solveAll                     - solveAllOfTheProblem
 // send-problem-statement - solveAdd                     - handleInput
 // new-problem            - solveClear                   - clearTheProblem
 //
@@ -138,6 +139,21 @@ RETURN_CSTRING solveBubble();
 /////////////////////////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING solveMoreBubble();
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solveAll - solves the problem and returns all of the solution at once
+// argument(s):
+//      NONE
+// returns:
+//      char* with the solution as a list of sections, the first holding the lines
+//              for solved variables and each of the others a tag and the lines
+//              after it, as solveBubble and solveMoreBubble would return them:
+//              (((SVAR a 3 m/s^2) ...) (<PARTSLVV> ...) (<UNSLVVARS> ...)); or
+//              an error message of the form: (Error: <function(arg)> "description")
+// notes:
+//      takes the place of solveBubble followed by solveMoreBubble until "nil"
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solveAll();
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // solveAdd -- uses argument to define variable(s)/equation(s)/etc to be added
 // argument(s):
@@ -407,10 +423,224 @@ RETURN_CSTRING c_indyCanonHowIndy(const char* const data);
 /////////////////////////////////////////////////////////////////////////////////////////////////
 RETURN_CSTRING c_indyStudHowIndy(const char* const data);
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverBatch - does a list of problem loading calls at once
+// argument(s):
+//      items - of the form "(command args) (command args) ..." where command is
+//          one of solveClear, solveAdd, c_indyEmpty, c_indyAddVariable,
+//          c_indyDoneAddVariable, c_indyAddEquation, c_indyAddEq2Set or
+//          c_indyKeepNOfSet, and args is what that call takes, if anything; 
+//          for example "(c_indyAddVariable (m 2.0 kg)) (c_indyDoneAddVariable)"
+// returns:
+//      char* - a list with a string for each item, holding what the call 
+//          would have returned on its own, such as ("t" "t"), or an error 
+//          string if items is malformed
+// notes:
+//      the items are done in order, and one that fails doesn't stop the rest
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverBatch(const char* const items);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverCheckpoint -- saves the whole state of the problem to a file
+// argument(s):
+//      file - where to save it; an existing file is replaced
+// returns:
+//      char* - "t" if all went well else an error string of the form:
+//              (solverError <function> <args> "description")
+// notes:
+//      saves the variables, canonical equations and their gradients, the student
+//      equation slots, the solution and the independence sets, everything that
+//      c_indyAddVariable, c_indyAddEquation, c_indyAddEq2Set, ... and
+//      c_indyStudentAddEquationOkay have built up.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverCheckpoint(const char* const file);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverRestore -- replaces the problem by one saved by solverCheckpoint
+// argument(s):
+//      file - written by solverCheckpoint, on a machine of the same kind
+// returns:
+//      char* - "t" if all went well else an error string
+// notes:
+//      nothing is parsed or differentiated, so this takes time in proportion
+//      to the size of the file, and all later calls answer exactly as they
+//      would have in the session that was saved.
+//      If the file can't be read, the problem is left as it was.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverRestore(const char* const file);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverWriteProblemImage -- saves the problem, without student equations, as an image
+// argument(s):
+//      file - where to save it; an existing file is replaced
+// returns:
+//      char* - "t" if all went well else an error string
+// notes:
+//      made once, after c_indyAddVariable, c_indyAddEquation, ... have loaded
+//      the problem, the image holds the variables with their units, the
+//      canonical equations and their gradients, the solution and the
+//      independence sets: all that every session of the problem shares.
+//      solver-batch -images writes one for each problem it solves.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverWriteProblemImage(const char* const file);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverLoadProblemImage -- replaces the problem by one saved by solverWriteProblemImage
+// argument(s):
+//      file - the image, made by a solver of the same version on the same kind
+//             of machine
+// returns:
+//      char* - "t" if all went well else an error string
+// notes:
+//      the file is mapped into memory and read in place, with no parsing, unit
+//      lookup or differentiation. The student equation slots are empty.
+//      If the image can't be read, the problem is left as it was.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverLoadProblemImage(const char* const file);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverOpenProblemLibrary -- maps a library of problem images, for all sessions
+// argument(s):
+//      file - made by solver-batch -library from the images of many problems
+// returns:
+//      char* - "t" if all went well else an error string
+// notes:
+//      the file is mapped read only, once for the process, so the processes on
+//      a machine using the same library share one copy of it in memory.
+//      A library opened later replaces it.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverOpenProblemLibrary(const char* const file);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverLoadLibraryProblem -- replaces the problem by one in the open library
+// argument(s):
+//      name - the problem, as named in the library
+// returns:
+//      char* - "t" if all went well else an error string
+// notes:
+//      as for solverLoadProblemImage. The problem is decoded once for the
+//      process, and the sessions that load it share its variables and
+//      canonical equations, read only, until a session adds to or changes
+//      them and is given its own copy.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverLoadLibraryProblem(const char* const name);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//                  Session routines follow
+/////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Each session holds its own problem: variables, canonical and student
+//   equations, sets and solution. All other calls act on the selected
+//   session. The default session, named by the empty string, always
+//   exists and is selected at start up.
+// Each thread has its own selected session, so different threads may
+//   work on different sessions at the same time; a session must be 
+//   used by only one thread at a time.
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverCreateSession -- makes a new, empty session
+// argument(s):
+//      name - identifier for the new session; must not already exist
+// returns:
+//      char* - "t" if all went well else an error string of the form:
+//              (solverError <function> <args> "description")
+// notes:
+//      the selected session is not changed
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverCreateSession(const char* const name);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverDestroySession -- frees everything held by a session
+// argument(s):
+//      name - identifier of the session; the default session can't be destroyed
+// returns:
+//      char* - "t" if all went well else an error string
+// notes:
+//      if the session was selected, the default session becomes selected
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverDestroySession(const char* const name);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverSelectSession -- directs following calls to a session
+// argument(s):
+//      name - identifier of an existing session, or "" for the default
+// returns:
+//      char* - "t" if all went well else an error string
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverSelectSession(const char* const name);
+
 // turn on logging of input and output.
+// Each call is logged as the statement making it, followed by the comments
+//      //@ <date> <time to the microsecond> <duration>us
+//      // <result>;
+// so the log can still be replayed. The log is written in the background,
+// and completely when logging is turned off or the program exits.
 
 RETURN_CSTRING solverDoLog(const char* const src);
 RETURN_CSTRING solverStartLog(const char* const src);
 RETURN_CSTRING solverDebugLevel(const unsigned long int x);
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverLogSessions -- gives each session its own log file, or not (the default)
+// argument(s):
+//      src - "t" for a file per session, anything else for one shared file
+// returns:
+//      char* - "t"
+// notes:
+//      the file of session s is the log file with -s before its extension,
+//      Solver-s.log for the default Solver.log
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverLogSessions(const char* const src);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverLogRotate -- limits the size of each log file
+// argument(s):
+//      bytes - a file about to grow past this is renamed file.1 (file.1 to
+//              file.2 and so on, keeping 5) and begun again; 0, the default,
+//              lets files grow
+// returns:
+//      char* - "t"
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverLogRotate(const unsigned long int bytes);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverSolutionCache -- keeps solutions in a directory, shared by all sessions
+// argument(s):
+//      dir - an existing directory, or "" or "nil" for no cache (the default)
+// returns:
+//      char* - "t"
+// notes:
+//      solveBubble and solveAll then take the solution of a problem whose
+//      statements (solveAdd, c_indyAddVariable, c_indyAddEquation) are the
+//      same as an earlier one's from the directory, without solving it.
+//      Several solver processes may share a directory.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverSolutionCache(const char* const dir);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverStats -- how often each routine here has been called and how long it took
+// argument(s):
+//      NONE
+// returns:
+//      char* - a list with an entry for each routine called since the start or
+//              the last solverResetStats, in the order first called:
+//              ((solveAdd :count 12 :errors 0 :usec 1234 :input 345 :max-input 80
+//                :vars 30 :max-vars 5 :histogram (0 0 3 9)) ...)
+// notes:
+//      :errors counts calls returning a solverError, :usec is the total time,
+//      :input the total length of the arguments and :vars the total number of
+//      variables in the problem after each call.  Bucket k of :histogram counts 
+//      calls taking at least 2^(k-1) and less than 2^k microseconds.
+//      The counts are for all sessions together.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverStats();
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// solverResetStats -- sets all the counts given by solverStats to zero
+// returns:
+//      char* - "t"
+/////////////////////////////////////////////////////////////////////////////////////////////////
+RETURN_CSTRING solverResetStats();
+
 #endif // ndef _H_SOLVER_H_
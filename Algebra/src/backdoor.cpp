@@ -29,7 +29,7 @@
 
 
 
-vector<expr *> * theargs;
+// theargs belongs to the current SolverContext
 
 
 
@@ -38,30 +38,34 @@ binopexp * getAnEqn(const string bufst, bool tight);
 
 
 const char * getvarfromtrap(int argnum) {
+  SolverContext * ctx = solverContext();
 
-  if ((*theargs)[argnum]->etype != physvart) 
+
+  if ((*ctx->theargs)[argnum]->etype != physvart) 
 
     throw(string("Backdoor couldn't extract variable from arg ")
 
 	  + itostr(argnum));
 
-  return(((*canonvars)[
+  return(((*ctx->canonvars)[
 
-       ((physvarptr *)(*theargs)[argnum])->varindex])->clipsname.c_str());
+       ((physvarptr *)(*ctx->theargs)[argnum])->varindex])->clipsname.c_str());
 
 }
 
 
 
 int getintfromtrap(int argnum) {
+  SolverContext * ctx = solverContext();
+
 
-  if ((*theargs)[argnum]->etype != numval) 
+  if ((*ctx->theargs)[argnum]->etype != numval) 
 
     throw(string("Backdoor couldn't extract number from arg ")
 
 	  + itostr(argnum));
 
-  numvalexp * nv = (numvalexp *)(*theargs)[argnum];
+  numvalexp * nv = (numvalexp *)(*ctx->theargs)[argnum];
 
   int retval;
 
@@ -90,6 +94,8 @@ int getintfromtrap(int argnum) {
 bool getargs(expr * & e)
 
 {
+  SolverContext * ctx = solverContext();
+
 
   if (e->etype == binop) {
 
@@ -107,9 +113,9 @@ bool getargs(expr * & e)
 
     if ((bexp->rhs->etype != numval) || 
 
-	((numvalexp *)bexp->rhs)->value != theargs->size()+2) {
+	((numvalexp *)bexp->rhs)->value != ctx->theargs->size()+2) {
 
-      DBG(cout << "getargs expected exponent of " << itostr(theargs->size()+2)
+      DBG(cout << "getargs expected exponent of " << itostr(ctx->theargs->size()+2)
 
 	  <<  " in expression " << e->getInfix() << endl;);
 
@@ -121,7 +127,7 @@ bool getargs(expr * & e)
 
     bexp->rhs->destroy();
 
-    theargs->push_back(bexp->lhs);
+    ctx->theargs->push_back(bexp->lhs);
 
     delete bexp;
 
@@ -145,9 +151,9 @@ bool getargs(expr * & e)
 
     
 
-    for (int q = 0; q < nopexp->args->size(); q++)
+    for (int q = 0; q < nopexp->args.size(); q++)
 
-      getargs((*nopexp->args)[q]);
+      getargs(nopexp->args[q]);
 
     delete e;
 
@@ -164,6 +170,8 @@ bool getargs(expr * & e)
 
 
 bool backdoor(const char * const fakeeqn) {
+  SolverContext * ctx = solverContext();
+
 
   int whichfunct;
 
@@ -184,23 +192,23 @@ bool backdoor(const char * const fakeeqn) {
 
   theeqn->lhs->destroy(); delete theeqn;
 
-  theargs = new vector<expr *>;
+  ctx->theargs = new vector<expr *>;
 
   DBG(cout << "backdoor about to getargs" << endl;);
 
   if (!getargs(therhs)) return(false);
 
-  DBG(cout << "backdoor: getargs returned " << theargs->size() 
+  DBG(cout << "backdoor: getargs returned " << ctx->theargs->size() 
 
            << " args" << endl;);
 
   string answer = "Backdoor: ";
 
-  if (theargs->size() < 1) throw(string("backdoor: theargs too small"));
+  if (ctx->theargs->size() < 1) throw(string("backdoor: theargs too small"));
 
-  if ((*theargs)[0]->etype != numval) goto retfalse;
+  if ((*ctx->theargs)[0]->etype != numval) goto retfalse;
 
-  if (!(lookslikeint(((numvalexp *)(*theargs)[0])->value,whichfunct)))
+  if (!(lookslikeint(((numvalexp *)(*ctx->theargs)[0])->value,whichfunct)))
 
     goto retfalse;
 
@@ -212,17 +220,17 @@ bool backdoor(const char * const fakeeqn) {
 
     {
 
-      if (theargs->size() < 3) throw(string("backdoor: theargs too small"));
+      if (ctx->theargs->size() < 3) throw(string("backdoor: theargs too small"));
 
       answer.append("indyIsStudEqnOkay on ");
 
       string eqntest = "(= ";
 
-      eqntest.append((((*theargs)[1])->getLisp(false)).c_str());
+      eqntest.append((((*ctx->theargs)[1])->getLisp(false)).c_str());
 
       eqntest.append(" ");
 
-      eqntest.append( (((*theargs)[2])->getLisp(false)).c_str());
+      eqntest.append( (((*ctx->theargs)[2])->getLisp(false)).c_str());
 
       eqntest.append(")");
 
@@ -236,7 +244,7 @@ bool backdoor(const char * const fakeeqn) {
 
   case 2:			// simplifyEqn
 
-    if (theargs->size() < 3) throw(string("backdoor: theargs too small"));
+    if (ctx->theargs->size() < 3) throw(string("backdoor: theargs too small"));
 
     answer.append("simplifyEqn (");
 
@@ -254,7 +262,7 @@ bool backdoor(const char * const fakeeqn) {
 
   case 3:			// solveOneEqn
 
-    if (theargs->size() < 4) throw(string("backdoor: theargs too small"));
+    if (ctx->theargs->size() < 4) throw(string("backdoor: theargs too small"));
 
     answer.append("solveOneEqn (");
 
@@ -280,7 +288,7 @@ bool backdoor(const char * const fakeeqn) {
 
   case 4:			// subInOneEqn
 
-    if (theargs->size() < 4) throw(string("backdoor: theargs too small"));
+    if (ctx->theargs->size() < 4) throw(string("backdoor: theargs too small"));
 
     answer.append("subInOneEqn (");
 
@@ -310,9 +318,9 @@ bool backdoor(const char * const fakeeqn) {
 
   } // end of switch
 
-  for (q = 0; q < theargs->size(); q++) (*theargs)[q]->destroy();
+  for (q = 0; q < ctx->theargs->size(); q++) (*ctx->theargs)[q]->destroy();
 
-  delete theargs;
+  delete ctx->theargs; ctx->theargs = 0L;
 
   DBG(cout << "backdoor about to throw " << answer << endl;);
 
@@ -320,9 +328,9 @@ bool backdoor(const char * const fakeeqn) {
 
   retfalse:
 
-  for (q = 0; q < theargs->size(); q++) (*theargs)[q]->destroy();
+  for (q = 0; q < ctx->theargs->size(); q++) (*ctx->theargs)[q]->destroy();
 
-  delete theargs;
+  delete ctx->theargs; ctx->theargs = 0L;
 
   DBG(cout << "backdoor returning false from retfalse" << endl;);
 
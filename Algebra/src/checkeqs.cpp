@@ -31,6 +31,7 @@
 #include "dbg.h"
 #include "extstruct.h"
 #include "binopfunctions.h"
+#include "nodearena.h"
 using namespace std;
 
 #define DBG(A) DBGF(NEWCKEQSOUT,A)
@@ -156,6 +157,7 @@ void checkeqs( vector<binopexp *> * & eqn, // equations remaining to be slvd
 #endif
   vector<binopexp *> partsols; // partially solved vars in purelin
   vector<binopexp *> * soleqs = new vector<binopexp *>;
+  scratchNodes scratch;		// for the trees tried and thrown away
   
   numpasses++;
   
@@ -360,17 +362,36 @@ void remove_duplicates (vector<binopexp *> *  eqn, int & doagain )
       }
     
     // remove redundant equations.
+    // uptonum compares the normalized forms of two equations, so only
+    // those whose normalized forms hash the same need be compared, 
+    // unless one normalizes to zero.
+    vector<unsigned long> hashes(eqn->size());
+    vector<bool> zeros(eqn->size());
+    for (size_t e = 0; e < eqn->size(); e++)
+      {
+	expr * normed = copyexpr((*eqn)[e]);
+	numvalexp * factor = normexpr(normed);
+	hashes[e] = exprhash(normed);
+	zeros[e] = (factor == NULL);
+	if (factor) factor->destroy();
+	normed->destroy();
+      }
     for (k = 0; k+1 < eqn->size(); k++)
       for (q = k+1; q < eqn->size(); q++)
 	{
 	  numvalexp * factd=NULL; // result not used
+	  if (hashes[k] != hashes[q] && !zeros[k] && !zeros[q]) continue;
 	  DBGM( cout << "dups? and zeros" << k << " " << q << endl);
 	  if (uptonum((*eqn)[k],(*eqn)[q],factd))
 	    {
 	      if(factd) factd->destroy();
 	      DBGM(cout <<"YES dups " << k << " "  << q << endl);
 	      (*eqn)[q]->destroy();
-	      if(eqn->size()>q+1) (*eqn)[q] = (*eqn)[eqn->size()-1];
+	      if(eqn->size()>q+1) {
+		(*eqn)[q] = (*eqn)[eqn->size()-1];
+		hashes[q] = hashes[eqn->size()-1];
+		zeros[q] = zeros[eqn->size()-1];
+	      }
 	      eqn->pop_back();
 	      q--;
 	    }
@@ -0,0 +1,869 @@
+// checkpoint.cpp
+//    Saving the whole state of a problem to a file, and restoring it
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  A checkpoint holds everything the current context knows about its
+//  problem: canonvars, canoneqf, paramasgn, canongrads, the student
+//  equation slots with their gradients, numsols, the independence
+//  sets and their references, and the counters that go with them.
+//  Restoring it gives a context that answers every later call exactly
+//  as the saved one would, without parsing or differentiating anything.
+//  The file is binary, in the byte order and double format of the
+//  machine that wrote it: numbers are stored as they are in memory, so
+//  values come back bit for bit. It starts with a header that checks
+//  the format, and is written under a temporary name and renamed into
+//  place, so a file that exists is always whole.
+//  A problem image is the part of a checkpoint that every session of
+//  the problem shares: everything but the student equations. It is made
+//  once, offline (solverWriteProblemImage, or solver-batch -images),
+//  after the problem is loaded, and loaded by any later session
+//  instead of its variables and canonical equations. Its header has a
+//  version, raised whenever the layout changes, so an old image is
+//  refused rather than misread. Files are mapped into memory and read
+//  in place.
+//  A problem library is the images of many problems in one file, with
+//  an index of their names and offsets, so nothing in it depends on
+//  where it is mapped. A solver process maps its library once, read
+//  only, and every session loads its problem from there; the pages are
+//  shared through the page cache by all the processes on the machine
+//  that use the same library. A problem of the library is decoded once
+//  in a process, into a context of its own, and the sessions that load
+//  it use its variables, canonical equations and gradients in place,
+//  read only, until one changes them and is given its own copy (see
+//  shareProblem and ownCanon). The decoded trees can't be shared
+//  between processes, as their nodes hold pointers, but a process
+//  forked after loading a problem shares them with its parent until
+//  either writes to them.
+
+#include "decl.h"
+#include "dbg.h"
+#include "extstruct.h"
+#include "extoper.h"
+#include "indyset.h"
+#include "indysgg.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+#define DBG(A) DBGF(INDYEMP,A)
+
+void doinitinit();				// in coldriver.cpp
+
+static const char checkpointMagic[8] = { 'A','n','d','e','s','C','k','1' };
+static const char imageMagic[8] = { 'A','n','d','e','s','I','m','g' };
+static const int imageVersion = 1;
+static const char libraryMagic[8] = { 'A','n','d','e','s','L','i','b' };
+static const int libraryVersion = 1;
+
+// the operators, indexed by their optype
+static oper * const opers[] = { &myplus, &mult, &divby, &topow, &equals,
+				&grt, &gre, &sinef, &cosef, &tanff, &expff,
+				&lnff, &log10ff, &sqrtff, &absff };
+static const int numopers = sizeof(opers) / sizeof(opers[0]);
+
+/************************************************************************
+ * checkpointer  puts the parts of a problem into a string of bytes, 	*
+ *	and takes them out again. It is a friend of dimens and indyset	*
+ *	so as to reach their private parts.				*
+ ************************************************************************/
+class checkpointer
+{
+public:
+  string bytes;			// what is written
+  const char * data;		// what is read
+  size_t size;
+  size_t at;			// next byte to read
+  size_t numvars;		// variables read so far
+
+  checkpointer() : data(0L), size(0), at(0), numvars(0) { }
+  checkpointer(const char * d, size_t n) : data(d), size(n), at(0), numvars(0) { }
+
+  // writing
+  template <class T> void put(const T & x) {
+    bytes.append((const char *) &x, sizeof(T));
+  }
+  void put(const string & s) {
+    put(s.size());
+    bytes.append(s);
+  }
+  template <class T> void put(const vector<T> & v) {
+    put(v.size());
+    if (v.size() > 0) bytes.append((const char *) &v[0], v.size()*sizeof(T));
+  }
+  void put(const vector<bool> & v) {
+    put(v.size());
+    for (size_t k = 0; k < v.size(); k++) put((char) v[k]);
+  }
+  template <class T> void put(const vector<vector<T> > & v) {
+    put(v.size());
+    for (size_t k = 0; k < v.size(); k++) put(v[k]);
+  }
+  void put(const dimens & d) { put(d.dims); }
+  void putexpr(const expr * e);
+  void putvar(const physvar * v);
+  void putgrad(const valander * v);
+  void putset(const indyset & s);
+
+  // reading
+  void need(size_t n) {
+    if (n > size - at)
+      throw(string("checkpoint ends too soon"));
+  }
+  template <class T> void get(T & x) {
+    need(sizeof(T));
+    memcpy(&x, data + at, sizeof(T));
+    at += sizeof(T);
+  }
+  size_t getsize() { size_t n; get(n); need(n); return(n); }
+  void get(string & s) {
+    size_t n = getsize();
+    s.assign(data + at, n);
+    at += n;
+  }
+  template <class T> void get(vector<T> & v) {
+    size_t n = getsize();
+    need(n * sizeof(T));
+    v.resize(n);
+    if (n > 0) memcpy(&v[0], data + at, n * sizeof(T));
+    at += n * sizeof(T);
+  }
+  void get(vector<bool> & v) {
+    size_t n = getsize();
+    v.resize(n);
+    need(n);
+    for (size_t k = 0; k < n; k++) v[k] = data[at++] != 0;
+  }
+  template <class T> void get(vector<vector<T> > & v) {
+    v.resize(getsize());
+    for (size_t k = 0; k < v.size(); k++) get(v[k]);
+  }
+  void get(dimens & d) { get(d.dims); }
+  expr * getexpr();
+  binopexp * getbinop();
+  physvar * getvar();
+  valander * getgrad();
+  void getset(indyset & s);
+};
+
+/************************************************************************
+ * an expression is its etype, known and MKS, then its own parts	*
+ ************************************************************************/
+void checkpointer::putexpr(const expr * e)
+{
+  put((int) e->etype);			// as it was before exprtype shrank
+  put(e->known);
+  put(e->MKS);
+  switch (e->etype) {
+  case numval:
+    put(((const numvalexp *) e)->value);
+    put(((const numvalexp *) e)->abserr);
+    break;
+  case physvart:
+    put(((const physvarptr *) e)->varindex);
+    break;
+  case binop:
+    put(((const binopexp *) e)->op->opty);
+    putexpr(((const binopexp *) e)->lhs);
+    putexpr(((const binopexp *) e)->rhs);
+    break;
+  case function:
+    put(((const functexp *) e)->f->opty);
+    putexpr(((const functexp *) e)->arg);
+    break;
+  case n_op: {
+    const exprlist & args = ((const n_opexp *) e)->args;
+    put(((const n_opexp *) e)->op->opty);
+    put(args.size());
+    for (size_t k = 0; k < args.size(); k++) putexpr(args[k]);
+    break;
+  }
+  default:
+    throw(string("checkpoint of an expression of unknown type"));
+  }
+}
+
+static oper * operOf(optype opty)
+{
+  if (opty < 0 || opty >= numopers)
+    throw(string("checkpoint has a bad operator"));
+  return(opers[opty]);
+}
+
+expr * checkpointer::getexpr()
+{
+  int etype;
+  bool known;
+  dimens MKS;
+  optype opty;
+  expr * e;
+  get(etype);
+  get(known);
+  get(MKS);
+  switch (etype) {
+  case numval: {
+    numvalexp * nv = new numvalexp(0.0);
+    e = nv;
+    get(nv->value);
+    get(nv->abserr);
+    break;
+  }
+  case physvart: {
+    int varindex;
+    get(varindex);
+    if (varindex < 0 || (size_t) varindex >= numvars)
+      throw(string("checkpoint has a bad variable index"));
+    physvarptr * pv = new physvarptr();
+    pv->varindex = varindex;
+    e = pv;
+    break;
+  }
+  // the parts are read before the node is made, so that nothing is
+  // left half made if the checkpoint is bad
+  case binop: {
+    get(opty);
+    oper * op = operOf(opty);
+    expr * lhs = getexpr();
+    expr * rhs;
+    try { rhs = getexpr(); } 
+    catch (string message) { lhs->destroy(); throw message; }
+    binopexp * b = new binopexp();
+    b->op = op;
+    b->lhs = lhs;
+    b->rhs = rhs;
+    e = b;
+    break;
+  }
+  case function: {
+    get(opty);
+    oper * f = operOf(opty);
+    expr * arg = getexpr();
+    functexp * fe = new functexp();
+    fe->f = f;
+    fe->arg = arg;
+    e = fe;
+    break;
+  }
+  case n_op: {
+    get(opty);
+    n_opexp * n = new n_opexp();
+    e = n;
+    try {
+      n->op = operOf(opty);
+      size_t count;
+      get(count);
+      for (size_t k = 0; k < count; k++) n->args.push_back(getexpr());
+    } catch (string message) { e->destroy(); throw message; }
+    break;
+  }
+  default:
+    throw(string("checkpoint has an expression of unknown type"));
+  }
+  e->known = known;
+  e->MKS = MKS;
+  return(e);
+}
+
+// canoneqf, paramasgn and studeqf hold only binopexps
+binopexp * checkpointer::getbinop()
+{
+  expr * e = getexpr();
+  if (e->etype != binop) {
+    e->destroy();
+    throw(string("checkpoint has an equation which is not a binop"));
+  }
+  return((binopexp *) e);
+}
+
+void checkpointer::putvar(const physvar * v)
+{
+  put(v->value);
+  put(v->abserr);
+  put(v->prefUnit);
+  put(v->clipsname);
+  put(v->shortname);
+  put(v->studname);
+  put(v->type);
+  put(v->MKS);
+  put(v->isnonneg);
+  put(v->isnonzero);
+  put(v->isparam);
+  put(v->keepalgebraic);
+  put(v->isused);
+}
+
+physvar * checkpointer::getvar()
+{
+  physvar * v = new physvar();
+  try {
+    get(v->value);
+    get(v->abserr);
+    get(v->prefUnit);
+    get(v->clipsname);
+    get(v->shortname);
+    get(v->studname);
+    get(v->type);
+    get(v->MKS);
+    get(v->isnonneg);
+    get(v->isnonzero);
+    get(v->isparam);
+    get(v->keepalgebraic);
+    get(v->isused);
+  } catch (string message) { delete v; throw message; }
+  return(v);
+}
+
+void checkpointer::putgrad(const valander * v)
+{
+  put(v->value);
+  put(v->gradient);
+  put(v->hasvar);
+}
+
+valander * checkpointer::getgrad()
+{
+  valander * v = new valander(0);
+  try {
+    get(v->value);
+    get(v->gradient);
+    get(v->hasvar);
+  } catch (string message) { delete v; throw message; }
+  if (v->gradient.size() != v->hasvar.size()) {
+    delete v;
+    throw(string("checkpoint has a bad gradient"));
+  }
+  return(v);
+}
+
+void checkpointer::putset(const indyset & s)
+{
+  put(s.numvars);
+  put(s.numinset);
+  put(s.basis);
+  put(s.ordervar);
+  put(s.basexpand);
+  put(s.lastisvalid);
+  put(s.candexpand);
+  put(s.candleft);
+  put(s.candleft_err);
+}
+
+void checkpointer::getset(indyset & s)
+{
+  // numinset is set last, as ~indyset pops that many of each vector
+  int numinset;
+  get(s.numvars);
+  get(numinset);
+  get(s.basis);
+  get(s.ordervar);
+  get(s.basexpand);
+  get(s.lastisvalid);
+  get(s.candexpand);
+  get(s.candleft);
+  get(s.candleft_err);
+  // everything indyset indexes by numvars or numinset must be there
+  bool bad = s.numvars < 0 || numinset < 0 ||
+    (size_t) numinset != s.basis.size() ||
+    (size_t) numinset != s.ordervar.size() ||
+    (size_t) numinset != s.basexpand.size() ||
+    (s.lastisvalid && (s.candexpand.size() < (size_t) numinset ||
+		       s.candleft.size() < (size_t) s.numvars));
+  for (size_t k = 0; !bad && k < s.basis.size(); k++)
+    bad = s.basis[k].size() < (size_t) s.numvars ||
+      s.basexpand[k].size() != k + 1 ||
+      s.ordervar[k] < 0 || s.ordervar[k] >= s.numvars;
+  if (bad) throw(string("checkpoint has a bad independence set"));
+  s.numinset = numinset;
+}
+
+/************************************************************************
+ * putProblem(out, student)  puts the state of the current problem in	*
+ *	out, with the student slots if student				*
+ ************************************************************************/
+static void putProblem(checkpointer & out, bool student)
+{
+  SolverContext * ctx = solverContext();
+  size_t k;
+
+  out.put(gotthevars);
+  out.put(numindyvars);
+  out.put(numindysets);
+  out.put(numparams);
+  out.put(numpasses);
+  out.put(randseed);
+  out.put(ctx->statements);
+
+  out.put(canonvars->size());
+  for (k = 0; k < canonvars->size(); k++) out.putvar((*canonvars)[k]);
+  out.put(*numsols);
+  out.put(canoneqf->size());
+  for (k = 0; k < canoneqf->size(); k++) out.putexpr((*canoneqf)[k]);
+  out.put(paramasgn->size());
+  for (k = 0; k < paramasgn->size(); k++) out.putexpr((*paramasgn)[k]);
+  out.put(canongrads->size());
+  for (k = 0; k < canongrads->size(); k++) out.putgrad((*canongrads)[k]);
+
+  // the student slots, each marked as empty or not
+  for (k = 0; student && k < HELPEQSZ; k++) {
+    out.put((bool) (studeqf[k] != 0L));
+    if (studeqf[k] == 0L) continue;
+    out.putexpr(studeqf[k]);
+    out.put(*studeqsorig[k]);
+    out.put((bool) (studgrads[k] != 0L));
+    if (studgrads[k]) out.putgrad(studgrads[k]);
+  }
+
+  out.put(listofsets->size());
+  for (k = 0; k < listofsets->size(); k++) out.putset((*listofsets)[k]);
+  out.put(*listsetrefs);
+  out.put(*lasttriedeq);
+}
+
+/************************************************************************
+ * readProblem  a problem as read from a checkpoint, held apart from	*
+ *	the context until all of it has been read and checked. Whatever	*
+ *	it still holds when it goes is freed.				*
+ ************************************************************************/
+struct readProblem
+{
+  bool gotvars;			// each as the context field of like name
+  int indyvars, indysets, paramcount, passes;
+  unsigned int seed;
+  string statements;
+  vector<physvar *> vars;
+  vector<double> sols;
+  vector<binopexp *> eqs, params;
+  vector<valander *> grads;
+  vector<binopexp *> studeqs;
+  vector<string> studorig;
+  vector<valander *> studvals;
+  vector<indyset> sets;
+  vector<vector<int> > setrefs;
+  vector<int> lasttried;
+
+  readProblem() : studeqs(HELPEQSZ, 0L), studorig(HELPEQSZ),
+		  studvals(HELPEQSZ, 0L) { }
+  ~readProblem() {
+    size_t k;
+    for (k = 0; k < vars.size(); k++) delete vars[k];
+    for (k = 0; k < eqs.size(); k++) eqs[k]->destroy();
+    for (k = 0; k < params.size(); k++) params[k]->destroy();
+    for (k = 0; k < grads.size(); k++) delete grads[k];
+    for (k = 0; k < HELPEQSZ; k++) {
+      if (studeqs[k]) studeqs[k]->destroy();
+      delete studvals[k];
+    }
+  }
+};
+
+/************************************************************************
+ * getProblem(in, student)  replaces the current problem by the one in	*
+ *	in, with student slots if student. All of in is read and	*
+ *	checked before anything is replaced, so if in is bad this	*
+ *	throws and leaves the problem as it was.			*
+ ************************************************************************/
+static void getProblem(checkpointer & in, bool student)
+{
+  SolverContext * ctx = solverContext();
+  readProblem p;
+  size_t n, k;
+
+  in.get(p.gotvars);
+  in.get(p.indyvars);
+  in.get(p.indysets);
+  in.get(p.paramcount);
+  in.get(p.passes);
+  in.get(p.seed);
+  in.get(p.statements);
+
+  // each count is of things at least a byte long, so getsize bounds it
+  n = in.getsize();
+  p.vars.reserve(n);
+  for (k = 0; k < n; k++) p.vars.push_back(in.getvar());
+  in.numvars = p.vars.size();
+  in.get(p.sols);
+  n = in.getsize();
+  p.eqs.reserve(n);
+  for (k = 0; k < n; k++) p.eqs.push_back(in.getbinop());
+  n = in.getsize();
+  for (k = 0; k < n; k++) p.params.push_back(in.getbinop());
+  n = in.getsize();
+  p.grads.reserve(n);
+  for (k = 0; k < n; k++) p.grads.push_back(in.getgrad());
+
+  for (k = 0; student && k < HELPEQSZ; k++) {
+    bool filled;
+    in.get(filled);
+    if (!filled) continue;
+    p.studeqs[k] = in.getbinop();
+    in.get(p.studorig[k]);
+    in.get(filled);
+    if (filled) p.studvals[k] = in.getgrad();
+  }
+
+  n = in.getsize();
+  for (k = 0; k < n; k++) {
+    p.sets.push_back(indyset(0));
+    in.getset(p.sets.back());
+  }
+  in.get(p.setrefs);
+  in.get(p.lasttried);
+  if (in.at != in.size)
+    throw(string("checkpoint has extra bytes at the end"));
+  // indyEmpty takes the sets down together with their references, and
+  // indyHowIndy looks up the gradient of each equation a set refers to
+  bool bad = p.setrefs.size() != p.sets.size() ||
+    p.lasttried.size() != p.sets.size();
+  for (k = 0; !bad && k < p.sets.size(); k++) {
+    bad = p.setrefs[k].size() != (size_t) p.sets[k].size();
+    for (size_t q = 0; !bad && q < p.setrefs[k].size(); q++)
+      bad = p.setrefs[k][q] < 0 || (size_t) p.setrefs[k][q] >= p.grads.size();
+  }
+  if (bad) throw(string("checkpoint has independence sets that disagree"));
+
+  // all is well: now the current problem goes
+  if (ctx->isFirst) doinitinit();
+  else indyEmpty();
+  gotthevars = p.gotvars;
+  numindyvars = p.indyvars;
+  numindysets = p.indysets;
+  numparams = p.paramcount;
+  numpasses = p.passes;
+  randseed = p.seed;
+  ctx->statements.swap(p.statements);
+  canonvars->swap(p.vars);
+  numsols->swap(p.sols);
+  canoneqf->swap(p.eqs);
+  paramasgn->swap(p.params);
+  canongrads->swap(p.grads);
+  for (k = 0; k < HELPEQSZ; k++) {
+    studeqf[k] = p.studeqs[k];
+    p.studeqs[k] = 0L;
+    studeqsorig[k]->swap(p.studorig[k]);
+    studgrads[k] = p.studvals[k];
+    p.studvals[k] = 0L;
+  }
+  listofsets->swap(p.sets);
+  listsetrefs->swap(p.setrefs);
+  lasttriedeq->swap(p.lasttried);
+}
+
+// the sizes that must match between the writer and the reader
+static void putSizes(checkpointer & out)
+{
+  out.put(sizeof(size_t));
+  out.put(sizeof(double));
+  out.put(HELPEQSZ);
+}
+
+static bool sameSizes(checkpointer & in)
+{
+  size_t sizesize, doublesize;
+  int slots;
+  in.get(sizesize);
+  in.get(doublesize);
+  in.get(slots);
+  return(sizesize == sizeof(size_t) && doublesize == sizeof(double) &&
+	 slots == HELPEQSZ);
+}
+
+/************************************************************************
+ * writeFile(file, bytes, what)  writes bytes to file, under a		*
+ *	temporary name renamed into place				*
+ ************************************************************************/
+static void writeFile(const string & file, const string & bytes,
+		      const char * what)
+{
+  char suffix[40];
+  snprintf(suffix, sizeof(suffix), ".%ld", (long) getpid());
+  string temp = file + suffix;
+  {
+    ofstream f(temp.c_str(), ios::binary);
+    f.write(bytes.data(), bytes.size());
+    f.close();
+    if (!f) {
+      remove(temp.c_str());
+      throw(string("can't write ") + what + " " + file);
+    }
+  }
+  if (rename(temp.c_str(), file.c_str()) != 0) {
+    remove(temp.c_str());
+    throw(string("can't write ") + what + " " + file);
+  }
+  DBG(cout << "wrote " << bytes.size() << " bytes of " << what << " to "
+      << file << endl;);
+}
+
+/************************************************************************
+ * mappedFile  a file mapped into memory while the object lives		*
+ ************************************************************************/
+class mappedFile
+{
+public:
+  const char * data;
+  size_t size;
+
+  mappedFile(const string & file, const char * what) : data(""), size(0) {
+    int fd = open(file.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+      if (fd >= 0) close(fd);
+      throw(string("can't read ") + what + " " + file);
+    }
+    if (info.st_size > 0) {
+      void * p = mmap(0L, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+	close(fd);
+	throw(string("can't read ") + what + " " + file);
+      }
+      data = (const char *) p;
+      size = info.st_size;
+    }
+    close(fd);			// the mapping stays
+  }
+  ~mappedFile() { if (size > 0) munmap((void *) data, size); }
+
+private:
+  mappedFile(const mappedFile &);
+  mappedFile & operator=(const mappedFile &);
+};
+
+static bool hasMagic(const char * data, size_t size, const char * magic)
+{
+  return(size >= 8 && memcmp(data, magic, 8) == 0);
+}
+
+/************************************************************************
+ * checkpointProblem(file)  writes the state of the current problem to	*
+ *	file								*
+ ************************************************************************/
+void checkpointProblem(const string & file)
+{
+  SolverContext * ctx = solverContext();
+  if (ctx->isFirst || !setupdone)
+    throw(string("checkpoint called before initialization"));
+  checkpointer out;
+  out.bytes.append(checkpointMagic, sizeof(checkpointMagic));
+  putSizes(out);
+  putProblem(out, true);
+  writeFile(file, out.bytes, "checkpoint");
+}
+
+/************************************************************************
+ * restoreProblem(file)  replaces the current problem by the one saved	*
+ *	in file. If the file can't be read, the problem is left as it	*
+ *	was.								*
+ ************************************************************************/
+void restoreProblem(const string & file)
+{
+  mappedFile f(file, "checkpoint");
+  if (!hasMagic(f.data, f.size, checkpointMagic))
+    throw(string("not a checkpoint: ") + file);
+  checkpointer in(f.data, f.size);
+  in.at = sizeof(checkpointMagic);
+  if (!sameSizes(in))
+    throw(string("checkpoint written by a different solver: ") + file);
+  try { getProblem(in, true); }
+  catch (string message) { throw(message + " in " + file); }
+  DBG(cout << "restored " << canonvars->size() << " variables and "
+      << canoneqf->size() << " equations from " << file << endl;);
+}
+
+/************************************************************************
+ * writeProblemImage(file)  writes the image of the current problem,	*
+ *	without its student equations, to file				*
+ ************************************************************************/
+void writeProblemImage(const string & file)
+{
+  SolverContext * ctx = solverContext();
+  if (ctx->isFirst || !setupdone)
+    throw(string("problem image made before initialization"));
+  checkpointer out;
+  out.bytes.append(imageMagic, sizeof(imageMagic));
+  out.put(imageVersion);
+  putSizes(out);
+  putProblem(out, false);
+  writeFile(file, out.bytes, "problem image");
+}
+
+/************************************************************************
+ * loadImage(data, size, where)  replaces the current problem by the	*
+ *	one in the image at data, which came from where			*
+ ************************************************************************/
+static void loadImage(const char * data, size_t size, const string & where)
+{
+  if (!hasMagic(data, size, imageMagic))
+    throw(string("not a problem image: ") + where);
+  checkpointer in(data, size);
+  in.at = sizeof(imageMagic);
+  int version;
+  in.get(version);
+  if (version != imageVersion)
+    throw(string("problem image of version ") + itostr(version) +
+	  ", not " + itostr(imageVersion) + ": " + where);
+  if (!sameSizes(in))
+    throw(string("problem image made by a different solver: ") + where);
+  try { getProblem(in, false); }
+  catch (string message) { throw(message + " in " + where); }
+  DBG(cout << "loaded " << canonvars->size() << " variables and "
+      << canoneqf->size() << " equations from image " << where << endl;);
+}
+
+/************************************************************************
+ * loadProblemImage(file)  replaces the current problem by the one in	*
+ *	the image file, with no student equations. If the file can't be	*
+ *	read, the problem is left as it was.				*
+ ************************************************************************/
+void loadProblemImage(const string & file)
+{
+  mappedFile f(file, "problem image");
+  loadImage(f.data, f.size, file);
+}
+
+/************************************************************************
+ * makeProblemLibrary(file, names, images)  writes a library of the	*
+ *	image files images, to be known by names, to file:		*
+ *	  header, count, then for each problem				*
+ *	    its name, the offset and size of its image in the file	*
+ *	  then the images						*
+ ************************************************************************/
+void makeProblemLibrary(const string & file, const vector<string> & names,
+			const vector<string> & images)
+{
+  checkpointer index;
+  index.bytes.append(libraryMagic, sizeof(libraryMagic));
+  index.put(libraryVersion);
+  putSizes(index);
+  index.put(names.size());
+  size_t indexsize = index.bytes.size();
+  for (size_t k = 0; k < names.size(); k++)
+    indexsize += sizeof(size_t) + names[k].size() + 2 * sizeof(size_t);
+
+  string contents;
+  for (size_t k = 0; k < names.size(); k++) {
+    mappedFile f(images[k], "problem image");
+    if (!hasMagic(f.data, f.size, imageMagic))
+      throw(string("not a problem image: ") + images[k]);
+    index.put(names[k]);
+    index.put(indexsize + contents.size());
+    index.put(f.size);
+    contents.append(f.data, f.size);
+  }
+  writeFile(file, index.bytes + contents, "problem library");
+}
+
+// the library of this process, kept while any session is loading from it
+struct problemLibrary {
+  mappedFile file;
+  map<string, pair<size_t, size_t> > images;	// offset and size, by name
+  // the problems decoded, kept while any session shares them, under
+  // libraryLock
+  map<string, weak_ptr<SolverContext> > decoded;
+  problemLibrary(const string & name) : file(name, "problem library") { }
+};
+static shared_ptr<problemLibrary> library;
+static mutex libraryLock;
+
+/************************************************************************
+ * openProblemLibrary(file)  maps the library file, to be used by all	*
+ *	sessions from now on						*
+ ************************************************************************/
+void openProblemLibrary(const string & file)
+{
+  shared_ptr<problemLibrary> lib(new problemLibrary(file));
+  if (!hasMagic(lib->file.data, lib->file.size, libraryMagic))
+    throw(string("not a problem library: ") + file);
+  checkpointer in(lib->file.data, lib->file.size);
+  in.at = sizeof(libraryMagic);
+  int version;
+  in.get(version);
+  if (version != libraryVersion)
+    throw(string("problem library of version ") + itostr(version) +
+	  ", not " + itostr(libraryVersion) + ": " + file);
+  if (!sameSizes(in))
+    throw(string("problem library made by a different solver: ") + file);
+  size_t count, offset, size;
+  string name;
+  in.get(count);
+  for (size_t k = 0; k < count; k++) {
+    in.get(name);
+    in.get(offset);
+    in.get(size);
+    if (offset > lib->file.size || size > lib->file.size - offset)
+      throw(string("problem library has a bad index: ") + file);
+    lib->images[name] = make_pair(offset, size);
+  }
+  lock_guard<mutex> guard(libraryLock);
+  library = lib;
+  DBG(cout << "problem library " << file << " has " << count
+      << " problems" << endl;);
+}
+
+/************************************************************************
+ * loadLibraryProblem(name)  replaces the current problem by problem	*
+ *	name of the library, shared with the other sessions that have	*
+ *	it. The first to load it decodes it, into a context of its own.	*
+ ************************************************************************/
+void loadLibraryProblem(const string & name)
+{
+  shared_ptr<problemLibrary> lib;
+  shared_ptr<SolverContext> problem;
+  {
+    lock_guard<mutex> guard(libraryLock);
+    lib = library;
+    if (lib) {
+      map<string, weak_ptr<SolverContext> >::iterator d =
+	lib->decoded.find(name);
+      if (d != lib->decoded.end()) problem = d->second.lock();
+    }
+  }
+  if (!lib) throw(string("no problem library is open"));
+  if (!problem) {
+    map<string, pair<size_t, size_t> >::const_iterator it =
+      lib->images.find(name);
+    if (it == lib->images.end())
+      throw(string("no problem ") + name + " in the library");
+    shared_ptr<SolverContext> made(new SolverContext);
+    SolverContext * previous = useSolverContext(made.get());
+    try {
+      loadImage(lib->file.data + it->second.first, it->second.second,
+		"problem " + name + " of the library");
+    }
+    catch (...) {
+      useSolverContext(previous);
+      throw;
+    }
+    useSolverContext(previous);
+    lock_guard<mutex> guard(libraryLock);
+    // another session may have decoded it meanwhile
+    problem = lib->decoded[name].lock();
+    if (!problem) {
+      problem = made;
+      lib->decoded[name] = made;
+    }
+  }
+  shareProblem(problem);
+}
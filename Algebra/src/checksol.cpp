@@ -28,7 +28,7 @@
 #define DBG(A) DBGF(CHKSOL,A)
 #define DBGM(A) DBGFM(CHKSOL,A)
 #ifdef WITHDBG // for debugging
-int recall=0;    
+thread_local int recall=0;    
 #endif
 
 // if 1 degree is a numval with value 1, we have FAKEDEG
@@ -46,8 +46,8 @@ public:
   double abserr;
 };
 
-answitherr* evalexpr(const expr* const ex, const vector<double>* const sols,
-		     const double reltverr);
+answitherr evalexpr(const expr* const ex, const vector<double>* const sols,
+		    const double reltverr);
 
 
 /************************************************************************
@@ -67,14 +67,11 @@ int checksol(const binopexp* const eqn, const vector<double>* const sols,
 #ifdef WITHDBG // for debugging
   recall=0;    
 #endif
-  answitherr* value;
-  expr* eqexpr = copyexpr(eqn); // g++ refused this without copyexpr
+  answitherr value;
   try {
-    value = evalexpr(eqexpr, sols, reltverr);
+    value = evalexpr(eqn, sols, reltverr);
   } 
   catch (string &err){
-    // don't delete value, it has never been assigned.
-    eqexpr->destroy();
     DBG(cout << " ERROR " << err << endl);
     if(FPE_handler==err.substr(0,FPE_handler.length()))  //if beginning matches
       return(3);
@@ -82,22 +79,18 @@ int checksol(const binopexp* const eqn, const vector<double>* const sols,
       throw(err);
     }
   }
-  eqexpr->destroy();
   DBGM(cout << "Eqn " << eqn->getInfix() <<
-       " balenced with discrepancy " << value->value 
-       << " and absolute error " << value->abserr << endl);
-  if ((fabs(value->value) <= value->abserr)) {
+       " balenced with discrepancy " << value.value 
+       << " and absolute error " << value.abserr << endl);
+  if ((fabs(value.value) <= value.abserr)) {
     DBG(cout << " seems OK" << endl);
-    delete value;
     return(0);
-  } else if ((fabs(value->value) <= 100 * value->abserr)) {
+  } else if ((fabs(value.value) <= 100 * value.abserr)) {
     DBG(cout << " NOT REALLY OK" << endl);
-    delete value;
     return(1);
   } else {
     DBG(cout << " seems VERY NOT OK on" << endl; cout << eqn->getInfix() 
 	<< endl);
-    delete value;
     return(2);
   }
 }
@@ -117,9 +110,9 @@ int checksol(const binopexp* const eqn, const vector<double>* const sols,
  *      numvals are calculated, and give errors on input given values   *
  *      for which we currently have no facility.                        *
  ************************************************************************/
-answitherr* evalexpr(const expr* const ex, const vector<double>* const sols,
-		     const double reltverr) {
-  answitherr* retval = new answitherr;
+answitherr evalexpr(const expr* const ex, const vector<double>* const sols,
+		    const double reltverr) {
+  answitherr retval;
   int k;
   
 #ifdef WITHDBG // for debugging
@@ -129,149 +122,141 @@ answitherr* evalexpr(const expr* const ex, const vector<double>* const sols,
       << ex->getInfix() << " with reltverr = " << reltverr << endl);
   switch (ex->etype) {
   case numval:
-    retval->value = ((numvalexp*)ex)->value;
-    if( ((numvalexp*)ex)->abserr<0)
-      retval->abserr = reltverr * fabs(retval->value);
-    else
-      retval->abserr = ((numvalexp*)ex)->abserr;
+    retval.value = ((numvalexp*)ex)->value;
+    // The abserr of the numval is not used: checksol used to evaluate
+    // a copy of the equation, and copyexpr doesn't copy abserr, so
+    // the error has always come from reltverr.
+    retval.abserr = reltverr * fabs(retval.value);
     DBG(cout << "evalexpr call " << thiscall << " numval returning " 
-	<< retval->value << "+-" << retval->abserr << endl);
+	<< retval.value << "+-" << retval.abserr << endl);
     return(retval);
     break;
 
   case physvart:
-    retval->value = (*sols)[((physvarptr *) ex)->varindex];
-    retval->abserr = reltverr * fabs(retval->value);
+    retval.value = (*sols)[((physvarptr *) ex)->varindex];
+    retval.abserr = reltverr * fabs(retval.value);
     DBG(cout << "evalexpr call " << thiscall << " physvar returning " 
-	<< retval->value << "+-" << retval->abserr << endl);
+	<< retval.value << "+-" << retval.abserr << endl);
     return(retval);
 
   case function: {
-    answitherr* argval = evalexpr(((functexp *)ex)->arg,sols, reltverr);
+    answitherr argval = evalexpr(((functexp *)ex)->arg,sols, reltverr);
     switch(((functexp *)ex)->f->opty) {    // remember, if FAKEDEG, trig 
     case sine:                // functions in degrees! if not, trig functions
-      retval->value = sin(DEG2RAD * argval->value);      //  of radians
-      retval->abserr = max(fabs(cos(DEG2RAD * argval->value) 
-				* DEG2RAD * (argval->abserr)), reltverr);
+      retval.value = sin(DEG2RAD * argval.value);      //  of radians
+      retval.abserr = max(fabs(cos(DEG2RAD * argval.value) 
+				* DEG2RAD * (argval.abserr)), reltverr);
       break;
     case cose:
-      retval->value = cos(DEG2RAD * argval->value);
-      retval->abserr = max(fabs(sin(DEG2RAD * argval->value) 
-				* DEG2RAD * (argval->abserr)), reltverr);
+      retval.value = cos(DEG2RAD * argval.value);
+      retval.abserr = max(fabs(sin(DEG2RAD * argval.value) 
+				* DEG2RAD * (argval.abserr)), reltverr);
       break;
     case tane:
-      retval->value = tan(DEG2RAD * argval->value);
-      retval->abserr = fabs((1.0 + pow(retval->value,2)) 
-			    * DEG2RAD * (argval->abserr));
+      retval.value = tan(DEG2RAD * argval.value);
+      retval.abserr = fabs((1.0 + pow(retval.value,2)) 
+			    * DEG2RAD * (argval.abserr));
       break;
     case expe:
-      retval->value = exp(argval->value);
-      retval->abserr = fabs(retval->value * argval->abserr);
+      retval.value = exp(argval.value);
+      retval.abserr = fabs(retval.value * argval.abserr);
       break;
     case lne:
-      retval->value = log(argval->value);
-      retval->abserr = fabs(argval->abserr / retval->value);
+      retval.value = log(argval.value);
+      retval.abserr = fabs(argval.abserr / retval.value);
       break;
     case log10e:
-      if(argval->value<=0){\
-	delete retval;
+      if(argval.value<=0){
 	throw(FPE_handler + string("log of negative"));
       }
-      retval->value = log10(argval->value);
-      retval->abserr = fabs(argval->abserr / (retval->value * log(10.0)));
+      retval.value = log10(argval.value);
+      retval.abserr = fabs(argval.abserr / (retval.value * log(10.0)));
       break;
     case sqrte:
-      if(argval->value<0.0){
+      if(argval.value<0.0){
 	// if a negative value is less than the error, just set to zero.
-	if(argval->abserr + argval->value>0.0)
-	  retval->value=0.0;
+	if(argval.abserr + argval.value>0.0)
+	  retval.value=0.0;
 	else {
-	  delete retval;
 	  throw(FPE_handler + string("sqrt of negative"));
 	}
       } else
-	retval->value = sqrt(argval->value);
-      if (retval->value > reltverr) {
-	retval->abserr = (argval->abserr / (2.0 * retval->value));
+	retval.value = sqrt(argval.value);
+      if (retval.value > reltverr) {
+	retval.abserr = (argval.abserr / (2.0 * retval.value));
       } else {
-	retval->abserr = sqrt(argval->abserr);
+	retval.abserr = sqrt(argval.abserr);
       }
       break;
     case abse:
-      retval->value = fabs(argval->value);
-      retval->abserr = argval->abserr;
+      retval.value = fabs(argval.value);
+      retval.abserr = argval.abserr;
       break;
     default:
       throw(string("impossible function in evalexpr"));
     }
     DBG(cout << "evalexpr call " << thiscall << " function returning " 
-	<< retval->value << "+-" << retval->abserr << endl);
-    delete argval;
+	<< retval.value << "+-" << retval.abserr << endl);
     return(retval);
   }
   case binop: {
-    answitherr* lhsval = evalexpr(((binopexp*)ex)->lhs,sols,reltverr);
-    answitherr* rhsval = evalexpr(((binopexp*)ex)->rhs,sols,reltverr);
+    answitherr lhsval = evalexpr(((binopexp*)ex)->lhs,sols,reltverr);
+    answitherr rhsval = evalexpr(((binopexp*)ex)->rhs,sols,reltverr);
     switch(((binopexp*)ex)->op->opty) {
     case divbye:
-      if(rhsval->value==0.0){
-	delete retval;
+      if(rhsval.value==0.0){
 	throw(FPE_handler + string("divide by zero"));
       }
-      retval->value = lhsval->value/rhsval->value;
-      retval->abserr = lhsval->abserr/fabs(rhsval->value) 
-	+ rhsval->abserr * fabs(lhsval->value/pow(rhsval->value,2));
+      retval.value = lhsval.value/rhsval.value;
+      retval.abserr = lhsval.abserr/fabs(rhsval.value) 
+	+ rhsval.abserr * fabs(lhsval.value/pow(rhsval.value,2));
       break;
     case topowe:
-      retval->value = pow(lhsval->value,rhsval->value);
-      if (fabs(lhsval->value)>lhsval->abserr) {
+      retval.value = pow(lhsval.value,rhsval.value);
+      if (fabs(lhsval.value)>lhsval.abserr) {
 	// AW: joel's suggested corrections for kt5a bug (email 9/8/03)  
-	retval->abserr = lhsval->abserr 
-	  * fabs(rhsval->value * (retval->value /lhsval->value)) 
-	  + rhsval->abserr * fabs(log(fabs(lhsval->value)) * retval->value);
+	retval.abserr = lhsval.abserr 
+	  * fabs(rhsval.value * (retval.value /lhsval.value)) 
+	  + rhsval.abserr * fabs(log(fabs(lhsval.value)) * retval.value);
       } else {
-	retval->abserr = pow(lhsval->abserr, rhsval->value - rhsval->abserr);
+	retval.abserr = pow(lhsval.abserr, rhsval.value - rhsval.abserr);
       }
       break;
     case equalse:
-      retval->value = lhsval->value - rhsval->value;
-      retval->abserr = lhsval->abserr + rhsval->abserr;
+      retval.value = lhsval.value - rhsval.value;
+      retval.abserr = lhsval.abserr + rhsval.abserr;
       break;
     case grte:
     case gree:
     default:
       throw(string("I can't return eval of >=, >, or unknown expr"));
     }
-    delete lhsval;
-    delete rhsval;
     DBG(cout << "evalexpr call " << thiscall << " binop returning " 
-	<< retval->value << "+-" << retval->abserr << endl);
+	<< retval.value << "+-" << retval.abserr << endl);
     return(retval);
   }
   case n_op: {
     switch(((n_opexp*)ex)->op->opty) {
     case pluse: {
-      retval->value = 0;
-      retval->abserr = 0;
-      for (k=0; k<((n_opexp*)ex)->args->size(); k++) {
-	answitherr* argval 
-	  = evalexpr((*((n_opexp *)ex)->args)[k], sols,reltverr);
-	retval->value += argval->value;
-	retval->abserr += argval->abserr;
-	delete argval;
+      retval.value = 0;
+      retval.abserr = 0;
+      for (k=0; k<((n_opexp*)ex)->args.size(); k++) {
+	answitherr argval 
+	  = evalexpr(((n_opexp *)ex)->args[k], sols,reltverr);
+	retval.value += argval.value;
+	retval.abserr += argval.abserr;
       }
       break;
     }
     case multe: {
-      retval->value = 1;
-      retval->abserr = 0;
-      for (k=0; k<((n_opexp*)ex)->args->size(); k++)  {
-	answitherr* argval
-	  = evalexpr((*((n_opexp*)ex)->args)[k],sols,reltverr);
-	retval->abserr = fabs(argval->value*retval->abserr) 
-	  + fabs(argval->abserr * retval->value);
-	retval->value *= argval->value;
-	delete argval;
+      retval.value = 1;
+      retval.abserr = 0;
+      for (k=0; k<((n_opexp*)ex)->args.size(); k++)  {
+	answitherr argval
+	  = evalexpr(((n_opexp*)ex)->args[k],sols,reltverr);
+	retval.abserr = fabs(argval.value*retval.abserr) 
+	  + fabs(argval.abserr * retval.value);
+	retval.value *= argval.value;
       }
       break;
     }
@@ -280,7 +265,7 @@ answitherr* evalexpr(const expr* const ex, const vector<double>* const sols,
     }
   }
     DBG(cout << "evalexpr call " << thiscall << " n_op returning " 
-	<< retval->value << "+-" << retval->abserr << endl);
+	<< retval.value << "+-" << retval.abserr << endl);
     return(retval);
   case unknown:
   case fake:
@@ -21,6 +21,7 @@
 //	from files generated by Collin, 1/29/01
 //	Just as list2 but for new solver format
 #define IAmMain
+#define SOLVERCONTEXT_MEMBERS	// the state is reached through ctx
 #include <stdio.h>
 #include "coldriver.h"
 #include "extstruct.h"
@@ -38,10 +39,10 @@ void doinitinit();  // this is defined below
 int checksol(const binopexp * const eqexpr, const vector<double> * const sols,
 	     const double reltverr);
 void dimchkeqf(iostream & outstr);
+void noteStatement(const char * const kind, const string & text);
+bool cachedSolution(string & solution, vector<double> & sols);
+void cacheSolution(const string & solution, const vector<double> & sols);
 
-extern vector<valander *> *canongrads;
-
-bool isFirst = true;		// instantiation moved here by Linn
 //////////////////////////////////////////////////////////////////////////////
 // static/local error messages reurned for copying
 const char* error[] = {
@@ -51,52 +52,76 @@ const char* error[] = {
 	"So far so good",
 	"nil",
 };
-char lzbfr[4096]; // major kludge but this needs to be rewritten once
-// it's in working anyway
-stringstream resultBuffer;     // hold output in string buffer.
+// isFirst, lzbfr and resultBuffer (which holds the solution text) belong
+// to the current SolverContext
 
-void constsfill();
-extern unitabrs unittable;
+extern const unitabrs unittable;
 
 /************************************************************************
- * solveTheProblem							*
+ * solveIntoBuffer							*
  *	Assumes the equations and variables have already been entered	*
- *	solves the problem, writing the solution in TEMP_FILE, 		*
+ *	solves the problem, writing the solution in resultBuffer, 	*
  *	including the tags and problem statements if the problem was	*
  *	not completely solved.						*
- *   Then it opens the file for reading, and returns the first line	*
- *	[does not close file]						*
+ *   If the solution is in the solution cache, it is taken from there	*
+ *	instead, and otherwise is put there.				*
  ************************************************************************/
-const char* solveTheProblem() {
+static void solveIntoBuffer() {
+  SolverContext * ctx = solverContext();
   int k;
+  stringstream & resultBuffer = ctx->resultBuffer;
 
-  if (isFirst) throw string("solveTheProblem called before initialization");
+  if (ctx->isFirst) throw string("solveTheProblem called before initialization");
   try {
+    string cached;
+    if (cachedSolution(cached, *ctx->numsols)) {
+      // solveeqs takes the parameter assignments for its own and frees
+      // them; they go here too, so the problem is left as it would be
+      for (k = ctx->paramasgn->size(); k > 0; k--) {
+	(*ctx->paramasgn)[k-1]->destroy();
+	ctx->paramasgn->pop_back();
+      }
+      resultBuffer.str(cached);
+      resultBuffer.clear();
+      return;
+    }
     // reset the buffer to be empty
     resultBuffer.str(string());
     if(resultBuffer.good()) {
-      numsols->assign(canonvars->size(),HUGE_VAL);
+      ctx->numsols->assign(ctx->canonvars->size(),HUGE_VAL);
       if (solveeqs(resultBuffer)) {
 	// should we do checking of solution here?
 	bool discrep = false;
-	for (k = 0; k < canoneqf->size(); k++) {
-	  if (checksol((*canoneqf)[k],numsols,RELERR) > 1) {
+	for (k = 0; k < ctx->canoneqf->size(); k++) {
+	  if (checksol((*ctx->canoneqf)[k],ctx->numsols,RELERR) > 1) {
 	    if (!discrep) {
 	      resultBuffer << "<DISCREPANCIES>" << endl;
 	      discrep = true;
 	    }
-	    resultBuffer << (*canoneqf)[k]->getInfix() << endl;
+	    resultBuffer << (*ctx->canoneqf)[k]->getInfix() << endl;
 	  }
 	} // loop over equations to check
 	dimchkeqf(resultBuffer);
 	// end of "should we do checking of solution here?"
       }
+      cacheSolution(resultBuffer.str(), *ctx->numsols);
     } 
     else throw string("unable to create solution buffer");
   } 
   catch (string message) { throw message; } 
   catch (...) { throw string("solveTheProblem went boom!!"); }
+}
 
+/************************************************************************
+ * solveTheProblem							*
+ *	solves the problem into resultBuffer, as above, and returns	*
+ *	the first line, leaving the rest for solveMoreOfTheProblem	*
+ ************************************************************************/
+const char* solveTheProblem() {
+  stringstream & resultBuffer = solverContext()->resultBuffer;
+  string & lzbfr = solverContext()->lzbfr;
+
+  solveIntoBuffer();
   // this would be a good place to insert checksol ? or after returning
   // solution, in solveMoreOfTheProblem ?
   try {
@@ -106,12 +131,9 @@ const char* solveTheProblem() {
     try { tk = resultBuffer.eof(); } 
     catch (...) { throw string("eof?!?"); }
     if (! tk) {
-      string t;
-      try { t = getaline(resultBuffer); }
+      try { getaline(resultBuffer, lzbfr); }
       catch (...) { throw string("getaline fails???"); }
-      try { sprintf(lzbfr, "%s", t.c_str()); } 
-      catch(...) { throw string("copy is wrong??"); }
-      return lzbfr;
+      return lzbfr.c_str();
     } 
     else return error[4];
   } 
@@ -129,15 +151,16 @@ const char* solveTheProblem() {
  *	I don't understand when is returns "So far so good"		*
  ************************************************************************/
 const char* solveMoreOfTheProblem() {
+  stringstream & resultBuffer = solverContext()->resultBuffer;
+  string & lzbfr = solverContext()->lzbfr;
   try {
     if (! resultBuffer.eof()) {
-      string t = getaline(resultBuffer);
-      if (t.size() == 0) {
+      getaline(resultBuffer, lzbfr);
+      if (lzbfr.size() == 0) {
         resultBuffer.clear();
 	return error[4];	// if checksol after returning sol, here+below
       } // end of if line empty, which closes and returns
-      else sprintf(lzbfr, "%s", t.c_str());
-      return lzbfr;
+      return lzbfr.c_str();
     } // end of not eof. 
     else {
       resultBuffer.clear();
@@ -154,11 +177,54 @@ const char* solveMoreOfTheProblem() {
 }
 
 
+/************************************************************************
+ * solveAllOfTheProblem							*
+ *	solves the problem into resultBuffer, as above, and returns	*
+ *	all of the solution at once, as a list of sections:		*
+ *	  ((solved variable lines ...) 					*
+ *	   (<PARTSLVV> lines ...) (<UNSLVEQS> lines ...) ...)		*
+ *	where each tag line of the solution (<PARTSLVV>, <UNSLVEQS>,	*
+ *	<UNSLVVARS>, <UNUSEDVARS>, <DISCREPANCIES>, <INCONSISTENCIES>)	*
+ *	starts a section. As with solveMoreOfTheProblem, the solution	*
+ *	ends at an empty line. Nothing is left for solveMoreOfTheProblem*
+ ************************************************************************/
+const char* solveAllOfTheProblem() {
+  stringstream & resultBuffer = solverContext()->resultBuffer;
+  string & text = solverContext()->lzbfr;
+
+  solveIntoBuffer();
+  // the lines are taken straight from the buffer's string
+  const string solution = resultBuffer.str();
+  text = "((";
+  bool first = true;		// no line yet in this section
+  string::size_type start = 0;
+  while (start < solution.size()) {
+    string::size_type end = solution.find_first_of("\r\n", start);
+    if (end == string::npos) end = solution.size();
+    if (end == start) break;	// empty line
+    if (solution[start] == '<') {
+      text += ") (";
+      first = false;
+    } else if (!first) text += " ";
+    else first = false;
+    text.append(solution, start, end - start);
+    // a line ends at either of \r or \n, as in getaline
+    start = end + 1;
+  }
+  text += "))";
+  resultBuffer.clear();
+  resultBuffer.seekg(0, ios::end);
+  return text.c_str();
+}
+
 bool handleInput(std::string& aLine) {
   try {
-    if (isFirst) doinitinit();
+    if (solverContext()->isFirst) doinitinit();
     bool result = true;
-    if (!aLine.empty()) result = getall(aLine);
+    if (!aLine.empty()) {
+      noteStatement("solveAdd", aLine);
+      result = getall(aLine);
+    }
   return result; // Unexpected input
   } 
   catch (std::string message) { throw message; } 
@@ -169,19 +235,19 @@ void indyEmpty();
 bool clearTheProblem() {
   try {
     indyEmpty();
-    isFirst = false;
+    solverContext()->isFirst = false;
     return true;
   }
   catch (std::string message) { throw message; } 
   catch (...) { throw std::string("Handle Input is broke"); }
 }
 
-extern bool setupdone;
 
 void doinitinit() {
+  SolverContext * ctx = solverContext();
   try {
-    isFirst = false;
-    setupdone = false;
+    ctx->isFirst = false;
+    ctx->setupdone = false;
     indyEmpty(); 
   }
   catch (std::string message) { throw message; } 
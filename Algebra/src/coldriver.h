@@ -20,4 +20,5 @@
 #define COLDRIVER_INCLUDED
 const char* solveTheProblem();
 const char* solveMoreOfTheProblem();
+const char* solveAllOfTheProblem();
 #endif
@@ -24,11 +24,21 @@
  *   and returns a pointer to it.					*
  ************************************************************************/
 #include "expr.h"
+#include "solvercontext.h"
+#include "nodearena.h"
 using namespace std;
 
 // has no diagnostics included.
 
+static expr * copynode(const expr * old);
+
 expr * copyexpr(const expr * old )
+{
+  solverContext()->nodes->copied();	// counted for solverStats
+  return(copynode(old));
+}
+
+static expr * copynode(const expr * old )
 {			
   expr * ret;
   switch (old->etype)	
@@ -45,19 +55,19 @@ expr * copyexpr(const expr * old )
       break;
     case binop:			// also oper's do not get copied!
       ret = new binopexp( ((binopexp *) old)->op,
-			   copyexpr(((binopexp *) old)->lhs),
-			   copyexpr(((binopexp *) old)->rhs));
+			   copynode(((binopexp *) old)->lhs),
+			   copynode(((binopexp *) old)->rhs));
       break;
     case function:
       ret = new functexp( ((functexp *) old)->f,
-			   copyexpr(((functexp *) old)->arg));
+			   copynode(((functexp *) old)->arg));
       break;
     case n_op:
       {
 	ret = new n_opexp(((n_opexp *) old)->op);
-	for (int k=0; k < ((n_opexp *) old)->args->size(); k++)
-	  ((n_opexp *) ret)->args->
-	    push_back(copyexpr((*((n_opexp *) old)->args)[k]));
+	for (int k=0; k < ((n_opexp *) old)->args.size(); k++)
+	  ((n_opexp *) ret)->args.
+	    push_back(copynode(((n_opexp *) old)->args[k]));
 	//cout << "n_opexp copy   " << ((n_opexp *) ret)->args << " for " 
 	//     << ret->getInfix() << endl;
 	break;
@@ -92,9 +102,8 @@ void expr::destroy()
       return;
     case n_op:
       // cout << "n_opexp delete " << ((n_opexp *) this)->args << endl;
-      for (int k=0; k < ((n_opexp *) this)->args->size(); k++)
-	(*(((n_opexp *) this)->args))[k]->destroy();
-      delete ((n_opexp *) this)->args;
+      for (int k=0; k < ((n_opexp *) this)->args.size(); k++)
+	(((n_opexp *) this)->args)[k]->destroy();
       delete ((n_opexp *) this);
       return;
     }
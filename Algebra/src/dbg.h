@@ -85,4 +85,5 @@
 #endif
 
 LZ_EXTERN_SPEC unsigned long dbglevel LZ_INIT_INT_SPEC;
-LZ_EXTERN_SPEC unsigned long dbgnum LZ_INIT_INT_SPEC;
+// numbers recursive calls in debug output; each thread counts its own
+LZ_EXTERN_SPEC thread_local unsigned long dbgnum LZ_INIT_INT_SPEC;
@@ -53,6 +53,7 @@ void eqnumsimp(expr * &, const bool);				// eqnumsimp
 bool equaleqs(const expr * exp1, const expr * exp2);		// equaleqs
 double evalpoly(const vector<double> * poly, const double x);	// polysolve
 bool exprcontains(expr * e,varindx var);			// subexpin
+unsigned long exprhash(const expr * ex);			// exprhash
 bool factorout(const expr * factor,int n, expr * & expression); // factorout
 vector<double> * findallroots(vector<double> *poly);		// polysolve
 double findroot(const vector<double> * poly, 			// polysolve
@@ -62,6 +63,7 @@ void findtrigvars(expr * & ex, vector<expr *> * &trigvars);	// solvetrig
 bool fixupforpls(binopexp * & eq);				// fixupforpls
 bool flatten(expr * &);						// flatten
 string getaline(istream &instr);				// getaline
+void getaline(istream &instr, string &str);			// getaline
 bool getall(string bufst);					// getall
 bool getallfile(istream &);			  	        // getallfile
 int getclipsvar(string token,int start);			// parse
@@ -114,7 +116,7 @@ void printdv(const vector<double> & vec);			// utils
 bool purelinsolv(const vector<binopexp *> * const eqs,		// purelin
 	const vector<varindx> * const vars, 
 	vector<binopexp *> * sols);
-void qsrtexpr(vector<expr *> *Vptr);				// qsrtexpr
+void qsrtexpr(exprlist *Vptr);				// qsrtexpr
 bool rationalize(binopexp * & eq);				// rationalize
 void remove_duplicates (vector<binopexp *> *eqn, int & doagain);
 bool signisknown(const expr * const ex);			// solvetrig
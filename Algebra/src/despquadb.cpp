@@ -120,9 +120,9 @@ vector<double> *twoqcfex(expr *ex, const varindx v1, const varindx v2)
 	  {
 	    retval = new vector<double>(6,0.);
 	    vector<double> * thterm;
-	    for (k = 0; k < nopex->args->size(); k++)
+	    for (k = 0; k < nopex->args.size(); k++)
 	      {
-		thterm = twoqcfex((*nopex->args)[k],v1,v2);
+		thterm = twoqcfex(nopex->args[k],v1,v2);
 		DBG( { cout << "Twoqcfex on arg " << k << " of plus returned ";
 		       if (thterm == (vector<double> *) NULL) 
 			 cout << "false" << endl;
@@ -143,15 +143,15 @@ vector<double> *twoqcfex(expr *ex, const varindx v1, const varindx v2)
 	int curpow = 0;
 	double factor = 1.;
 	vector<double> * thterm;
-	for (k = 0; k < nopex->args->size(); k++)
+	for (k = 0; k < nopex->args.size(); k++)
 	  {
-	    if (((*nopex->args)[k])->etype == numval)
-	      factor *= ((numvalexp *)(*nopex->args)[k])->value;
+	    if ((nopex->args[k])->etype == numval)
+	      factor *= ((numvalexp *)nopex->args[k])->value;
 	    else
 	      {
 		if (curpow >= 2) 
 		  {delete retval; return((vector<double> *)NULL);}
-		thterm = twoqcfex((*nopex->args)[k],v1,v2);
+		thterm = twoqcfex(nopex->args[k],v1,v2);
 		DBG( { cout << "Twoqcfex on arg " << k << " of mult returned ";
 		       if (thterm == (vector<double> *) NULL) 
 			 cout << "false" << endl;
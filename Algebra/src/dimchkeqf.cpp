@@ -40,8 +40,11 @@ void dimchkeqf(iostream & outstr)
   DBG( cout << "Entering dimchkeqf." << endl;);
 
   bool inconsist = false;
+  // dimenchk fills in the dimensions it finds, so equations shared with
+  // other sessions are checked on a copy
+  bool shared = (bool) solverContext()->canonOwner;
   for (k = 0; k < canoneqf->size(); k++) {
-    expr *eqexpr = (expr *)(*canoneqf)[k];
+    expr *eqexpr = shared ? copyexpr((*canoneqf)[k]) : (expr *)(*canoneqf)[k];
     trouble = dimenchk(true,eqexpr);
     if (eqexpr->MKS.unknp()) {
       if (!inconsist){
@@ -58,6 +61,7 @@ void dimchkeqf(iostream & outstr)
 	   << trouble->getInfix() << " in equation " << eqexpr->getInfix() 
 	     << endl; 
     }
+    if (shared) eqexpr->destroy();
   }
 
   DBG( cout << "next check constraints" << endl;);
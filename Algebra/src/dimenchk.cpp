@@ -285,27 +285,27 @@ expr * dimenchk(const bool fix, expr * & ex)
 	n_opexp * nopex = (n_opexp *) ex;
 	int numunk=0;
 	DBG( cout << "n_op on " << ex->getInfix() << endl);
-	for (j=0; j< nopex->args->size(); j++)
-	  if ((*nopex->args)[j]->MKS.unknp()) numunk++;
+	for (j=0; j< nopex->args.size(); j++)
+	  if (nopex->args[j]->MKS.unknp()) numunk++;
 	if (nopex->MKS.unknp()) numunk++;
 	DBG( cout << "n_op " << numunk
-	     << " unkn parts, size " << nopex->args->size() << endl);
+	     << " unkn parts, size " << nopex->args.size() << endl);
 	// numunk is the number of args with unknown dimensions, plus
 	// one if the sum/prod also has unknown dimensions. For plus, if
 	// any of these is known, all the others must be the same. For
 	// mult, if one of these is unknown it can be determined, but if
 	// more are unknown we can't determine them. If we can't fix any
 	// dimens yet, check the args now
-	if ((numunk > nopex->args->size()) || 
+	if ((numunk > nopex->args.size()) || 
 	    ((nopex->op->opty == multe) && numunk > 1))
 	  {			// can't fix dimen without dimenchk args
-	    for (j=0; j < nopex->args->size(); j++)
+	    for (j=0; j < nopex->args.size(); j++)
 	      {
-		bool couldfix = (*nopex->args)[j]->MKS.unknp();
+		bool couldfix = nopex->args[j]->MKS.unknp();
 		if (trouble == (expr *) NULL) 
-		  trouble = dimenchk(fix,(*nopex->args)[j]);
-		else dimenchk(fix,(*nopex->args)[j]);
-		if (couldfix && !(*nopex->args)[j]->MKS.unknp()) numunk--;
+		  trouble = dimenchk(fix,nopex->args[j]);
+		else dimenchk(fix,nopex->args[j]);
+		if (couldfix && !nopex->args[j]->MKS.unknp()) numunk--;
 	      }
 	    DBG( cout << "n_op no fix before doing parts, now " 
 		 << ex->getInfix() << ", numunk = " << numunk  << endl);
@@ -315,7 +315,7 @@ expr * dimenchk(const bool fix, expr * & ex)
  	switch(nopex->op->opty)
 	  {
 	  case pluse:
-	    if (numunk > nopex->args->size()) {
+	    if (numunk > nopex->args.size()) {
 	      DBG( cout << "plus all unkn " << endl);
 	      return(trouble);
 	    }
@@ -326,27 +326,27 @@ expr * dimenchk(const bool fix, expr * & ex)
 	      foundone = true;
 	      k = -1;
 	      tempds = nopex->MKS;}
-	    for (j=0; j < nopex->args->size(); j++)
-	      if ((*nopex->args)[j]->MKS.unknp())
-		{ if (foundone) (*nopex->args)[j]->MKS = tempds; }
+	    for (j=0; j < nopex->args.size(); j++)
+	      if (nopex->args[j]->MKS.unknp())
+		{ if (foundone) nopex->args[j]->MKS = tempds; }
 	      else {		// found a term with known dimen
 		if (foundone) {
-		  if (!( (*nopex->args)[j]->MKS == tempds)) {
+		  if (!( nopex->args[j]->MKS == tempds)) {
 		    DBG( cout << "plus units error from call " 
 			 << thisdbg << endl; nopex->dbgprint(6));
 		    return(nopex); } }
 		else {
 		  foundone = true;
 		  k = j;
-		  tempds = (*nopex->args)[j]->MKS;
+		  tempds = nopex->args[j]->MKS;
 		} }
 	    if (!foundone) throw(string("impossible in dimenchk") +
 				" known known not found");
 	    for (j=0; j < k; j++)
-	      if ((*nopex->args)[j]->MKS.unknp())
-		(*nopex->args)[j]->MKS = tempds;
+	      if (nopex->args[j]->MKS.unknp())
+		nopex->args[j]->MKS = tempds;
 	      else 
-		if (!( (*nopex->args)[j]->MKS == tempds)) {
+		if (!( nopex->args[j]->MKS == tempds)) {
 		  DBG( cout << "plus units error " << nopex->getInfix()
 		       << " from call " << thisdbg << endl);
 		  return(nopex);
@@ -358,10 +358,10 @@ expr * dimenchk(const bool fix, expr * & ex)
 		   << " from dimenchk PROBLEM " << thisdbg << endl;);
 	      return(nopex);
 	    }
-	    for (j=0; j < nopex->args->size(); j++)
+	    for (j=0; j < nopex->args.size(); j++)
 	      if (trouble == (expr *) NULL) 
-		trouble = dimenchk(fix,(*nopex->args)[j]);
-	      else dimenchk(fix,(*nopex->args)[j]);
+		trouble = dimenchk(fix,nopex->args[j]);
+	      else dimenchk(fix,nopex->args[j]);
 	    DBG( if (trouble == (expr *) NULL) cout << "Returning NULL";
 		 else cout << "Returning " << trouble->getInfix();
 		 cout << " from dimenchk " << thisdbg << endl;);
@@ -376,12 +376,12 @@ expr * dimenchk(const bool fix, expr * & ex)
 	    }
 	    tempds.put(0,0,0,0,0);
 	    k = -1;
-	    for (j=0; j < nopex->args->size(); j++) {
+	    for (j=0; j < nopex->args.size(); j++) {
 	      if (trouble == (expr *) NULL) 
-		trouble = dimenchk(fix,(*nopex->args)[j]);
-	      else dimenchk(fix,(*nopex->args)[j]);
-	      if ((*nopex->args)[j]->MKS.unknp()) k = j;
-	      else tempds = tempds + (*nopex->args)[j]->MKS;
+		trouble = dimenchk(fix,nopex->args[j]);
+	      else dimenchk(fix,nopex->args[j]);
+	      if (nopex->args[j]->MKS.unknp()) k = j;
+	      else tempds = tempds + nopex->args[j]->MKS;
 	    }
 	    DBG( 
 		cout << "Dimenchk mult end arg loop, numunk = " << numunk
@@ -400,8 +400,8 @@ expr * dimenchk(const bool fix, expr * & ex)
 		   cout << " from dimenchk " << thisdbg << endl;);
 	      return(trouble);
 	    }
-	    if ((k>=0) && k < nopex->args->size())
-	    (*nopex->args)[k]->MKS = nopex->MKS + tempds * -1.;
+	    if ((k>=0) && k < nopex->args.size())
+	    nopex->args[k]->MKS = nopex->MKS + tempds * -1.;
 	    DBG( cout << "Dimenchk mult returning, with nopex" << endl; 
 		 nopex->dbgprint(8);
 		 );
@@ -134,6 +134,13 @@ bool dimens::operator==(const dimens b) const
   return(true);
 }
 
+unsigned int dimens::hash() const
+{
+  unsigned int h = 0;
+  for (int k = 0; k < 5; k++) h = (h << 8 | h >> 24) ^ (unsigned char) dims[k];
+  return(h);
+}
+
 dimens dimens::operator*(const double km) const
 {
   dimens retdim;
@@ -226,11 +233,11 @@ string dimens::print()
 {
   char dimsstr[25];
   if(unknp())
-    sprintf(dimsstr,"(unknown)");
+    snprintf(dimsstr,sizeof(dimsstr),"(unknown)");
   else if(inconsp())
-    sprintf(dimsstr,"(inconsistent");
+    snprintf(dimsstr,sizeof(dimsstr),"(inconsistent");
   else
-    sprintf(dimsstr,"(%4.1lf,%4.1lf,%4.1lf,%4.1lf,%4.1lf)",
+    snprintf(dimsstr,sizeof(dimsstr),"(%4.1lf,%4.1lf,%4.1lf,%4.1lf,%4.1lf)",
 	    getlengthd(),getmassd(),gettimed(),getcharged(),gettempd());
   return(string(dimsstr));
 }
@@ -30,6 +30,7 @@ typedef signed char DIMEXP;	// dimensions are stored as
 //  incopnsistancy, and possibly MAYBZ if probably but not certainly zero
 class dimens
 {
+  friend class checkpointer;	// in checkpoint.cpp
  private:
   //  lengthdim,  massdim,  timedim, chargedim, tempdim, in that order;
   DIMEXP dims[5];
@@ -64,6 +65,7 @@ class dimens
   dimens& operator*=(const double);
   bool adjust(const dimens & a);
   bool operator==(const dimens b) const;
+  unsigned int hash() const;	// equal when == is
   dimens operator*(const double k) const;
   dimens operator+(const dimens b) const;
 };
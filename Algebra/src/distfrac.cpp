@@ -47,7 +47,7 @@ bool distfrac(expr * & ex)
   if (ex->etype != n_op) throw(string("distfrac called on non-n_op"));
   n_opexp * enop = (n_opexp *) ex;
   if (enop->op->opty != pluse) throw(string("distfrac called on non-plus"));
-  if (enop->args->size() < 2) { unnop(ex);   return(true);  }
+  if (enop->args.size() < 2) { unnop(ex);   return(true);  }
   // lcd is the least common denominator of all terms in the plus,
   //   built up first before working on numerator
   //	 WARNING  lcd and denom may have <2 args
@@ -55,14 +55,14 @@ bool distfrac(expr * & ex)
   n_opexp *denom;		// denominator of current term
   
   DBG( cout << "distfrac " << thisdbg << " on an plus nop of size "
-	     << enop->args->size() << endl);
-  for (k=0; k < enop->args->size(); k++)
-    if (((*enop->args)[k]->etype == binop)  &&
-	(((binopexp *)(*enop->args)[k])->op->opty == divbye))
+	     << enop->args.size() << endl);
+  for (k=0; k < enop->args.size(); k++)
+    if ((enop->args[k]->etype == binop)  &&
+	(((binopexp *)enop->args[k])->op->opty == divbye))
       {
 	DBG(cout << k << " term of enop plus is a divbye" << endl);
 	// nkbin = this term as binop
-	binopexp *nkbin = (binopexp *)(*enop->args)[k];
+	binopexp *nkbin = (binopexp *)enop->args[k];
 	// if this term's denominator is a mult, treat each factor separately,
 	// but otherwise treat the whole denominator as one factor
 	// It is denom
@@ -77,14 +77,14 @@ bool distfrac(expr * & ex)
 	// for each factor in denom, see if it matches one in lcd,
 	// If not, add it to lcd, and in either case remove from denom
 	// ??? what if a factor appears twice in denom and once in lcd?
-	for (q=0; q < denom->args->size(); q++)
+	for (q=0; q < denom->args.size(); q++)
 	  {
 	    int r;
-	    for (r=0; r < lcd->args->size(); r++)
-	      if (equaleqs((*denom->args)[q],(*lcd->args)[r])) break;
-	    if (r == lcd->args->size()) 
-	      lcd->addarg((*denom->args)[q]);
-	    else (*denom->args)[q]->destroy();
+	    for (r=0; r < lcd->args.size(); r++)
+	      if (equaleqs(denom->args[q],lcd->args[r])) break;
+	    if (r == lcd->args.size()) 
+	      lcd->addarg(denom->args[q]);
+	    else denom->args[q]->destroy();
 	  }
 	// rmed 2/4/01 need to check		delete denom->args;
 	delete denom;			// lcd holds new denominator
@@ -92,24 +92,24 @@ bool distfrac(expr * & ex)
   // note: lcd left mult even if zero or one arg until sum done
   // if sum includes a ratio, plsnumer will become numerator, 
   // rete answer.
-  if (lcd->args->size() > 0)
+  if (lcd->args.size() > 0)
     {
       DBG( cout << "finished making lcd of + / ..., it is = "
 	   << lcd->getInfix() << endl );
       n_opexp *plsnumer =  new n_opexp(&myplus);
       n_opexp * temp4;		// numerator of current term
-      for (k=0; k < enop->args->size(); k++)
+      for (k=0; k < enop->args.size(); k++)
 	{
-	  if (((*enop->args)[k]->etype != binop) ||
-	      (((binopexp *)(*enop->args)[k])->op->opty != divbye))
+	  if ((enop->args[k]->etype != binop) ||
+	      (((binopexp *)enop->args[k])->op->opty != divbye))
 	    {		// this one not a ratio
 	      temp4 = (n_opexp *) copyexpr(lcd); // temp4 start of 
-	      temp4->addarg((*enop->args)[k]);	// current term
+	      temp4->addarg(enop->args[k]);	// current term
 	      plsnumer->addarg(temp4);		// of num sum
 	    } 					
 	  else		// kth term in enop is a ratio, lnum/lden
 	    {
-	      binopexp *ratio = (binopexp *) (*enop->args)[k];
+	      binopexp *ratio = (binopexp *) enop->args[k];
 	      if ((ratio->lhs->etype == n_op) &&
 		  ((n_opexp *)ratio->lhs)->op->opty == multe)
 		temp4 =(n_opexp *) ratio->lhs;
@@ -120,34 +120,35 @@ bool distfrac(expr * & ex)
 		}
 	      // lden is a list of factors to NOT add when adding each factor
 	      // of lcd to temp4
-	      vector<expr *> *lden;
+	      n_opexp *ldennop;
 	      if ((ratio->rhs->etype != n_op)  ||
 		  ((n_opexp *) ratio->rhs)->op->opty != multe)
 		{
-		  lden = new vector<expr *>;
-		  lden->push_back(ratio->rhs);
+		  ldennop = new n_opexp(&mult);
+		  ldennop->args.push_back(ratio->rhs);
 		}			  
-	      else lden = ((n_opexp *)ratio->rhs)->args;
+	      else ldennop = (n_opexp *)ratio->rhs;
+	      exprlist *lden = &ldennop->args;
 	      int r;
-	      for (q=0; q < lcd->args->size(); q++)
+	      for (q=0; q < lcd->args.size(); q++)
 		{
 		  for (r=0; r < lden->size(); r++)
-		    if (equaleqs((*lden)[r],(*lcd->args)[q])) break;
+		    if (equaleqs((*lden)[r],lcd->args[q])) break;
 		  if (r == lden->size()) 	// add this one, not in lden
-		    temp4->addarg(copyexpr((*lcd->args)[q]));
+		    temp4->addarg(copyexpr(lcd->args[q]));
 		}
 	      DBGM(cout << "distfrac " << thisdbg << ": temp4 of term "
 		  << k << " is " << temp4->getInfix() << endl;);
 	      // above doesn't do multiple identical factors right
 	      for (r=0; r < lden->size(); r++) (*lden)[r]->destroy();
-	      delete lden;
+	      delete ldennop;
 	      DBGM(cout << "again after deleting lden, temp4 is "
 		  << temp4->getInfix() << endl;);
-	      if (temp4->args->size() != 1) // can't be 0, right?
+	      if (temp4->args.size() != 1) // can't be 0, right?
 		plsnumer->addarg(temp4);
 	      else 
 		{
-		  plsnumer->addarg((*temp4->args)[0]);
+		  plsnumer->addarg(temp4->args[0]);
 		  // rmed 2/4/01 need to check	  delete temp4->args;
 		  delete temp4;
 		}
@@ -163,17 +164,15 @@ bool distfrac(expr * & ex)
       // change the expression
 
       ex = new binopexp(&divby, plsnumer, lcd);
-      if (lcd->args->size() == 1) // we are in a loop that knows lcdsize > 0
+      if (lcd->args.size() == 1) // we are in a loop that knows lcdsize > 0
 	{
-	  ((binopexp *)ex)->rhs = (*lcd->args)[0];
-	  delete lcd->args;
+	  ((binopexp *)ex)->rhs = lcd->args[0];
 	  delete lcd;
 	}
       DBG(cout << "distfrac " << thisdbg << " returns true with " 
 	   << ex->getInfix() << endl);
       return(true);
     }
-  delete lcd->args;
   delete lcd;
   DBG(cout << "distfrac " << thisdbg 
        << ": did nothing, returns false " << ex->getInfix() << endl);
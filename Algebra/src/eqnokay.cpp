@@ -29,6 +29,7 @@
 #include "indysgg.h"
 #include "extoper.h"
 #include "valander.h"
+#include "nodearena.h"
 
 using namespace std;
 
@@ -63,8 +64,6 @@ static const double ANSERR = 0.0025;
 //   SINGULAR is never returned
 
 // in extstruct: canonvars, canoneqf, studeqf
-extern vector<valander *> studgrads;
-extern bool gotthevars;					// in indysgg.cpp
 binopexp * getAnEqn(const string bufst, bool tight);	// in getaneqwu.cpp
 bool getStudEqn(int slot, const string bufst);		// in getaneqwu.cpp
 int checksol(const binopexp* const eqn, 		// in checksol.cpp
@@ -85,35 +84,44 @@ int indyIsStudEqnOkay(const char * const equation) {
     throw(string("indyIsStudEqnOkay called before indyDoneAddVar"));
   }
   int retval = OKAY;
+  scratchNodes scratch;		// for the equations parsed here
   // check that all can be parsed --- should always be the case
   // otherwise implies bug in caller
   binopexp * theeqn =  getAnEqn(equation,true);
   // currently getAnEqn throws exceptions rather than returning NULL, 
   // so never returns UNPARSEABLE
-  if (theeqn->op->opty != equalse) { return(NOTANEQ); }
-  expr* eqexpr = (expr*)theeqn;
-  expr * trouble = dimenchk(true,eqexpr);
-  if (trouble != (expr *) 0L) {
-    DBG(cout << "dimensional inconsistency at " << trouble->getInfix() 
-             << endl;);
-    retval += UNITSNG;
-  }
-  if (checksol((binopexp*)eqexpr, numsols, ANSERR) > 0) retval += NOTANSOK;
-  if (checksol((binopexp*)eqexpr, numsols, RELERR) > 1) retval += IMPREC;
-  if (checksol((binopexp*)eqexpr, numsols, 100 * RELERR) > 1) retval += VERYNG;
-
-  if (retval >= UNITSNG)	// see if more lax units parsing would help
-    {
-      theeqn->destroy();
-      theeqn =  getAnEqn(equation,false);
-      eqexpr = (expr*)theeqn;
-      trouble = dimenchk(true,eqexpr);
-      if (trouble != (expr *) 0L) {
-	DBG(cout << "bad dimensional inconsistency at " << trouble->getInfix() 
-             << endl;);
-	retval += UNITSNG;
-      }
+  if (theeqn->op->opty != equalse) { theeqn->destroy(); return(NOTANEQ); }
+  try {
+    expr* eqexpr = (expr*)theeqn;
+    expr * trouble = dimenchk(true,eqexpr);
+    if (trouble != (expr *) 0L) {
+      DBG(cout << "dimensional inconsistency at " << trouble->getInfix() 
+	       << endl;);
+      retval += UNITSNG;
     }
+    if (checksol((binopexp*)eqexpr, numsols, ANSERR) > 0) retval += NOTANSOK;
+    if (checksol((binopexp*)eqexpr, numsols, RELERR) > 1) retval += IMPREC;
+    if (checksol((binopexp*)eqexpr, numsols, 100 * RELERR) > 1) 
+      retval += VERYNG;
+
+    if (retval >= UNITSNG)	// see if more lax units parsing would help
+      {
+	theeqn->destroy();
+	theeqn = 0L;
+	theeqn =  getAnEqn(equation,false);
+	eqexpr = (expr*)theeqn;
+	trouble = dimenchk(true,eqexpr);
+	if (trouble != (expr *) 0L) {
+	  DBG(cout << "bad dimensional inconsistency at " 
+	      << trouble->getInfix() << endl;);
+	  retval += UNITSNG;
+	}
+      }
+  } catch (...) {
+    // so that the scratch chunks can all be taken back
+    if (theeqn) theeqn->destroy();
+    throw;
+  }
   theeqn->destroy();
   DBG(cout << "Returning " << retval << " from indyIsStudEqnOkay" << endl;);
   return(retval);
@@ -164,6 +172,7 @@ int indyAddStudEq(int slot, const char* const equation) {
 
   // check that all can be parsed --- should always be the case
   // otherwise implies bug in caller
+  problemNodes keep;		// studeqf[slot] stays with the problem
   if (! getStudEqn(slot, equation)) {
     DBG(cout << "indyAddStudEq returning NOPARSE" << endl;);
     return(NOPARSE); // throw(string("Couldn't parse ") + string(equation));
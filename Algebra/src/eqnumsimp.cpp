@@ -299,13 +299,13 @@ void eqnumsimp(expr * & e, const bool flok)		// shown as comments
       double sumabs;
       numvalexp *numkexp;
    
-      for (int k =0; k<th->args->size(); k++)
+      for (int k =0; k<th->args.size(); k++)
 	{
-	  eqnumsimp((*th->args)[k],flok);	   // answer = ... || answer
-	  if (!((*th->args)[k]->etype==numval)) allnum = false;
+	  eqnumsimp(th->args[k],flok);	   // answer = ... || answer
+	  if (!(th->args[k]->etype==numval)) allnum = false;
 	  else  // th->args[k] is a numval
 	    {
-	      numvalexp * tharg =  (numvalexp *) (*th->args)[k];
+	      numvalexp * tharg =  (numvalexp *) th->args[k];
 	      if (numk < 0) // first numval: remember it
 		{ 
 		  numk = k; 
@@ -339,17 +339,17 @@ void eqnumsimp(expr * & e, const bool flok)		// shown as comments
 				   "Eqnumsimp: Can't add terms with different units"));
 		  }
 	        else throw (string("unknown n-ary with known arg"));
-		(*th->args)[k]->destroy();
-		for (int q=k+1;q< th->args->size(); q++)
-		  (*th->args)[q-1] = (*th->args)[q];
-		th->args->pop_back();			// answer = true
+		th->args[k]->destroy();
+		for (int q=k+1;q< th->args.size(); q++)
+		  th->args[q-1] = th->args[q];
+		th->args.pop_back();			// answer = true
 		k--;
 	      } // end of numk >= 0
 	    } // end of th->args[k] a numval
 	} // end of loop over k
       if (numk >= 0)
 	{
-	  (*th->args)[numk] = numkexp; // AW: needed? numkexp points to args[numk] expr above  
+	  th->args[numk] = numkexp; // AW: needed? numkexp points to args[numk] expr above  
 	  if ((th->op->opty == pluse)  &&
 	      (fabs(numkexp->value) < sumabs * RELERR))
 	    {
@@ -364,8 +364,8 @@ void eqnumsimp(expr * & e, const bool flok)		// shown as comments
 #if AW_EXP // experimental fix
 		  // AW fix (Exkt13a bug): give 0 same units as product, not unknown
 		  e->MKS.put(0,0,0,0,0);
-		  for (int q=0; q<th->args->size(); q++) {
-			e->MKS += (*th->args)[q]->MKS;
+		  for (int q=0; q<th->args.size(); q++) {
+			e->MKS += th->args[q]->MKS;
 		  }
 #endif
 		  th->destroy();
@@ -375,34 +375,33 @@ void eqnumsimp(expr * & e, const bool flok)		// shown as comments
 		}
 	      else if (th->op->opty == pluse)
 		{
-		  (*th->args)[numk]->destroy();
-		  for (int q=numk+1;q< th->args->size(); q++)
-		    (*th->args)[q-1] = (*th->args)[q];
-		  th->args->pop_back();			// answer = true;
+		  th->args[numk]->destroy();
+		  for (int q=numk+1;q< th->args.size(); q++)
+		    th->args[q-1] = th->args[q];
+		  th->args.pop_back();			// answer = true;
 		}
 	      else throw(string("unknown n_op in eqnumsimp"));
 	    }
 	  else if ((numkexp->value == 1.) && (th->op->opty == multe)
 		   && numkexp->MKS.zerop())
 	    {
-	      (*th->args)[numk]->destroy();
-	      for (int q=numk+1;q < th->args->size(); q++)
-		(*th->args)[q-1] = (*th->args)[q];
-	      th->args->pop_back();			// answer = true;
+	      th->args[numk]->destroy();
+	      for (int q=numk+1;q < th->args.size(); q++)
+		th->args[q-1] = th->args[q];
+	      th->args.pop_back();			// answer = true;
 	    }
 	  EQDEEP( cout << "Eqnumsimp did find numval " << endl; );
 	} // end of if (numk >= 0)
-      if (th->args->size() == 1)
+      if (th->args.size() == 1)
 	{
-	  e = (*th->args)[0];
-	  th->args->pop_back();
-	  delete th->args;
+	  e = th->args[0];
+	  th->args.pop_back();
 	  delete th;
 	  DBG( cout << "eqnumsimp " << thisdbg << " returning " 
 	       << e->getInfix() << endl);
 	  return;					// (true)
 	}
-      if (th->args->size() == 0)
+      if (th->args.size() == 0)
 	{
 	  EQDEEP( cout << "Eqnumsimp in n_op no args " << endl; );
 #ifndef AW_EXP // original code
@@ -418,7 +417,6 @@ void eqnumsimp(expr * & e, const bool flok)		// shown as comments
 	    e = new numvalexp(1);
 	    e->MKS.put(0,0,0,0,0);
 	  }
-	  delete th->args;
 	  delete th;
 	  DBG( cout << "eqnumsimp " << thisdbg << " returning " 
 	       << e->getInfix() << endl);
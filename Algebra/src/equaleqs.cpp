@@ -76,13 +76,13 @@ bool equaleqs(const expr * exp1, const expr * exp2)
 	   << exp1->getInfix() << endl << exp2->getInfix() << endl; );
       if (exp2->etype != n_op) goto retno;
       DBG( cout << "Equaleqs exp2 is n_op " << endl;  );
-      if ( ((n_opexp *)exp1)->args->size() !=
-	   ((n_opexp *)exp2)->args->size() ) goto retno;
+      if ( ((n_opexp *)exp1)->args.size() !=
+	   ((n_opexp *)exp2)->args.size() ) goto retno;
       DBG( cout << "Equaleqs 1 & 2 have same size " << endl;  );
-      for (k=0; k < ((n_opexp *)exp1)->args->size(); k++) 
+      for (k=0; k < ((n_opexp *)exp1)->args.size(); k++) 
 	{
-	  if (!equaleqs( (*((n_opexp *)exp1)->args)[k],
-			 (*((n_opexp *)exp2)->args)[k])) goto retno;
+	  if (!equaleqs( ((n_opexp *)exp1)->args[k],
+			 ((n_opexp *)exp2)->args[k])) goto retno;
 	  DBG( cout << "Args " << k << " agreed." << endl; );
 	}
       answer = true;
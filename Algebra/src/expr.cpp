@@ -20,6 +20,7 @@
 #include <string>
 #include "decl.h"
 #include "unitabr.h"
+#include "solvercontext.h"
 #include <stdio.h>
 #include <math.h>
 using namespace std;
@@ -27,7 +28,6 @@ using namespace std;
 
 #define DBG(A) DBGF(EXPRDB,A)
 
-extern vector<physvar *> * canonvars;
 
 string itostr(int);					// in utils.cpp
 
@@ -135,8 +135,6 @@ functexp::functexp(oper *f,expr * arg) :
 n_opexp::n_opexp(oper *op) : op(op) 
 { 
   etype=n_op;
-  args = new vector<expr *>;
-  // cout << "n_opexp create " << args << endl;
   if (op->opty == multe) { 
     MKS.put(0,0,0,0,0);   // to be activated after addarg replaces arg->push
     return; }
@@ -144,6 +142,15 @@ n_opexp::n_opexp(oper *op) : op(op)
   throw(string("n_op created with illegal type") + itostr(op->opty));
 }
 
+void exprlist::grow()
+{
+  expr ** more = new expr *[2 * room];
+  memcpy(more, data, count * sizeof(expr *));
+  if (data != local) delete [] data;
+  data = more;
+  room *= 2;
+}
+
 /************************************************************************
  *  addarg to a n_op expr.  In addition to pushing the arg on the 	*
  *	this->args list, it does the following units fixing:		*
@@ -156,7 +163,7 @@ n_opexp::n_opexp(oper *op) : op(op)
  ************************************************************************/
 void n_opexp::addarg(expr * arg)
 {
-  args->push_back(arg);
+  args.push_back(arg);
   if (op->opty == multe)
     {
       MKS += arg->MKS;
@@ -30,7 +30,10 @@ using namespace std;
 
 #include "dimens.h"
 
-enum exprtype { unknown, numval, physvart, binop, n_op, function, fake };
+// one byte, so that with known and MKS it fits beside the vtable pointer
+// in the first 16 bytes of every node
+enum exprtype : unsigned char
+  { unknown, numval, physvart, binop, n_op, function, fake };
 
 // enum vartype { unspecified, force, mass, etc }  now only for physvars
 
@@ -50,6 +53,9 @@ class expr			/* intended to be abstract, inherited by */
   // destructors for the derived classes should eventually replace the
   // destroy function.
   virtual ~expr() = 0;
+  // nodes are kept by the current context, see nodearena.h
+  static void * operator new(size_t size);
+  static void operator delete(void * node, size_t size);
   // functions:
   bool isknown();
   void setknown();
@@ -217,12 +223,40 @@ class functexp	:	public expr
   string getLisp(bool) const;
 };
 
+/************************************************************************
+ * exprlist  the args of an n_opexp. Used like the vector<expr *> it	*
+ *	replaced, but the first few args are kept in the node itself,	*
+ *	so most sums and products need nothing more from the heap.	*
+ ************************************************************************/
+class exprlist
+{
+ public:
+  exprlist() : data(local), count(0), room(inlineArgs) { }
+  ~exprlist() { if (data != local) delete [] data; }
+  size_t size() const { return(count); }
+  bool empty() const { return(count == 0); }
+  expr * & operator[](size_t k) { return(data[k]); }
+  expr * const & operator[](size_t k) const { return(data[k]); }
+  expr * & back() { return(data[count - 1]); }
+  void push_back(expr * arg) { if (count == room) grow(); data[count++] = arg; }
+  void pop_back() { count--; }
+  void clear() { count = 0; }
+ private:
+  static const unsigned int inlineArgs = 4;
+  exprlist(const exprlist &);			// not copyable
+  exprlist & operator=(const exprlist &);
+  void grow();
+  expr ** data;			// local, or from the heap once it grows
+  unsigned int count, room;
+  expr * local[inlineArgs];
+};
+
 class n_opexp	:	public expr
 {
  public:
   oper *op;
-  vector<expr *> *args;
-  n_opexp() { etype=n_op; args = new vector<expr *>; }
+  exprlist args;
+  n_opexp() { etype=n_op; }
   n_opexp(oper *op);
   void addarg(expr *arg);
   string getInfix() const;
@@ -0,0 +1,66 @@
+//  exprhash.cpp	a hash of the structure of an expression
+//	unsigned long exprhash(const expr * ex)
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+/************************************************************************
+ *	exprhash   a number that is the same for any two expressions	*
+ *		equaleqs finds equal, so expressions with different	*
+ *		hashes need not be compared.				*
+ *	It follows equaleqs exactly: the value of a numval is left out,	*
+ *		since values within RELERR of each other are equal, and	*
+ *		so is the op of a binop or n_op, which equaleqs doesn't	*
+ *		compare either.						*
+ ************************************************************************/
+#include "decl.h"
+#include "extoper.h"
+using namespace std;
+
+// mixes a value into the hash h
+static inline unsigned long mix(unsigned long h, unsigned long value)
+{
+  return((h ^ value) * 0x100000001b3UL + (h >> 29));
+}
+
+unsigned long exprhash(const expr * ex)
+{
+  unsigned long h = mix(0xcbf29ce484222325UL, ex->etype);
+  size_t k;
+
+  switch(ex->etype)
+    {
+    case numval:
+      return(mix(h, ex->MKS.hash()));
+    case physvart:
+      return(mix(h, ((physvarptr *)ex)->varindex));
+    case function:
+      h = mix(h, ((functexp *)ex)->f->opty);
+      return(mix(h, exprhash(((functexp *)ex)->arg)));
+    case binop:
+      h = mix(h, exprhash(((binopexp *)ex)->lhs));
+      return(mix(h, exprhash(((binopexp *)ex)->rhs)));
+    case n_op:
+      h = mix(h, ((n_opexp *)ex)->args.size());
+      for (k = 0; k < ((n_opexp *)ex)->args.size(); k++)
+	h = mix(h, exprhash(((n_opexp *)ex)->args[k]));
+      return(h);
+    case unknown:
+    case fake:
+    default:
+      throw(string("exprhash called with invalid expression"));
+    }
+}
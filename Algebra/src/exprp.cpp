@@ -20,6 +20,7 @@
 #include <string>
 #include "decl.h"
 #include "unitabr.h"
+#include "solvercontext.h"
 #include <stdio.h>
 #include <math.h>
 using namespace std;
@@ -27,9 +28,7 @@ using namespace std;
 
 #define DBG(A) DBGF(EXPRDB,A)
 
-extern vector<physvar *> * canonvars;
-extern unitabrs unittable;
-extern vector<double> *numsols;
+extern const unitabrs unittable;
 
 numvalexp * getfromunits(const string & unitstr);
 
@@ -41,9 +40,9 @@ string ustrp(double dpow)
   if (lookslikeint(dpow,q))
     {
       if (q==1) return (string(""));
-      else sprintf(buf,"^%d",q);
+      else snprintf(buf,sizeof(buf),"^%d",q);
     }
-  else sprintf(buf,"^%.1lf",dpow); 
+  else snprintf(buf,sizeof(buf),"^%.1lf",dpow); 
   return(string(buf));
 }
 
@@ -125,11 +124,11 @@ string numvalexp::getInfix() const {
   DBG( cout << "getInfix on numval" << endl);
   // don't truncate nonzero numbers near zero
   if ((value==0. || fabs(value)>0.5) && lookslikeint(value,q))
-    sprintf(valuenum,"%d",q);
+    snprintf(valuenum,sizeof(valuenum),"%d",q);
   else if ((fabs(value) < 1.) && (fabs(value)> 0.001))
-    sprintf(valuenum,"%.17lf",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lf",value);
   else
-    sprintf(valuenum,"%.17lG",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lG",value);
 #ifdef UNITENABLE  
   string unitstr = unitprint(MKS);
   if (unitstr.size() == 0)   return(string(valuenum));
@@ -201,11 +200,11 @@ string binopexp::solprint(bool forhelp) const {
   char valuenum[30];
   // don't truncate nonzero numbers near zero
   if ((value==0. || fabs(value)>0.5) && lookslikeint(value,q)) 
-    sprintf(valuenum,"%d",q);
+    snprintf(valuenum,sizeof(valuenum),"%d",q);
   else if ((fabs(value) < 1.) && (fabs(value)> 0.001))
-    sprintf(valuenum,"%.17lf",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lf",value);
   else
-    sprintf(valuenum,"%.17lG",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lG",value);
   if (forhelp)
   return(string("(= |") 
 	 + (*canonvars)[varidx]->clipsname
@@ -235,13 +234,13 @@ string n_opexp::getInfix() const {
   string ans = "( ";
 
   DBG(cout << "getInfix on n_op" << endl);
-  if (this->args->size() == 0) {
+  if (this->args.size() == 0) {
     ans.append( op->printname + ")");
     return ans;
   }
-  for (k = 0; k+1 < this->args->size(); k++)
-    ans.append((*(this->args))[k]->getInfix() + " " + op->printname + " ");
-  ans.append((*(this->args))[k]->getInfix() + ")");
+  for (k = 0; k+1 < this->args.size(); k++)
+    ans.append((this->args)[k]->getInfix() + " " + op->printname + " ");
+  ans.append((this->args)[k]->getInfix() + ")");
 
   return ans;	 
 }
@@ -260,8 +259,8 @@ void numvalexp::pretty(int indent)
   char valuenum[17];
   // don't truncate nonzero numbers near zero
   if ((value==0. || fabs(value)>0.5) && lookslikeint(value,q))
-    sprintf(valuenum,"%d",q);
-  else sprintf(valuenum," %14.8lf ",value);
+    snprintf(valuenum,sizeof(valuenum),"%d",q);
+  else snprintf(valuenum,sizeof(valuenum)," %14.8lf ",value);
   cout << string(indent,' ') + valuenum << endl;
 }
 
@@ -292,8 +291,8 @@ void n_opexp::pretty(int indent)
 {
   int k;
   cout << string(indent,' ') + op->printname << endl;
-  for (k=0;k<this->args->size();k++)
-    (*(this->args))[k]->pretty(indent+2);
+  for (k=0;k<this->args.size();k++)
+    (this->args)[k]->pretty(indent+2);
 }
 
 /************************************************************************
@@ -309,8 +308,8 @@ void numvalexp::dbgprint(int indent)
   char valuenum[17];
   // don't truncate nonzero numbers near zero
   if ((value==0. || fabs(value)>0.5) && lookslikeint(value,q))
-    sprintf(valuenum,"%d",q);
-  else sprintf(valuenum," %14.8lf ",value);
+    snprintf(valuenum,sizeof(valuenum),"%d",q);
+  else snprintf(valuenum,sizeof(valuenum)," %14.8lf ",value);
   cout << string(indent,' ') + "numval:  " + valuenum + "\t" + 
     MKS.print() << endl;
 }
@@ -347,8 +346,8 @@ void n_opexp::dbgprint(int indent)
   int k;
   cout << string(indent,' ')  + "n_op:   " + op->printname 
     + "\t" + MKS.print()<< endl;
-  for (k=0;k<this->args->size();k++)
-    (*(this->args))[k]->dbgprint(indent+2);
+  for (k=0;k<this->args.size();k++)
+    (this->args)[k]->dbgprint(indent+2);
 }
 
 /************************************************************************
@@ -365,11 +364,11 @@ string numvalexp::getLisp(bool withbarp) const {
   char valuenum[30];
   // don't truncate nonzero numbers near zero
   if ((value==0. || fabs(value)>0.5) && lookslikeint(value,q))
-    sprintf(valuenum,"%d",q);
+    snprintf(valuenum,sizeof(valuenum),"%d",q);
   else if ((fabs(value) < 1.) && (fabs(value)> 0.001))
-    sprintf(valuenum,"%.17lf",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lf",value);
   else
-    sprintf(valuenum,"%.17lG",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lG",value);
 #ifdef UNITENABLE  
   string unitstr = unitprint(MKS);
   if (unitstr.size() == 0)   return(string("( ") +valuenum + " )");
@@ -414,8 +413,8 @@ string n_opexp::getLisp(bool withbarp) const {
   int k;
   string ans = "(";
 ans.append( op->printname + " ");
-  for (k = 0; k+1 < this->args->size(); k++)
-    ans.append((*(this->args))[k]->getLisp(withbarp) + " ");
-  ans.append((*(this->args))[k]->getLisp(withbarp) + ")");
+  for (k = 0; k+1 < this->args.size(); k++)
+    ans.append((this->args)[k]->getLisp(withbarp) + " ");
+  ans.append((this->args)[k]->getLisp(withbarp) + ")");
   return ans;
 }
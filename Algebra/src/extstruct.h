@@ -50,37 +50,20 @@ const int HELPEQSZ = 70;	/* number of slots including implicit eqs */
 #define RELERR (100*DBL_EPSILON)
 
 //////////////////////////////////////////////////////////////////////////////
-// globals defined here
-// in the vectors below, indices of *:* match, and indices of &^& match
+// The state of the problem (canonvars, canoneqf, studeqf, numsols, ...)
+// belongs to the current SolverContext, see solvercontext.h
 //////////////////////////////////////////////////////////////////////////////
-// list of the canonical variables					&^&
-LZ_EXTERN_SPEC std::vector<physvar*>* canonvars LZ_INIT_PTR_SPEC;
-// list of the student defined variables				*:*
-LZ_EXTERN_SPEC std::vector<string*> studvars; 
-// list of expressions in canonical variables
-// equal to the corresponding student var				*:*
-LZ_EXTERN_SPEC std::vector<expr*> studvarvals;
-// the canonical var corres. to the studvar				*:*
-LZ_EXTERN_SPEC std::vector<physvar*> studvarcanon;
-// list of the canonical equations
-LZ_EXTERN_SPEC std::vector<binopexp*>*	canoneqf INITDO(= 0L);
-// list of parameter artificial assignments
-LZ_EXTERN_SPEC std::vector<binopexp*>*	paramasgn INITDO(= 0L);
-// list of the student equations, by slot, 
-// as function(canonical vars) = 0
-LZ_EXTERN_SPEC std::vector<binopexp*> studeqf INITDO((HELPEQSZ,0L));
-// list of the student equations, by slot, orig 
-LZ_EXTERN_SPEC std::vector<string*> studeqsorig INITDO((HELPEQSZ,0L));
-// solution eqn of the canonical vars (expr)	       			&^&
-LZ_EXTERN_SPEC std::vector<binopexp*>* solsexpr LZ_INIT_PTR_SPEC;
-// solution values of the canonical vars (dbls)				&^&
-LZ_EXTERN_SPEC std::vector<double>* numsols LZ_INIT_PTR_SPEC; 
-LZ_EXTERN_SPEC int numpasses LZ_INIT_INT_SPEC;
+#include "solvercontext.h"
 
+//////////////////////////////////////////////////////////////////////////////
+// globals defined here, shared by all contexts
+// they are filled by constsfill before main and never changed after, so
+// any thread may read them without locking
+//////////////////////////////////////////////////////////////////////////////
 #ifdef UNITENABLE
-LZ_EXTERN_SPEC std::vector<string> * constnames LZ_INIT_PTR_SPEC;
+LZ_EXTERN_SPEC const std::vector<string> * constnames LZ_INIT_PTR_SPEC;
 // names of named constants						&#&
-LZ_EXTERN_SPEC std::vector<numvalexp*>* constnumvals LZ_INIT_PTR_SPEC;
+LZ_EXTERN_SPEC const std::vector<numvalexp*>* constnumvals LZ_INIT_PTR_SPEC;
 // values of the named constants					&#&
 #endif
 
@@ -139,8 +139,8 @@ bool factorout(const expr * factor,int n, expr * & expression)
   	{
 	  DBG(cout << "FACTOUT " << thisdbg 
 	      << ": physvar on " << nopexpr->getInfix() << endl;);
-  	  for (k=0; k < nopexpr->args->size(); k++)
-  	    if (!factorout(factor, n,(*nopexpr->args)[k])) goto abort;
+  	  for (k=0; k < nopexpr->args.size(); k++)
+  	    if (!factorout(factor, n,nopexpr->args[k])) goto abort;
 	  goto fixup;
   	}
       if (nopexpr->op->opty == multe)
@@ -148,11 +148,11 @@ bool factorout(const expr * factor,int n, expr * & expression)
 	  DBG(cout << "FACTOUT " << thisdbg 
 	      << ": physvar on " << nopexpr->getInfix() << endl;);
 	  int qleft = n;
-	  for (k=0; k < nopexpr->args->size(); k++)
+	  for (k=0; k < nopexpr->args.size(); k++)
 	    {
-	      q = numfactorsof(factor, (*nopexpr->args)[k]);
+	      q = numfactorsof(factor, nopexpr->args[k]);
 	      if (q == 0) continue;
-	      if (!factorout(factor,min(q,qleft),(*nopexpr->args)[k]))
+	      if (!factorout(factor,min(q,qleft),nopexpr->args[k]))
 		goto abort;
 	      qleft = qleft - min(q,qleft);
 	      if (qleft == 0) goto fixup;
@@ -72,8 +72,8 @@ bool fixupforpls(binopexp * & bineq)
   if (bineq->lhs->etype != n_op) return(false);
   if ( ((n_opexp *)bineq->lhs)->op->opty == multe) 
     return ( (fixupterm(bineq->lhs)) ? true : false);
-  else for (k=0;k < ((n_opexp *)bineq->lhs)->args->size(); k++)
-    if (!fixupterm( (*(((n_opexp *)bineq->lhs)->args))[k] )) return(false);
+  else for (k=0;k < ((n_opexp *)bineq->lhs)->args.size(); k++)
+    if (!fixupterm( (((n_opexp *)bineq->lhs)->args)[k] )) return(false);
   return(true);
 }
 
@@ -104,22 +104,22 @@ bool fixupterm(expr * & ex)
 	if (nopex->op->opty != multe)
 	  throw(string("fixupterm doesn't expect non-mult n_ops"));
 	DBG( cout << "n_op is multe" << endl; );
-	if (nopex->args->size() > 2) return(false);
+	if (nopex->args.size() > 2) return(false);
 	DBG( cout << "n_op has fewer than 3 factors" << endl; );
-	for (int k=0; k < nopex->args->size(); k++) 
+	for (int k=0; k < nopex->args.size(); k++) 
 	  {
-	    if (((*nopex->args)[k]->etype != numval) &&
-		((*nopex->args)[k]->etype != physvart)) return(false);
+	    if ((nopex->args[k]->etype != numval) &&
+		(nopex->args[k]->etype != physvart)) return(false);
 	    DBG( cout << "factor " << k << " passed test" << endl; );
 	  }
 	DBG( cout << "factors individually checked out" << endl; );
-	if (nopex->args->size() < 2) return(true);
-	if  ((*nopex->args)[0]->etype == numval) return(true);
-        if  ((*nopex->args)[1]->etype == physvart) return(false);
+	if (nopex->args.size() < 2) return(true);
+	if  (nopex->args[0]->etype == numval) return(true);
+        if  (nopex->args[1]->etype == physvart) return(false);
 	DBG( cout << "fixupterm needs to swap factors" << endl; );
-	expr * temp = (*nopex->args)[1];
-	(*nopex->args)[1] = (*nopex->args)[0];
-	(*nopex->args)[0] = temp;
+	expr * temp = nopex->args[1];
+	nopex->args[1] = nopex->args[0];
+	nopex->args[0] = temp;
 	return(true);
       }
     case function:
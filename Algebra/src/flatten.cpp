@@ -105,7 +105,7 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 	       (((n_opexp *)efunct->arg)->op->opty == multe))
 	    {
 	      n_opexp * fargnop = (n_opexp *) efunct->arg;
-	      if (fargnop->args->size() < 2) 
+	      if (fargnop->args.size() < 2) 
 		{
 		  // this can't happen if we guarantee all n_ops flatten
 		  // returns always have at least two args:
@@ -119,34 +119,34 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 		   // e->dbgprint(0)
 		   );
 	      n_opexp * rootdone = new n_opexp(&mult); // holds part of prod
-	      for (k = 0; k < fargnop->args->size(); k++) // extracted frm sqrt
-		if (isnonneg((*fargnop->args)[k]))
+	      for (k = 0; k < fargnop->args.size(); k++) // extracted frm sqrt
+		if (isnonneg(fargnop->args[k]))
 		  {
 		    tempexp = (expr *) new functexp(&sqrtff,
-						    (*fargnop->args)[k]);
-		    fargnop->MKS += ((*fargnop->args)[k])->MKS * -1.;//9/29/01
-		    e->MKS += ((*fargnop->args)[k])->MKS * -0.5;//9/29/01
+						    fargnop->args[k]);
+		    fargnop->MKS += (fargnop->args[k])->MKS * -1.;//9/29/01
+		    e->MKS += (fargnop->args[k])->MKS * -0.5;//9/29/01
 		    flatten(tempexp);
 		    rootdone->addarg(tempexp);
-		    for (q = k; q+1 < fargnop->args->size(); q++)
-		      (*fargnop->args)[q] = (*fargnop->args)[q+1];
-		    fargnop->args->pop_back();
+		    for (q = k; q+1 < fargnop->args.size(); q++)
+		      fargnop->args[q] = fargnop->args[q+1];
+		    fargnop->args.pop_back();
 		    k--;
 		  }
-	      if (fargnop->args->size() == 1) 
+	      if (fargnop->args.size() == 1) 
 		{
 		  unnop(efunct->arg);
 		  eqnumsimp(e,true);
 		  answer = true;
 		}
-	      else if (fargnop->args->size() == 0) 
+	      else if (fargnop->args.size() == 0) 
 		{
 		  e->destroy(); e = rootdone; 
 		  DBG(cout << "flatten " << thisdbg  << ":  returns " 
 		      << e->getInfix()<< endl);
 		  return(true); 
 		}
-	      if (rootdone->args->size() == 0)
+	      if (rootdone->args.size() == 0)
 		{
 		  delete rootdone;
 		  DBG({cout << "flatten " << thisdbg 
@@ -228,20 +228,20 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 	    {
 	      n_opexp * enop = new n_opexp(&mult);
 	      n_opexp * argnop = (n_opexp *) efunct->arg;
-	      for (k=0; k < argnop->args->size(); k++)
+	      for (k=0; k < argnop->args.size(); k++)
 		{
-		  if ((*argnop->args)[k]->etype == numval)
+		  if (argnop->args[k]->etype == numval)
 		    {
-		      ((numvalexp *)((*argnop->args)[k]))->value =
-			fabs( ((numvalexp *)((*argnop->args)[k]))->value );
-		      enop->addarg((*argnop->args)[k]);
+		      ((numvalexp *)(argnop->args[k]))->value =
+			fabs( ((numvalexp *)(argnop->args[k]))->value );
+		      enop->addarg(argnop->args[k]);
 		      continue;
 		    }
-		  if (isnonneg((*argnop->args)[k]))
-		    enop->addarg((*argnop->args)[k]);
+		  if (isnonneg(argnop->args[k]))
+		    enop->addarg(argnop->args[k]);
 		  else
 		    enop->addarg(new functexp
-					  (&absff,(*argnop->args)[k]));
+					  (&absff,argnop->args[k]));
 		}
 	      // rmed 2/4/01 need to check	      delete argnop->args;
 	      delete argnop;
@@ -481,16 +481,16 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 		  if (!lookslikeint(((numvalexp *)ebin->rhs)->value,q)
 		      || (q != 2))  break;
 		  n_opexp * temp = new n_opexp(&myplus);
-		  for (k=0; k < elhs->args->size(); k++)
+		  for (k=0; k < elhs->args.size(); k++)
 		    {
 		      temp->addarg(new binopexp(&topow,
-			   copyexpr((*elhs->args)[k]), copyexpr(ebin->rhs) ));
-		      for (q=k+1; q < elhs->args->size(); q++)
+			   copyexpr(elhs->args[k]), copyexpr(ebin->rhs) ));
+		      for (q=k+1; q < elhs->args.size(); q++)
 			{
 			  n_opexp * temp2 = new n_opexp(&mult);
 			  temp2->addarg(copyexpr(ebin->rhs) ); // just a 2
-			  temp2->addarg(copyexpr((*elhs->args)[k]));
-			  temp2->addarg(copyexpr((*elhs->args)[q]));
+			  temp2->addarg(copyexpr(elhs->args[k]));
+			  temp2->addarg(copyexpr(elhs->args[q]));
 			  temp->addarg(temp2);
 			}
 		    }
@@ -513,8 +513,8 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 		      return(answer);
 		    }
 		  // can't handle dimensioned quantity to unknown power
-		  for (k=0; k < elhs->args->size(); k++)
-		      (*elhs->args)[k] = new binopexp(&topow,(*elhs->args)[k],
+		  for (k=0; k < elhs->args.size(); k++)
+		      elhs->args[k] = new binopexp(&topow,elhs->args[k],
 					     copyexpr(ebin->rhs));
 		  if (!elhs->MKS.zerop())
 		    elhs->MKS *= ((numvalexp *)ebin->rhs)->value;
@@ -540,12 +540,12 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
   if (e->etype == n_op)				// top level is n_op
     {
       n_opexp *enop = ( n_opexp *) e;	      // flatten each of the args
-      for (k=0; k < enop->args->size(); k++) {
-	if (flatten((* enop->args)[k])) answer = true;
+      for (k=0; k < enop->args.size(); k++) {
+	if (flatten( enop->args[k])) answer = true;
       }
       //  if just one arg on call, return non - n_op
       //    shouldn't this be delayed, or do we always repeat flatten if true?
-      if (enop->args->size() <= 1)
+      if (enop->args.size() <= 1)
 	{
 	  unnop(e);
 	  DBG(cout << "flatten " << thisdbg  << ":  returns " 
@@ -555,12 +555,12 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 
       // check for nested like n_ops and combine numvals. This had be
 				// explicit here, but now uses cleanup
-      k = enop->args->size();	// note: cleanup does not keep track of whether
+      k = enop->args.size();	// note: cleanup does not keep track of whether
       cleanup(enop);		// changes have been made. So flatten may 
-      if (k != enop->args->size()) answer = true;  // report false negative.
+      if (k != enop->args.size()) answer = true;  // report false negative.
       DBG(cout << "after check in flatten " << thisdbg << ", enop is " 
 	   << enop->getInfix() << endl);
-      if (enop->args->size() < 2)
+      if (enop->args.size() < 2)
 	{ unnop(e); 
 	  DBG(cout << "flatten " << thisdbg  << ":  returns " 
 	      << e->getInfix()<< endl);
@@ -593,39 +593,39 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 	  {
 	    // First remove divides
 	    n_opexp * newdenom = new n_opexp(&mult);
-	    for (k=0; k < enop->args->size(); k++)
+	    for (k=0; k < enop->args.size(); k++)
 	      {
-		if (((*enop->args)[k]->etype == binop)  &&
-		    (((binopexp *)(*enop->args)[k])->op->opty == divbye))
+		if ((enop->args[k]->etype == binop)  &&
+		    (((binopexp *)enop->args[k])->op->opty == divbye))
 		  {
-		    binopexp * tempbin = (binopexp *)(*enop->args)[k];
+		    binopexp * tempbin = (binopexp *)enop->args[k];
 		    newdenom->addarg(tempbin->rhs);
-		    (*enop->args)[k]=tempbin->lhs;
+		    enop->args[k]=tempbin->lhs;
 		    enop->MKS += tempbin->rhs->MKS; // added 6/7
 		    answer = true;
 		    delete tempbin;
 		  }
 	      }
 
-	    for (k=0; k < enop->args->size(); k++)
-	      for (q = 0; q < newdenom->args->size(); q++)
-		if (equaleqs((*enop->args)[k],(*newdenom->args)[q]))
+	    for (k=0; k < enop->args.size(); k++)
+	      for (q = 0; q < newdenom->args.size(); q++)
+		if (equaleqs(enop->args[k],newdenom->args[q]))
 		  {
 		    // cancel common terms.  First, adjust the units
-		    enop->MKS += (*enop->args)[k]->MKS * -1.;
-		    newdenom->MKS += (*newdenom->args)[q]->MKS * -1.;
-		    (*enop->args)[k]->destroy();
-		    (*newdenom->args)[q]->destroy();
-		    (*enop->args)[k] = (*enop->args)[enop->args->size()-1];
-		    (*newdenom->args)[q] 
-			  =(*newdenom->args)[newdenom->args->size()-1];
-		    enop->args->pop_back();
-		    newdenom->args->pop_back();
+		    enop->MKS += enop->args[k]->MKS * -1.;
+		    newdenom->MKS += newdenom->args[q]->MKS * -1.;
+		    enop->args[k]->destroy();
+		    newdenom->args[q]->destroy();
+		    enop->args[k] = enop->args[enop->args.size()-1];
+		    newdenom->args[q] 
+			  =newdenom->args[newdenom->args.size()-1];
+		    enop->args.pop_back();
+		    newdenom->args.pop_back();
 		    k--;  // since the term has changed, do over
 		    break;
 		  }
 
-	    if (newdenom->args->size() > 0) // need new if as may have shrunk
+	    if (newdenom->args.size() > 0) // need new if as may have shrunk
 	      {
 		e = new binopexp(&divby, enop, newdenom);
 		flatten(e);
@@ -646,21 +646,21 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 	    }
 	      // if no longer an n_op, won't get here.
 	      // Now try to distribute + args.
-	    for (k=0; k < enop->args->size(); k++)
+	    for (k=0; k < enop->args.size(); k++)
 	      {			
 		n_opexp *repla;
-		if (((*enop->args)[k]->etype == n_op)  &&
-		    (((n_opexp *)(*enop->args)[k])->op->opty == pluse))
+		if ((enop->args[k]->etype == n_op)  &&
+		    (((n_opexp *)enop->args[k])->op->opty == pluse))
 		  {
 		    repla = new n_opexp(&myplus);
-		    n_opexp * plusfact = (n_opexp *)(*enop->args)[k];
-		    for (q=0; q < plusfact->args->size(); q++)
+		    n_opexp * plusfact = (n_opexp *)enop->args[k];
+		    for (q=0; q < plusfact->args.size(); q++)
 		      {
 			temp = new n_opexp(&mult);
-			temp->addarg(copyexpr((*plusfact->args)[q]));
-			for (int r=0; r < enop->args->size(); r++)
+			temp->addarg(copyexpr(plusfact->args[q]));
+			for (int r=0; r < enop->args.size(); r++)
 			  if (r != k)
-			    temp->addarg(copyexpr((*enop->args)[r]));
+			    temp->addarg(copyexpr(enop->args[r]));
 			repla->addarg(temp);
 		      }
 		    bool flattened; // diag
@@ -694,12 +694,12 @@ bool flatten(expr * & e)	// flattens expr e wrt n_ops
 void unnop(expr * & e)
 {
   if ( (e->etype != n_op) ||
-       (((n_opexp *) e)->args->size() >1 ))
+       (((n_opexp *) e)->args.size() >1 ))
     throw(string("unnop should only be called on n_ops with < 2 args"));
   n_opexp * enop = (n_opexp *) e;
-  if (enop->args->size() == 1)
+  if (enop->args.size() == 1)
     {
-      e = (*enop->args)[0];
+      e = enop->args[0];
       delete enop;
       return;
     }
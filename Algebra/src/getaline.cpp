@@ -26,9 +26,9 @@
 #include <string>
 using namespace std;
 
-string getaline(istream& in) {
-	std::string str("");
-
+// reads a line into str, which keeps its room from one line to the next
+void getaline(istream& in, string& str) {
+	str.clear();
 	while (in) {
 		char c = in.get();
 		if (in) {
@@ -38,5 +38,10 @@ string getaline(istream& in) {
 			str += c;
 		}
 	}
+}
+
+string getaline(istream& in) {
+	std::string str("");
+	getaline(in, str);
 	return str;
 }
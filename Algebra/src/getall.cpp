@@ -76,6 +76,7 @@ bool getall(const string bufst)
 {
   double junkval;
   string leadbuf = bufst.substr(0,12);
+  if (bufst.substr(0,1) == "(") ownCanon();	// each form changes them
   if (bufst.substr(0,2) == "(=") { getCanonEqn(bufst); return(true); }
   if (startwith(bufst,"(variable"))
     {getavar(bufst); return(true); }
@@ -281,7 +282,6 @@ bool makepar(const string bufst, bool keep_algebraic)
   int kstrt, kend;
   double value;
   bool value_specified = false;
-  extern int numparams;
   if(keep_algebraic)
     taglength=13;
   else
@@ -22,12 +22,12 @@
 
 #include <fstream>
 #include <string>
+#include "solvercontext.h"
 using namespace std;
 
 bool getall(string bufst);
 string getaline(istream &instr);
 
-int numparams;
 bool getallfile(istream & infile )
 {
   string bufst;
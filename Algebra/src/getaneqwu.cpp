@@ -54,8 +54,8 @@
 
 #define DBG(A) DBGF(GETEQS,A)
 
-extern vector<string> * constnames;
-extern vector<numvalexp *> * constnumvals;
+extern const vector<string> * constnames;
+extern const vector<numvalexp *> * constnumvals;
 
 stack<string> *parseEqWUnits(const string & lispeq);    // in parseeqwunits
 numvalexp * parseunit(stack<string> *toklist);          // in parseunit
@@ -286,13 +286,16 @@ binopexp* getAnEqn(const string bufst, bool tight) {
 	  cout << endl);
       throw(string("variable ")+token+" not declared");
     }
-    (*canonvars)[k]->isused = true;
+    if (!(*canonvars)[k]->isused) {
+      ownCanon();
+      (*canonvars)[k]->isused = true;
+    }
     exprstack.push(new physvarptr(k));
   }
   delete toklist;
   if (exprstack.size() != 1) {
     char buf[6];
-    sprintf(buf,"%5ld",exprstack.size());
+    snprintf(buf,sizeof(buf),"%5ld",exprstack.size());
     
     string message(string("getAnEqn had ") + buf 
                    + string(" rather than 1 item at end\n"));
@@ -311,6 +314,7 @@ binopexp* getAnEqn(const string bufst, bool tight) {
 
 bool getCanonEqn(const string bufst) {
   binopexp * thiseq = getAnEqn(bufst,true);  // true=tight
+  ownCanon();
   canoneqf->push_back(thiseq);
   return(true);
 }
@@ -32,7 +32,7 @@ using namespace std;
 #include "unitabr.h"
 
 #define DBG(A) DBGF(GETEQS,A)
-extern unitabrs unittable;
+extern const unitabrs unittable;
 numvalexp * getfromunits(const string & unitstr);	// in unitabr.cpp
 
 /************************************************************************
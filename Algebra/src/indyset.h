@@ -31,6 +31,7 @@
 
 class indyset
 {
+  friend class checkpointer;	// in checkpoint.cpp
 private:
   vector<vector<double> > basis;   // basis vectors for gradients already in
 				// the set of independent equations.
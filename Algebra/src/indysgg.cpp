@@ -21,11 +21,13 @@
 
 #define BACKDOOR
 
+#define SOLVERCONTEXT_MEMBERS	// the state is reached through ctx
 #include "decl.h"
 #include "dbg.h"
 #include "extstruct.h"
 #include "indyset.h"
 #include <math.h>
+#include <sstream>
 #include "indysgg.h"
 
 using namespace std;
@@ -36,23 +38,11 @@ using namespace std;
 bool getCanonEqn(const string bufst);                    // in getaneqwu.cpp
 bool getStudEqn(int slot,const string bufst);            // in getaneqwu.cpp
 numvalexp * getfromunits(const string & unitstr);        // in unitabr.cpp
+void noteStatement(const char * const kind, const string & text); // in solutioncache.cpp
 
-//  Need global variables
-bool setupdone = false;        // set the first time indyEmpty is called, 
-                               // indicating one-time setup has been done
-bool gotthevars;               // set by indyDoneAddVar(), reset by indyEmpty
-extern int numparams;		// declared in getallfile
-// in extstruct: canonvars, canoneqf
+//  The state used here (setupdone, gotthevars, canongrads, studgrads,
+//  listofsets, ...) belongs to the current SolverContext
 
-vector<valander *> *canongrads;
-vector<valander *> studgrads(HELPEQSZ,0L);
-int numindysets;
-vector<indyset> *listofsets;
-int numvars;
-vector<vector<int> > * listsetrefs;
-vector<int> *lasttriedeq;
-
-void constsfill();
 
 //
 //#include <fstream>
@@ -89,82 +79,93 @@ void constsfill();
  *     after a first-time indyEmpty.					*
  ************************************************************************/
 void indyEmpty() {
+  SolverContext * ctx = solverContext();
   fLog("indyEmpty called,");
   int k;
-  gotthevars = false;
-  numparams = 0;
-  if (setupdone) {
+  ctx->gotthevars = false;
+  ctx->numparams = 0;
+  ctx->statements.clear();
+  if (ctx->setupdone) {
     DBG(cout << "IndyEmpty called again" << endl; );
-    for (k = ((int)canonvars->size()) - 1; k >= 0; k--) {
-      delete (*canonvars)[k];
-      canonvars->pop_back();
+    if (ctx->canonOwner) {
+      // shared with the other sessions of a library problem: they are
+      // left to the context that owns them
+      ctx->canonvars = new vector<physvar *>;
+      ctx->canoneqf = new vector<binopexp *>;
+      ctx->canongrads = new vector<valander *>;
+      ctx->canonOwner.reset();
+      DBG(cout << "IndyEmpty let go of shared canonvars, canoneqf and "
+	  << "canongrads" << endl; );
+    }
+    for (k = ((int)ctx->canonvars->size()) - 1; k >= 0; k--) {
+      delete (*ctx->canonvars)[k];
+      ctx->canonvars->pop_back();
     }
     DBG(cout << "IndyEmpty emptied canonvars" << endl; );
-    for (k = ((int)canoneqf->size()) - 1; k >= 0; k--) {
-      (*canoneqf)[k]->destroy();
-      canoneqf->pop_back();
+    for (k = ((int)ctx->canoneqf->size()) - 1; k >= 0; k--) {
+      (*ctx->canoneqf)[k]->destroy();
+      ctx->canoneqf->pop_back();
     }
     DBG(cout << "IndyEmpty emptied canoneqf" << endl);
-    if ((canongrads != 0L) && (canongrads != (vector<valander *> *)NULL)) {
-      for (k = ((int)canongrads->size()) - 1; k >= 0; k--) {
-        delete (*canongrads)[k];
-        canongrads->pop_back();
+    if ((ctx->canongrads != 0L) && (ctx->canongrads != (vector<valander *> *)NULL)) {
+      for (k = ((int)ctx->canongrads->size()) - 1; k >= 0; k--) {
+        delete (*ctx->canongrads)[k];
+        ctx->canongrads->pop_back();
       }
       DBG(cout << "IndyEmpty emptied canongrads" << endl; );
     }
-    for (k = ((int)paramasgn->size()) - 1; k >= 0; k--) {
-      (*paramasgn)[k]->destroy();
-      paramasgn->pop_back();
+    for (k = ((int)ctx->paramasgn->size()) - 1; k >= 0; k--) {
+      (*ctx->paramasgn)[k]->destroy();
+      ctx->paramasgn->pop_back();
     }
     for (k=0; k<HELPEQSZ; k++) {
-      if (studeqf[k]) {
-        studeqf[k]->destroy();
-        studeqf[k] = 0L;
-        studeqsorig[k]->erase();
-        if (studgrads[k]) {
-          delete studgrads[k];
-          studgrads[k] = 0L;
+      if (ctx->studeqf[k]) {
+        ctx->studeqf[k]->destroy();
+        ctx->studeqf[k] = 0L;
+        ctx->studeqsorig[k]->erase();
+        if (ctx->studgrads[k]) {
+          delete ctx->studgrads[k];
+          ctx->studgrads[k] = 0L;
         }
       }
     }
     DBG(cout << "IndyEmpty may have emptied studgrads and stueqsorig" <<endl;);
     // check for nonexistence of numsols added due to bad interaction
     // with solveClear = clearTheProblem, which deletes it
-    if (numsols) delete numsols;
+    if (ctx->numsols) delete ctx->numsols;
       //numsols->empty(); // this does not do what one thinks it does
-    numsols = new vector<double>;
+    ctx->numsols = new vector<double>;
     DBG(cout << "IndyEmpty made sure numsols is existent empty vector"<<endl;);
-    for (k = ((int)listofsets->size()) - 1; k >= 0; k--) {
+    for (k = ((int)ctx->listofsets->size()) - 1; k >= 0; k--) {
       indyKeepN(k,0);
       DBG( cout << "IndyEmpty emptied set " << k << endl; );
-      listofsets->pop_back();        // this ought to delete indyset k, right?
+      ctx->listofsets->pop_back();        // this ought to delete indyset k, right?
       DBG( cout << "IndyEmpty popped listofsets, now has " 
-                << listofsets->size() << endl; );
-      listsetrefs->pop_back(); 
+                << ctx->listofsets->size() << endl; );
+      ctx->listsetrefs->pop_back(); 
       DBG( cout << "IndyEmpty popped listsetrefs, now has " 
-                << listsetrefs->size() << endl; );
-      lasttriedeq->pop_back(); 
+                << ctx->listsetrefs->size() << endl; );
+      ctx->lasttriedeq->pop_back(); 
       DBG( cout << "IndyEmpty popped lasttriedeq, now has " 
-                << lasttriedeq->size() << endl; );
+                << ctx->lasttriedeq->size() << endl; );
     }
   } else {// end of recalled indyEmpty
     DBG(cout << "IndyEmpty called to initialize everything" << endl; );
-    constsfill();
-    canonvars = new vector<physvar *>;
-    canoneqf = new vector<binopexp *>;
-    canongrads = new vector<valander *>;
-    paramasgn = new vector<binopexp *>;
-    studeqf.assign(HELPEQSZ, (binopexp*)NULL);
-    studgrads.assign(HELPEQSZ, (valander*)NULL);
-    studeqsorig.assign(HELPEQSZ, (string*)NULL);
+    ctx->canonvars = new vector<physvar *>;
+    ctx->canoneqf = new vector<binopexp *>;
+    ctx->canongrads = new vector<valander *>;
+    ctx->paramasgn = new vector<binopexp *>;
+    ctx->studeqf.assign(HELPEQSZ, (binopexp*)NULL);
+    ctx->studgrads.assign(HELPEQSZ, (valander*)NULL);
+    ctx->studeqsorig.assign(HELPEQSZ, (string*)NULL);
     for (k=0; k<HELPEQSZ; k++) {
-      studeqsorig[k] = new string();
+      ctx->studeqsorig[k] = new string();
     }
-    numsols = new vector<double>;
-    listofsets = new vector<indyset>;
-    listsetrefs = new vector<vector<int> >;
-    lasttriedeq = new vector<int>;
-    setupdone = true;
+    ctx->numsols = new vector<double>;
+    ctx->listofsets = new vector<indyset>;
+    ctx->listsetrefs = new vector<vector<int> >;
+    ctx->lasttriedeq = new vector<int>;
+    ctx->setupdone = true;
   }
   DBG(cout << "indyEmpty done, returning" << endl;);
   fLog("Done indyEmpty");
@@ -179,40 +180,47 @@ void indyEmpty() {
 void indyAddVar(const char* const name, double value,
                 const char* const unitstr)
 {
+  SolverContext * ctx = solverContext();
   int k;
   string thename(name);
   DBG(cout << "indyAddVar asked to add " << name << " with value " 
            << value << endl; );
-  for (k = 0; k < canonvars->size(); k++) {
-    if (thename == (*canonvars)[k]->clipsname) {
+  ostringstream statement;
+  statement.precision(17);
+  statement << name << " " << value << " " << unitstr;
+  noteStatement("indyAddVar", statement.str());
+  for (k = 0; k < ctx->canonvars->size(); k++) {
+    if (thename == (*ctx->canonvars)[k]->clipsname) {
       throw(string("indyAddVar got duplicate name") + thename);
     }
   }
+  ownCanon();
   physvar *pv = new physvar(thename);
   pv->prefUnit = unitstr;
   pv->value = value;
-  canonvars->push_back(pv);
+  ctx->canonvars->push_back(pv);
   numvalexp * nv = getfromunits(unitstr);
   value *= nv->value;
   pv->MKS = nv->MKS;
   nv->destroy();
   
-  numsols->push_back(value);
+  ctx->numsols->push_back(value);
 }
 
 /************************************************************************
  * indyDoneAddVar   is called to indicate that all variables for the    *
  *    problem have been declared by indyAddVar.				*
- * it sets numvars. Note this must be complete before			*
+ * it sets numindyvars. Note this must be complete before			*
  *     indyAddCanonEq or indyAddStudEq can be called			*
  ************************************************************************/
 void indyDoneAddVar() {
+  SolverContext * ctx = solverContext();
   DBG(cout << "indyDoneAddVar called" << endl;);
-  if (gotthevars) {
+  if (ctx->gotthevars) {
     throw(string("Two indyDoneAddVar without intervening indyEmpty"));
   }
-  gotthevars = true;
-  numvars = canonvars->size();
+  ctx->gotthevars = true;
+  ctx->numindyvars = ctx->canonvars->size();
 }
 
 /************************************************************************
@@ -229,19 +237,21 @@ void indyDoneAddVar() {
  *     canongrads[eqnID]						*
  ************************************************************************/
 void indyAddCanonEq(int eqnID, const char* const equation) {
+  SolverContext * ctx = solverContext();
   DBG(cout << "indyAddCanonEq asked to add with index " << eqnID 
       << " the equation" << endl;);
+  noteStatement("indyAddCanonEq", equation);
 
   // ensure that any variables to be added have been (as well as we can <g>)
-  if (! gotthevars) {
+  if (! ctx->gotthevars) {
     throw(string("indyAddCanonEq called before indyDoneAddVar"));
   }
   // make sure that no other equation has been added
-  if (eqnID < canoneqf->size()) {
+  if (eqnID < ctx->canoneqf->size()) {
     throw(string("indyAddCanonEq called for already filled slot"));
   }
   // assume that equations com in order
-  if (eqnID > canoneqf->size()) {
+  if (eqnID > ctx->canoneqf->size()) {
     throw(string("indyAddCanonEq promised to fill slots in order, didn't"));
   }
   // check that equation is parseable ??? should never happen
@@ -249,13 +259,13 @@ void indyAddCanonEq(int eqnID, const char* const equation) {
     throw(string("Couldn't parse equation ") + string(equation));
   }
   // ???? ensure that equations come in order ????
-  if (eqnID +1 != canoneqf->size()) {
+  if (eqnID +1 != ctx->canoneqf->size()) {
     throw(string("can't deal with equations presented except in sequence"));
   }
-  DBG(cout << eqnID << ": " << (*canoneqf)[eqnID]->getInfix() << endl);
+  DBG(cout << eqnID << ": " << (*ctx->canoneqf)[eqnID]->getInfix() << endl);
   DBG(cout << "Ready to push equation gradient" << endl);
   // must be okay so record and quit
-  canongrads->push_back(getvnd((*canoneqf)[eqnID], canonvars, numsols));
+  ctx->canongrads->push_back(getvnd((*ctx->canoneqf)[eqnID], ctx->canonvars, ctx->numsols));
 }
 
 
@@ -268,22 +278,23 @@ void indyAddCanonEq(int eqnID, const char* const equation) {
  *    question indyCanonHowIndy in newindy.cpp				*
  ************************************************************************/
 bool indyIsCanonIndy(int setID, int eqnID) { 
+  SolverContext * ctx = solverContext();
   DBG(cout << "indyIsCanonIndy started" << endl);
-  if (!gotthevars) 
+  if (!ctx->gotthevars) 
     throw(string("indyIsCanonIndy called before indyDoneAddVar"));
-  if ((eqnID >= canoneqf->size()) || (eqnID < 0))
+  if ((eqnID >= ctx->canoneqf->size()) || (eqnID < 0))
     throw(string(
      "indyIsCanonIndy called for undefined equation"));
-  if ((setID >= listofsets->size()) || (setID < 0)) throw(string(
+  if ((setID >= ctx->listofsets->size()) || (setID < 0)) throw(string(
      "indyIsCanonIndy called for undefined set"));
-  (*lasttriedeq)[setID] = eqnID;
-  bool answer=(*listofsets)[setID].isindy((*canongrads)[eqnID]);
+  (*ctx->lasttriedeq)[setID] = eqnID;
+  bool answer=(*ctx->listofsets)[setID].isindy((*ctx->canongrads)[eqnID]);
   DBG(cout << "indyIsCanonIndy with eqnID=" << eqnID << ", setID=" 
       << setID << ", determined that " << endl << "    "
-      << (*canoneqf)[eqnID]->getInfix() << endl << "     is "
+      << (*ctx->canoneqf)[eqnID]->getInfix() << endl << "     is "
       << (answer?"independent":"dependent") << " of the "
-      << (*listofsets)[setID].size() << " equations with " 
-      << listofsets->size() - 1 << " sets."<< endl);
+      << (*ctx->listofsets)[setID].size() << " equations with " 
+      << ctx->listofsets->size() - 1 << " sets."<< endl);
   return(answer);
 }
 
@@ -297,20 +308,21 @@ bool indyIsCanonIndy(int setID, int eqnID) {
  ************************************************************************/
 bool indyIsStudIndy(int setID, int eqnID)
 { 
-  if (!gotthevars) 
+  SolverContext * ctx = solverContext();
+  if (!ctx->gotthevars) 
     throw(string("indyIsStudIndy called before indyDoneAddVar"));
   if ((eqnID >= HELPEQSZ) || (eqnID < 0))
     throw(string(
      "indyIsStudIndy called for undefined equation"));
-  if (studeqf[eqnID] == (binopexp *)NULL)
+  if (ctx->studeqf[eqnID] == (binopexp *)NULL)
     throw(string("Student Equation ") + itostr(eqnID) + 
           " is blank, can't be checked for independence");
-  if ((setID >= listofsets->size()) || (setID < 0)) throw(string(
+  if ((setID >= ctx->listofsets->size()) || (setID < 0)) throw(string(
      "indyIsStudIndy called for undefined set"));
-  (*lasttriedeq)[setID] = eqnID;
-  DBG(cout << studeqf[eqnID]->getInfix() << " is independent of the "
-      << (*listofsets)[setID].size()<< " equations in set " << setID << endl);
-  return((*listofsets)[setID].isindy(studgrads[eqnID]));
+  (*ctx->lasttriedeq)[setID] = eqnID;
+  DBG(cout << ctx->studeqf[eqnID]->getInfix() << " is independent of the "
+      << (*ctx->listofsets)[setID].size()<< " equations in set " << setID << endl);
+  return((*ctx->listofsets)[setID].isindy(ctx->studgrads[eqnID]));
 }
 
 /************************************************************************
@@ -325,20 +337,21 @@ bool indyIsStudIndy(int setID, int eqnID)
  ************************************************************************/
 void indyAddEq2CanSet(int setID, int eqnID)
 {
-  if (setID > listofsets->size())
+  SolverContext * ctx = solverContext();
+  if (setID > ctx->listofsets->size())
     throw(string("tried to add to set neither defined nor next"));
-  if (setID == listofsets->size())
+  if (setID == ctx->listofsets->size())
     {
-      listofsets->push_back(indyset(numvars));
+      ctx->listofsets->push_back(indyset(ctx->numindyvars));
       vector<int> * temp = new vector<int>;
-      listsetrefs->push_back(*temp);
-      lasttriedeq->push_back(-1);
+      ctx->listsetrefs->push_back(*temp);
+      ctx->lasttriedeq->push_back(-1);
     }
   if (!indyIsCanonIndy(setID,eqnID))
     throw(string("Equation ") + itostr(eqnID) + 
           " not independent of what is already in set " + itostr(setID));
-  (*listofsets)[setID].placelast();
-  (*listsetrefs)[setID].push_back(eqnID);
+  (*ctx->listofsets)[setID].placelast();
+  (*ctx->listsetrefs)[setID].push_back(eqnID);
 }
 
 /************************************************************************
@@ -350,32 +363,62 @@ void indyAddEq2CanSet(int setID, int eqnID)
  ************************************************************************/
 void indyKeepN(int setID, int numberToKeep)
 {
-  if ((setID >= listofsets->size()) || (setID < 0)) throw(string(
+  SolverContext * ctx = solverContext();
+  if ((setID >= ctx->listofsets->size()) || (setID < 0)) throw(string(
      "indyKeepN called for undefined set"));
-  if (!((*listofsets)[setID]).keepn(numberToKeep))
+  if (!((*ctx->listofsets)[setID]).keepn(numberToKeep))
     throw(string("error in call to indyKeepN"));
-  while ((*listsetrefs)[setID].size() > numberToKeep)
-    (*listsetrefs)[setID].pop_back(); // added 10/23/01 JaS
+  while ((*ctx->listsetrefs)[setID].size() > numberToKeep)
+    (*ctx->listsetrefs)[setID].pop_back(); // added 10/23/01 JaS
   return;
 }
 
 
+/************************************************************************
+ *  indyRelease()  deletes the problem structures created by indyEmpty, *
+ *    leaving setupdone false so that the next indyEmpty will create    *
+ *    them afresh. Used when a session is destroyed, and by closeupshop *
+ ************************************************************************/
+void indyRelease()
+{
+  SolverContext * ctx = solverContext();
+  if (!ctx->setupdone) return;
+  indyEmpty();
+  delete ctx->canonvars;
+  delete ctx->canoneqf;
+  delete ctx->canongrads;
+  delete ctx->paramasgn;
+  for (int k=0; k<HELPEQSZ; k++) delete ctx->studeqsorig[k];
+  delete ctx->numsols;
+  delete ctx->listofsets;
+  delete ctx->listsetrefs;
+  delete ctx->lasttriedeq;
+  ctx->canonvars = 0L;
+  ctx->canoneqf = 0L;
+  ctx->canongrads = 0L;
+  ctx->paramasgn = 0L;
+  ctx->studeqsorig.assign(HELPEQSZ, (string*)NULL);
+  ctx->numsols = 0L;
+  ctx->listofsets = 0L;
+  ctx->listsetrefs = 0L;
+  ctx->lasttriedeq = 0L;
+  ctx->setupdone = false;
+}
+
 /************************************************************************
  *  closeupshop()  deletes all the structures created by indyEmpty, to  *
  *    be used when closing down the system (not between problems)	*
  ************************************************************************/
 void closeupshop() 
 {
-  indyEmpty();
-  delete canonvars;
-  delete canoneqf;
-  delete canongrads;
-  delete numsols;
-  delete listofsets;
-  delete listsetrefs;
-  delete lasttriedeq;
+  indyRelease();
+  if (constnumvals) {
+    for (size_t k = 0; k < constnumvals->size(); k++) 
+      (*constnumvals)[k]->destroy();
+  }
   delete constnames;
   delete constnumvals;
+  constnames = 0L;
+  constnumvals = 0L;
   // should we output something?
 }
-
@@ -37,6 +37,7 @@ std::string simplifyEqn(const int sourceSlot, const int destSlot);
 std::string subInOneEqn(int sourceSlot,int targetSlot,int destSlot);
 int indyCanonHowIndy(int setID, int eqnID, vector<int>* linexpand, vector<int>* mightdepend);
 int indyStudHowIndy(int setID, int eqnID, vector<int>* linexpand, vector<int>* mightdepend);
+void indyRelease();
 void closeupshop();
 
 enum OkayAns {
@@ -33,7 +33,6 @@ using namespace std;
 #define DBG(A) DBGF(INDYEMP,A)
 
 // in extstruct: canonvars, canoneqf, studeqf
-extern vector<valander *> studgrads;
 int indyAddStudEq(int slot, const char* const equation);	// in indysgg
 
 /************************************************************************
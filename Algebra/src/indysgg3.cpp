@@ -41,9 +41,7 @@ using namespace std;
 // currently this is only implemented in the polysolve portion
 
 // in extstruct: canonvars, canoneqf, studeqf
-extern vector<valander *> studgrads;
 int indyAddStudEq(int slot, const char* const equation);	// in indysgg
-extern bool gotthevars;					// in indysgg.cpp
 numvalexp * getfromunits(const string & unitstr);	// in unitabr.cpp
 
 /************************************************************************
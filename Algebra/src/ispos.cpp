@@ -67,8 +67,8 @@ bool isnonneg(const expr * e)
     case n_op:
       {
 	bool answer = true;
-	for (int k=0; k < ((n_opexp *)e)->args->size(); k++)
-	  answer &= isnonneg((*((n_opexp *)e)->args)[k]);
+	for (int k=0; k < ((n_opexp *)e)->args.size(); k++)
+	  answer &= isnonneg(((n_opexp *)e)->args[k]);
 	DBG( cout << "isnonneg returning " << ((answer) ? "true" : "false") 
 	     << " on " << e->getInfix() << endl;);
 	return(answer);
@@ -95,10 +95,10 @@ bool ispositive(const expr * e)
     case n_op:
       {
 	bool answer = true;
-	for (int k=0; k < ((n_opexp *)e)->args->size(); k++)
+	for (int k=0; k < ((n_opexp *)e)->args.size(); k++)
 	  {
 	    DBG( cout << k << " term in ispos" ;);
-	    answer &= ispositive((*((n_opexp *)e)->args)[k]);
+	    answer &= ispositive(((n_opexp *)e)->args[k]);
 	    DBG( cout << ((answer) ? "true" : "false") << endl;);
 	  }
 	DBG( cout << "ispos returning " << ((answer) ? "true" : "false") 
@@ -52,10 +52,10 @@ bool hasjustonevar(const expr * e, varindx & pv)
 	{
 	  int k;
       n_opexp *th = (n_opexp *) e;
-      for (k=0; k < th->args->size(); k++)
-        if (!hasjustonevar((*th->args)[k], pv)) return(false);
+      for (k=0; k < th->args.size(); k++)
+        if (!hasjustonevar(th->args[k], pv)) return(false);
       // return(true);  // AW: wrong if degenerate 0 arg n_op?
-		return (th->args->size() > 0); // must have at least 1 arg
+		return (th->args.size() > 0); // must have at least 1 arg
 	}
   default:
 		throw(string("unknown expr type in hasjustonevar"));
@@ -17,6 +17,7 @@
 //  You should have received a copy of the GNU Lesser General Public License
 //  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
 
+#define SOLVERCONTEXT_MEMBERS	// the state is reached through ctx
 #include "justsolve.h"
 #include "decl.h"
 #include "dbg.h"
@@ -43,15 +44,16 @@
  *   returns true if there are no UNSLVEQS or UNSLVVARSQ		*
  ************************************************************************/
 bool solveeqs(ostream & outfile){
+  SolverContext * ctx = solverContext();
   int k;
   bool isokay = true;
   vector<varindx> *vars = new vector<varindx>;
-  vector<binopexp *> * eqn = new vector<binopexp *>(canoneqf->size(),
+  vector<binopexp *> * eqn = new vector<binopexp *>(ctx->canoneqf->size(),
 						    (binopexp *)NULL);
   expr * eqexpr;
   expr * dimtroub;
-  for (k = 0; k < canoneqf->size(); k++) {
-    eqexpr = copyexpr((*canoneqf)[k]);
+  for (k = 0; k < ctx->canoneqf->size(); k++) {
+    eqexpr = copyexpr((*ctx->canoneqf)[k]);
     eqnumsimp(eqexpr,true);
     dimtroub = dimenchk(true,eqexpr);
     if (dimtroub != (expr *)NULL) {
@@ -68,13 +70,13 @@ bool solveeqs(ostream & outfile){
 	 << (*eqn)[k]->getInfix() << endl);
   } // end of k loop over canoneqf
   // now add in parameter assignments
-  for (k = paramasgn->size(); k > 0; k--) {
-    eqn->push_back((*paramasgn)[k-1]);
-    paramasgn->pop_back();
+  for (k = ctx->paramasgn->size(); k > 0; k--) {
+    eqn->push_back((*ctx->paramasgn)[k-1]);
+    ctx->paramasgn->pop_back();
   }
-  for (k = 0; k < canonvars->size(); k++) 
-    if ((*canonvars)[k]->isused) vars->push_back(k);
-  numpasses = 0;
+  for (k = 0; k < ctx->canonvars->size(); k++) 
+    if ((*ctx->canonvars)[k]->isused) vars->push_back(k);
+  ctx->numpasses = 0;
   checkeqs(eqn, vars, outfile);
   DBG( cout << "After first checkeqs, left with "
        << eqn->size() << " equations and "
@@ -105,22 +107,22 @@ bool solveeqs(ostream & outfile){
       isokay = false;
       DBG(cout << "unsolved VARIABLES:" << endl;
 	  for (k=0; k < vars->size(); k++) 
-	  cout << (*canonvars)[(*vars)[k]]->clipsname << "  ";
+	  cout << (*ctx->canonvars)[(*vars)[k]]->clipsname << "  ";
 	  cout << endl;
 	  );
       outfile << "<UNSLVVARS>" << endl;
       for (k=0; k < vars->size(); k++) 
-	outfile << "(" << (*canonvars)[(*vars)[k]]->clipsname 
+	outfile << "(" << (*ctx->canonvars)[(*vars)[k]]->clipsname 
 	      << " NIL)" << endl;
     }
   bool gotunused = false;
-  for (k = 0; k < canonvars->size(); k++)
-    if (!(*canonvars)[k]->isused) {
+  for (k = 0; k < ctx->canonvars->size(); k++)
+    if (!(*ctx->canonvars)[k]->isused) {
       if (!gotunused) {
 	outfile << "<UNUSEDVARS>" << endl;
 	gotunused = true;
       }
-      outfile << "(" << (*canonvars)[k]->clipsname 
+      outfile << "(" << (*ctx->canonvars)[k]->clipsname 
 	      << " NIL)" << endl;
     }
   return(isokay);
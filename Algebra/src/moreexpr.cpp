@@ -73,7 +73,7 @@ void apluskb(expr * & a1, const expr * const a2, numvalexp *nv)
       answer = new n_opexp(&myplus);
       answer->addarg(a1);
       a1 = answer;
-      if (a1 == (*((n_opexp *)a1)->args)[0]) 
+      if (a1 == ((n_opexp *)a1)->args[0]) 
 	throw(string("Whoops, apluskb has a real bug!!!"));
       DBGM(cout << "apluskb " << thisdbg << " made new n_op: " << endl;
 	  cout << answer->getInfix() << ", and a1 is now "
@@ -84,9 +84,9 @@ void apluskb(expr * & a1, const expr * const a2, numvalexp *nv)
   if ((a2->etype == n_op) 			// if a2 is sum, do each term. 
       && ((n_opexp *)a2)->op->opty == pluse)
     {		
-      for (int k = 0; k < ((n_opexp *)a2)->args->size(); k++)
+      for (int k = 0; k < ((n_opexp *)a2)->args.size(); k++)
 	{
-	  apluskb(a1, (*((n_opexp *)a2)->args)[k],(numvalexp *)copyexpr(nv));
+	  apluskb(a1, ((n_opexp *)a2)->args[k],(numvalexp *)copyexpr(nv));
 	  DBG( cout << "apluskb " << thisdbg << ": " << k 
 	       << "th term moved and a1 is now " << a1->getInfix() << endl);
 	}
@@ -95,22 +95,22 @@ void apluskb(expr * & a1, const expr * const a2, numvalexp *nv)
     }
   else
     {				// a2 is not a plus, treat as one term.
-      for (int k = 0; k < answer->args->size(); k++) // check to see if lhs
+      for (int k = 0; k < answer->args.size(); k++) // check to see if lhs
 	{			// sum already has a term proportional to it.
 	  numvalexp * fk=NULL;
 	  
-	  if (((*answer->args)[k]->etype == numval) &&
-	      ((numvalexp *)(*answer->args)[k])->value == 0)
+	  if ((answer->args[k]->etype == numval) &&
+	      ((numvalexp *)answer->args[k])->value == 0)
 	    {
-	      (*answer->args)[k]->destroy();
-	      (*answer->args)[k] = copyexpr(a2);
-	      kmult((*answer->args)[k],nv);
+	      answer->args[k]->destroy();
+	      answer->args[k] = copyexpr(a2);
+	      kmult(answer->args[k],nv);
 	      a1 = answer;
 	      return;
 	    }
 	  DBGM( cout << "apluskb " << thisdbg << ": About to uptonum arg " 
 	       << k << endl);
-	  if (uptonum((*answer->args)[k],a2,fk) && fk)    
+	  if (uptonum(answer->args[k],a2,fk) && fk)    
 	    // if term on lhs and term to be added differ only by numval, 
 	    // just change its coefficient
 	    {			
@@ -125,25 +125,25 @@ void apluskb(expr * & a1, const expr * const a2, numvalexp *nv)
 		  fflush(stdout);
 		  cout << a2->getInfix() << " to ";
 		  fflush(stdout);
-		  cout << (*answer->args)[k]->getInfix() << endl;
+		  cout << answer->args[k]->getInfix() << endl;
 		  fflush(stdout);
 		  throw(string(
 			     "attempt to add terms of different dimensions"));
 		}
 	      if (fabs(nv->value + fk->value) < 
 		  RELERR * (fabs(nv->value) + fabs(fk->value)))
-		kmult((*answer->args)[k], 0.);
+		kmult(answer->args[k], 0.);
 	      else
-		kmult((*answer->args)[k],1. + (nv->value/fk->value)); // AW: what blocks divide by zero???
+		kmult(answer->args[k],1. + (nv->value/fk->value)); // AW: what blocks divide by zero???
 	      fk->destroy();
 	      nv->destroy();
-	      if (((*answer->args)[k]->etype == numval) &&   
-		  ((numvalexp *)(*answer->args)[k])->value == 0.)
+	      if ((answer->args[k]->etype == numval) &&   
+		  ((numvalexp *)answer->args[k])->value == 0.)
 		{
-		  (*answer->args)[k]->destroy();
-		  for (int q=k+1; q < answer->args->size(); q++)
-		    (*answer->args)[q-1]=(*answer->args)[q];
-		  answer->args->pop_back();
+		  answer->args[k]->destroy();
+		  for (int q=k+1; q < answer->args.size(); q++)
+		    answer->args[q-1]=answer->args[q];
+		  answer->args.pop_back();
 		}
 	      a1 = answer;	// added 2/7/01 - is it needed? Made no diff
 	      DBG( cout << "return1 from apluskb " << thisdbg << " with "
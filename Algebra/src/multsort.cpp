@@ -24,7 +24,7 @@ using namespace std;
 
 #define DBG(A) DBGF(PLUSSORT,A)
 #define DBGM(A) DBGFM(PLUSSORT,A)
-void qsrtexpr(vector<expr *> *Vptr);
+void qsrtexpr(exprlist *Vptr);
 
 
 /************************************************************************
@@ -45,7 +45,7 @@ bool multsort(expr * & ex)
   if (ex->etype != n_op) throw(string("multsort called on non-n_op"));
   if (((n_opexp *)ex)->op->opty != multe)
     throw(string("multsort called on non-mult n_op"));
-  vector<expr *> *v = ((n_opexp *)ex)->args;
+  exprlist *v = &((n_opexp *)ex)->args;
   DBGM(cout << "Multsort about to call qsrtexpr" << endl;);
   qsrtexpr(v);
   DBGM(cout << "Multsort after sort, " << ex->getInfix() << endl;);
@@ -124,7 +124,7 @@ bool multsort(expr * & ex)
 
       if(!waspow1) exp1->destroy();
     } // end of loop on q1, first factor. 		to next q1 start.
-  if (((n_opexp *)ex)->args->size() < 2) unnop(ex);
+  if (((n_opexp *)ex)->args.size() < 2) unnop(ex);
   DBG(cout << "Multsort " << thisdbg << " returning " 
       << ((answer) ? "true" : "false")
 	   << " with ex=" << ex->getInfix() << endl);
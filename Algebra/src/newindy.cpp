@@ -18,6 +18,7 @@
 //  You should have received a copy of the GNU Lesser General Public License
 //  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
 
+#define SOLVERCONTEXT_MEMBERS	// the state is reached through ctx
 #include "decl.h"
 #include "dbg.h"
 #include "extstruct.h"
@@ -33,15 +34,6 @@ using namespace std;
 
 // others not in decl.h
 
-extern vector<valander *> *canongrads;
-extern vector<valander *> studgrads;
-extern int numindysets;
-extern vector<indyset> *listofsets;
-extern int numvars;
-extern vector<vector<int> > * listsetrefs;
-extern bool gotthevars;
-extern vector<int> *lasttriedeq;
-
 int indyHowIndy(int setID, expr * eq, valander * val,vector<int> * linexpand,
 		vector<int> * mightdepend );
 
@@ -82,6 +74,7 @@ int indyHowIndy(int setID, expr * eq, valander * val,vector<int> * linexpand,
 int indyHowIndy(int setID, expr * eq, valander * val,vector<int> * linexpand,
 		vector<int> * mightdepend )
 {
+  SolverContext * ctx = solverContext();
   int k;
   DBG( cout << "entering indyHowIndy on set " << setID << " and equation "
        << eq->getInfix() << endl;
@@ -89,64 +82,64 @@ int indyHowIndy(int setID, expr * eq, valander * val,vector<int> * linexpand,
   mightdepend->clear();
   linexpand->clear();
   // expcoefs is the set of coefs of the equation in linear approx in setID eqs
-  vector<double> *expcoefs=(*listofsets)[setID].expandlast();
+  vector<double> *expcoefs=(*ctx->listofsets)[setID].expandlast();
   DBGM(cout << "in indyHowIndy expcoefs = "; printdv(*expcoefs));
 
   // See Bug #736 for details on the zero test that was removed from here
   for (k = 0; k < expcoefs->size(); k++) 
     if (fabs((*expcoefs)[k]) > 0.0) // for debugging
-      linexpand->push_back((*listsetrefs)[setID][k]);
+      linexpand->push_back((*ctx->listsetrefs)[setID][k]);
   delete expcoefs;
 
   // linexpand now has canonical equation indices of equations on which 
   // there is a dependence in the linear approximation
-  vector<int> wehavevar(numvars,0); // wehavevar[vk] will be the number of 
+  vector<int> wehavevar(ctx->numindyvars,0); // wehavevar[vk] will be the number of 
 				    // eqns in dependency set with variable vk
   // get all variables on which any of the equations thought dependent depend
-  for (k = 0; k < numvars; k++) {			// for each variable
+  for (k = 0; k < ctx->numindyvars; k++) {			// for each variable
     if (val->hasvar[k]) wehavevar[k] ++; 		// first new eq
     for (int q = 0; q < linexpand->size(); q++)        // now each in expansion
-      if ((*canongrads)[(*linexpand)[q]]->hasvar[k]) wehavevar[k] ++;
+      if ((*ctx->canongrads)[(*linexpand)[q]]->hasvar[k]) wehavevar[k] ++;
   }	// wehavevar[k] is now the number of eqs in dep set depending on v_k
   // count the number of variables this set (+ test eq) depend on
   int ournumvar = 0;
-  for (k = 0; k < numvars; k++) {
+  for (k = 0; k < ctx->numindyvars; k++) {
     if (wehavevar[k] > 0) ournumvar++;
     // eliminate variables for which an equation has nonzero gradient component
     // valender has already rounded down to zero, when appropriate
     if (val->gradient[k] != 0.) wehavevar[k] = 0;
     for (int q = 0; q < linexpand->size(); q++) 
       // valender has already rounded down to zero, when appropriate
-      if ((*canongrads)[(*linexpand)[q]]->gradient[k] != 0.) 
+      if ((*ctx->canongrads)[(*linexpand)[q]]->gradient[k] != 0.) 
 	wehavevar[k] = 0;
   }
 
 
   bool havebadvar = false;
   bool havemaybeeq = false;
-  DBGM(cout <<"before checking numvars with wehavevars, linexpand is ";
+  DBGM(cout <<"before checking numindyvars with wehavevars, linexpand is ";
       for (int q=0; q < linexpand->size(); q++) 
       cout << (*linexpand)[q] << ", ";
       cout << endl;);
   // now for each variable on which there is dependence but no linear
-  for (k = 0; k < numvars; k++) 		// term about sol point,
+  for (k = 0; k < ctx->numindyvars; k++) 		// term about sol point,
     if (wehavevar[k] > 0) {			// try to find eqn in full set
       bool haverealeq = false;			// which does have linear term
       DBGM( cout << "indyHowIndy wehavevar " << k << endl;);
 		// first, look for other eq in set with nonzero grad comp
       int r;
       int foundeq = -1;
-      for (int q = 0; q < (*listofsets)[setID].size(); q++) {
-	valander * thisval = (*canongrads)[(*listsetrefs)[setID][q]];
+      for (int q = 0; q < (*ctx->listofsets)[setID].size(); q++) {
+	valander * thisval = (*ctx->canongrads)[(*ctx->listsetrefs)[setID][q]];
 	DBGM( cout << thisval->print() << endl;);
 	// valender has already rounded down to zero when appropriate
 	if (thisval->gradient[k] != 0.) { // provisional eq to return
-	  foundeq = (*listsetrefs)[setID][q];      // try to find one with only
+	  foundeq = (*ctx->listsetrefs)[setID][q];      // try to find one with only
 	  DBGM(cout << "foundeq provisionally set to " << foundeq << endl);
-	  for (r = 0; r < numvars; r++)		   // this one variable
+	  for (r = 0; r < ctx->numindyvars; r++)		   // this one variable
 	    // valender has already rounded down to zero when appropriate
 	    if (r != k && thisval->gradient[r] !=0.) break;
-	  if (r == numvars) { haverealeq = true; break;}// found perfect eqn
+	  if (r == ctx->numindyvars) { haverealeq = true; break;}// found perfect eqn
 	} // end of found one eq with this comp nonzero
       } // end of checking all eqs in set
       if (foundeq >= 0) {
@@ -189,60 +182,62 @@ int indyHowIndy(int setID, expr * eq, valander * val,vector<int> * linexpand,
   // seems dependence is real, but we are only certain if either
   // no variables are dependent on other than ones accounted for, or
   // all equations in suggested dependency are linear. check that.
-  for (k = 0; k < numvars; k++) if (wehavevar[k] != 0) break;
-  if (k == numvars) return(4);
+  for (k = 0; k < ctx->numindyvars; k++) if (wehavevar[k] != 0) break;
+  if (k == ctx->numindyvars) return(4);
   if (ournumvar <= linexpand->size()) return(4); // must be dependent!
   // What is below assumes all physvars are marked unknown. Need to do that?
   if (ordunknowns(eq,false) != 1) return(3);
   for (k = 0; k < linexpand->size(); k++)
-    if (ordunknowns((*canoneqf)[(*linexpand)[k]],false) != 1) return(3);
+    if (ordunknowns((*ctx->canoneqf)[(*linexpand)[k]],false) != 1) return(3);
   return(4);
 }
 
 int indyCanonHowIndy(int setID, int eqnID, vector<int> * linexpand,
 	vector<int> * mightdepend )
 { 
+  SolverContext * ctx = solverContext();
   DBG(cout << "indyCanonHowIndy asked if ";);
-  if (!gotthevars) 
+  if (!ctx->gotthevars) 
     throw(string("\n indyCanonHowIndy called before indyDoneAddVar"));
-  if ((eqnID >= canoneqf->size()) || (eqnID < 0))
+  if ((eqnID >= ctx->canoneqf->size()) || (eqnID < 0))
     throw(string(
      "\n indyCanonHowIndy called for undefined equation"));
-  if ((setID >= listofsets->size()) || (setID < 0)) throw(string(
+  if ((setID >= ctx->listofsets->size()) || (setID < 0)) throw(string(
      "\n indyCanonHowIndy called for undefined set"));
-  (*lasttriedeq)[setID] = eqnID;
-  DBG(cout << (*canoneqf)[eqnID]->getInfix() << " is independent of the "
-      << (*listofsets)[setID].size()<< " equations in set " << setID 
-      << " of " << listofsets->size() - 1 << " sets."<< endl;);
-  if ((*listofsets)[setID].isindy((*canongrads)[eqnID])) return (0);
+  (*ctx->lasttriedeq)[setID] = eqnID;
+  DBG(cout << (*ctx->canoneqf)[eqnID]->getInfix() << " is independent of the "
+      << (*ctx->listofsets)[setID].size()<< " equations in set " << setID 
+      << " of " << ctx->listofsets->size() - 1 << " sets."<< endl;);
+  if ((*ctx->listofsets)[setID].isindy((*ctx->canongrads)[eqnID])) return (0);
 				// okay, it is really independent, returned 0
-  return (indyHowIndy(setID, (*canoneqf)[eqnID],(*canongrads)[eqnID],
+  return (indyHowIndy(setID, (*ctx->canoneqf)[eqnID],(*ctx->canongrads)[eqnID],
 		      linexpand, mightdepend));
 }
   
 int indyStudHowIndy(int setID, int eqnID, vector<int> * linexpand,
 	vector<int> * mightdepend )
 { 
+  SolverContext * ctx = solverContext();
   DBG(cout << "entering indyStudHowIndy" << endl);
-  if (!gotthevars) 
+  if (!ctx->gotthevars) 
     throw(string("indyStudHowIndy called before indyDoneAddVar"));
   if ((eqnID >= HELPEQSZ) || (eqnID < 0))
     throw(string(
 		 "indyStudHowIndy called for undefined equation"));
-  if (studeqf[eqnID] == (binopexp *)NULL)
+  if (ctx->studeqf[eqnID] == (binopexp *)NULL)
     throw(string("Student Equation ") + itostr(eqnID) + 
 	  " is blank, can't be checked for independence");
-  if ((setID >= listofsets->size()) || (setID < 0)) 
+  if ((setID >= ctx->listofsets->size()) || (setID < 0)) 
     throw(string("in indyStudHowIndy called for undefined set"));
-  (*lasttriedeq)[setID] = eqnID;
-  DBG(cout << "indyStudHowIndy. Determine if " << studeqf[eqnID]->getInfix() 
-      << " is independent of the " << (*listofsets)[setID].size()
+  (*ctx->lasttriedeq)[setID] = eqnID;
+  DBG(cout << "indyStudHowIndy. Determine if " << ctx->studeqf[eqnID]->getInfix() 
+      << " is independent of the " << (*ctx->listofsets)[setID].size()
       << " equations in set " << setID << endl;);
-  if ((*listofsets)[setID].isindy(studgrads[eqnID])) {
+  if ((*ctx->listofsets)[setID].isindy(ctx->studgrads[eqnID])) {
     DBG(cout << "indyStudHowIndy return 0, is independant" << endl);
     return(0); // okay, it is really independent, returned 0
   }
-  return (indyHowIndy(setID, studeqf[eqnID],studgrads[eqnID],
+  return (indyHowIndy(setID, ctx->studeqf[eqnID],ctx->studgrads[eqnID],
 		      linexpand, mightdepend));
 }
 
@@ -245,30 +245,30 @@ bool nlsolvov(binopexp * & bineq)
 	case n_op:
 	  {
 	    n_opexp * varside = (n_opexp *) bineq->lhs;
-	    for (int k=0; k < varside->args->size(); k++)
-	      if ((*varside->args)[k]->etype == numval)
+	    for (int k=0; k < varside->args.size(); k++)
+	      if (varside->args[k]->etype == numval)
 		{
 		  changed = true;
 		  switch(varside->op->opty)
 		    {
 		    case pluse:
-		      if (binrhs->MKS == (*varside->args)[k]->MKS)
+		      if (binrhs->MKS == varside->args[k]->MKS)
 			binrhs->value -=
-			  ((numvalexp *) (*varside->args)[k])->value;
+			  ((numvalexp *) varside->args[k])->value;
 		      else throw(string(
 				"nlsolvov tried to add incommensurate terms"));
 		      break;
 		    case multe:
 		      binrhs->value *=
-			1./((numvalexp *) (*varside->args)[k])->value;
-		      binrhs->MKS += (*varside->args)[k]->MKS * -1.;
+			1./((numvalexp *) varside->args[k])->value;
+		      binrhs->MKS += varside->args[k]->MKS * -1.;
 		      break;
 		    default: 
 		      throw(string("unknown n_op in lhs of call to nlsolvov"));
 		    }
-		  for (int q=k+1;q< varside->args->size(); q++)
-		    (*varside->args)[q-1] = (*varside->args)[q];
-		  varside->args->pop_back();
+		  for (int q=k+1;q< varside->args.size(); q++)
+		    varside->args[q-1] = varside->args[q];
+		  varside->args.pop_back();
 		  k--;
 		}
 	    if (changed) continue; // I've done something, now start over
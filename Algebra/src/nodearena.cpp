@@ -0,0 +1,357 @@
+// nodearena.cpp
+//    The chunks expression nodes are carved from, see nodearena.h
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  A chunk is chunkBytes long and starts at a multiple of chunkBytes, so
+//  the chunk of a node, and from it the arena it belongs to, is found by
+//  masking its address. Nodes are carved from the chunk one after the
+//  other, rounded to 8 bytes; a freed node goes on the list of free
+//  nodes of its size, and is used again before anything more is carved.
+//  Scratch chunks count the nodes in them that are in use. When the
+//  outermost scratchNodes ends, those with none are taken back at once,
+//  whatever was freed in them forgotten, and the others kept aside until
+//  their count comes to zero. Chunks taken back are kept (up to
+//  maxSpares) to be carved again.
+//  Nodes are made with their own context current, and mostly freed
+//  with it current too. One freed with another context current (such
+//  as a constnumval, made in the default context and freed by
+//  closeupshop from whichever is current) is not put on a list another
+//  thread may be using: it goes, under a lock, on the returned list of
+//  its own arena, which takes it back the next time it makes a node or
+//  ends a scratch scope. Such frees are counted.
+
+#include "decl.h"
+#include "extstruct.h"
+#include "nodearena.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+using namespace std;
+
+static const size_t chunkBytes = 1 << 16;
+static const int maxSpares = 16;
+
+enum chunkKind { problemChunk, scratchChunk, keptChunk };
+
+struct nodeChunk {
+  nodeArena * owner;
+  nodeChunk * prev, * next;		// in the list of its kind
+  long live;				// nodes in use
+  int kind;
+};
+
+// nodes start after the header, on a cache line
+static const size_t headerBytes = (sizeof(nodeChunk) + 63) & ~(size_t) 63;
+
+static_assert(sizeof(numvalexp) <= 72 && sizeof(physvarptr) <= 72 &&
+	      sizeof(binopexp) <= 72 && sizeof(functexp) <= 72 &&
+	      sizeof(n_opexp) <= 72 && sizeof(fakeexpr) <= 72,
+	      "expression nodes must fit the size classes of nodeArena");
+
+// for solverStats, shared by all contexts
+static const memory_order relaxed = memory_order_relaxed;
+static atomic<unsigned long> nodesMade(0), chunksMade(0), chunksReused(0),
+  scratchScopes(0), chunksKept(0), foreignFrees(0), treesCopied(0);
+
+static inline nodeChunk * chunkOf(void * node)
+{
+  return((nodeChunk *) ((uintptr_t) node & ~(uintptr_t) (chunkBytes - 1)));
+}
+
+static void push(nodeChunk * & list, nodeChunk * c)
+{
+  c->prev = 0L;
+  c->next = list;
+  if (list) list->prev = c;
+  list = c;
+}
+
+static void unlink(nodeChunk * & list, nodeChunk * c)
+{
+  if (c->prev) c->prev->next = c->next;
+  else list = c->next;
+  if (c->next) c->next->prev = c->prev;
+}
+
+static void freeAll(nodeChunk * list)
+{
+  while (list) {
+    nodeChunk * c = list;
+    list = list->next;
+    free(c);
+  }
+}
+
+// a freed node holds the next on its list
+static inline void * pop(void * & list)
+{
+  void * node = list;
+  list = *(void **) node;
+  return(node);
+}
+
+static inline void pushNode(void * & list, void * node)
+{
+  *(void **) node = list;
+  list = node;
+}
+
+nodeArena::nodeArena() :
+  anyReturned(false), chunks(0L), scratch(0L), kept(0L), spare(0L), next(0L),
+  scratchNext(0L), spares(0), scratchDepth(0), problemDepth(0),
+  made(0), copies(0)
+{
+  for (int k = 0; k < classes; k++)
+    freeNodes[k] = freeScratch[k] = returned[k] = 0L;
+}
+
+nodeArena::~nodeArena()
+{
+  flushStats();
+  freeAll(chunks);
+  freeAll(scratch);
+  freeAll(kept);
+  freeAll(spare);
+}
+
+void nodeArena::flushStats()
+{
+  if (made > 0) nodesMade.fetch_add(made, relaxed);
+  if (copies > 0) treesCopied.fetch_add(copies, relaxed);
+  made = 0;
+  copies = 0;
+}
+
+nodeChunk * nodeArena::newChunk(int kind)
+{
+  nodeChunk * c = spare;
+  if (c) {
+    unlink(spare, c);
+    spares--;
+    chunksReused.fetch_add(1, relaxed);
+  } else {
+    void * memory;
+    if (posix_memalign(&memory, chunkBytes, chunkBytes) != 0) throw bad_alloc();
+    c = (nodeChunk *) memory;
+    chunksMade.fetch_add(1, relaxed);
+    flushStats();
+  }
+  c->owner = this;
+  c->live = 0;
+  c->kind = kind;
+  return(c);
+}
+
+void * nodeArena::carve(nodeChunk * & list, char * & at, size_t size, int kind)
+{
+  if (list == 0L || at + size > (char *) list + chunkBytes) {
+    push(list, newChunk(kind));
+    at = (char *) list + headerBytes;
+  }
+  void * node = at;
+  at += size;
+  list->live++;
+  return(node);
+}
+
+void nodeArena::recycle(nodeChunk * c)
+{
+  if (spares < maxSpares) {
+    push(spare, c);
+    spares++;
+  } else free(c);
+}
+
+/************************************************************************
+ * allocate(size)  a node of size bytes, from the scratch chunks if a	*
+ *	scratchNodes is in scope, else from those of the problem	*
+ ************************************************************************/
+void * nodeArena::allocate(size_t size)
+{
+  size = (size + 7) & ~(size_t) 7;
+  int k = size / 8 - 1;
+  if (k >= classes) throw(string("expression node too big for nodeArena"));
+  if (anyReturned.load(memory_order_acquire)) takeReturned();
+  made++;
+  if (scratchDepth > 0 && problemDepth == 0) {
+    if (freeScratch[k] == 0L)
+      return(carve(scratch, scratchNext, size, scratchChunk));
+    void * node = pop(freeScratch[k]);
+    chunkOf(node)->live++;
+    return(node);
+  }
+  if (freeNodes[k] == 0L) return(carve(chunks, next, size, problemChunk));
+  void * node = pop(freeNodes[k]);
+  chunkOf(node)->live++;
+  return(node);
+}
+
+/************************************************************************
+ * release(node, size)  frees a node made by allocate, into its own	*
+ *	arena if that is the current one, else onto its returned list	*
+ ************************************************************************/
+void nodeArena::release(void * node, size_t size)
+{
+  nodeChunk * c = chunkOf(node);
+  int k = ((size + 7) & ~(size_t) 7) / 8 - 1;
+  if (c->owner == solverContext()->nodes) c->owner->takeBack(c, node, k);
+  else c->owner->giveBack(node, k);
+}
+
+// node, of size class k, is free again in chunk c of this arena
+void nodeArena::takeBack(nodeChunk * c, void * node, int k)
+{
+  c->live--;
+  switch (c->kind) {
+  case problemChunk:
+    pushNode(freeNodes[k], node);
+    return;
+  case scratchChunk:
+    pushNode(freeScratch[k], node);
+    return;
+  case keptChunk:
+    if (c->live == 0) {
+      unlink(kept, c);
+      recycle(c);
+    }
+    return;
+  }
+}
+
+// node, of size class k, was freed by a thread that may not own this arena
+void nodeArena::giveBack(void * node, int k)
+{
+  lock_guard<mutex> guard(returnedLock);
+  pushNode(returned[k], node);
+  anyReturned.store(true, memory_order_release);
+  foreignFrees.fetch_add(1, relaxed);
+}
+
+// takes back the nodes on the returned lists
+void nodeArena::takeReturned()
+{
+  void * back[classes];
+  {
+    lock_guard<mutex> guard(returnedLock);
+    for (int k = 0; k < classes; k++) {
+      back[k] = returned[k];
+      returned[k] = 0L;
+    }
+    anyReturned.store(false, memory_order_relaxed);
+  }
+  for (int k = 0; k < classes; k++)
+    while (back[k]) {
+      void * node = pop(back[k]);
+      takeBack(chunkOf(node), node, k);
+    }
+}
+
+/************************************************************************
+ * endScratch  takes back the scratch chunks, when the outermost 	*
+ *	scratchNodes ends						*
+ ************************************************************************/
+void nodeArena::endScratch()
+{
+  // a scratch node freed elsewhere counts in its chunk until taken back
+  if (anyReturned.load(memory_order_acquire)) takeReturned();
+  while (scratch) {
+    nodeChunk * c = scratch;
+    unlink(scratch, c);
+    if (c->live == 0) recycle(c);
+    else {
+      c->kind = keptChunk;
+      push(kept, c);
+      chunksKept.fetch_add(1, relaxed);
+    }
+  }
+  scratchNext = 0L;
+  for (int k = 0; k < classes; k++) freeScratch[k] = 0L;
+  scratchScopes.fetch_add(1, relaxed);
+  flushStats();
+}
+
+scratchNodes::scratchNodes() : arena(solverContext()->nodes)
+{
+  arena->scratchDepth++;
+}
+
+scratchNodes::~scratchNodes()
+{
+  if (--arena->scratchDepth == 0) arena->endScratch();
+}
+
+problemNodes::problemNodes() : arena(solverContext()->nodes)
+{
+  arena->problemDepth++;
+}
+
+problemNodes::~problemNodes()
+{
+  arena->problemDepth--;
+}
+
+/************************************************************************
+ * expr::operator new, delete  nodes come from the current context	*
+ ************************************************************************/
+void * expr::operator new(size_t size)
+{
+  return(solverContext()->nodes->allocate(size));
+}
+
+void expr::operator delete(void * node, size_t size)
+{
+  nodeArena::release(node, size);
+}
+
+/************************************************************************
+ * nodeStatsReport  the counters as an entry of solverStats:		*
+ *	(expression-nodes :made 51234 :chunks 12 :reused 40		*
+ *	 :scratch-scopes 300 :kept 2 :foreign-frees 0 :copies 900)	*
+ *	made counts the nodes, each of which was once a heap allocation,*
+ *	and chunks the heap allocations made for them now.		*
+ *	foreign-frees counts the nodes freed with another context	*
+ *	current, and copies the calls of copyexpr.			*
+ ************************************************************************/
+string nodeStatsReport()
+{
+  solverContext()->nodes->flushStats();
+  ostringstream out;
+  out << "(expression-nodes :made " << nodesMade.load(relaxed)
+      << " :chunks " << chunksMade.load(relaxed)
+      << " :reused " << chunksReused.load(relaxed)
+      << " :scratch-scopes " << scratchScopes.load(relaxed)
+      << " :kept " << chunksKept.load(relaxed)
+      << " :foreign-frees " << foreignFrees.load(relaxed)
+      << " :copies " << treesCopied.load(relaxed) << ")";
+  return(out.str());
+}
+
+void nodeStatsReset()
+{
+  solverContext()->nodes->flushStats();
+  nodesMade = 0;
+  chunksMade = 0;
+  chunksReused = 0;
+  scratchScopes = 0;
+  chunksKept = 0;
+  foreignFrees = 0;
+  treesCopied = 0;
+}
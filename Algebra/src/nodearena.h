@@ -0,0 +1,104 @@
+// nodearena.h	where expression nodes are kept, see nodearena.cpp
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+/************************************************************************
+ * The nodes of expressions (everything derived from expr) are made by	*
+ *	new and freed by delete or destroy() as always, but they come	*
+ *	from the nodeArena of the current SolverContext rather than the	*
+ *	heap. While a scratchNodes is in scope, new nodes come from	*
+ *	scratch chunks instead, which are taken back whole when the	*
+ *	outermost scratchNodes ends:					*
+ *	  scratchNodes scratch;		// in checkeqs, powersolve, ...	*
+ *   A scratch chunk still holding a node then (one that was put into	*
+ *	the problem, such as a solution kept in a student slot) is kept	*
+ *	until its last node is freed, so nothing is taken back while a	*
+ *	node in it may still be used. Code storing a new tree in the	*
+ *	problem while a scratchNodes may be in scope can say so with 	*
+ *	problemNodes, so it doesn't hold a scratch chunk.		*
+ ************************************************************************/
+#ifndef NODEARENA_INCLUDED
+#define NODEARENA_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+struct nodeChunk;
+
+class nodeArena
+{
+public:
+  nodeArena();
+  ~nodeArena();				// frees every chunk
+  void * allocate(size_t size);
+  static void release(void * node, size_t size);
+  void flushStats();			// adds what it made to the counters
+  void copied() { copies++; }		// by copyexpr, for the counters
+
+private:
+  friend class scratchNodes;
+  friend class problemNodes;
+  static const int classes = 9;		// of 8, 16, ..., 72 bytes
+
+  nodeChunk * newChunk(int kind);
+  void * carve(nodeChunk * & chunk, char * & next, size_t size, int kind);
+  void endScratch();
+  void recycle(nodeChunk * chunk);
+  void takeBack(nodeChunk * chunk, void * node, int k);
+  void giveBack(void * node, int k);
+  void takeReturned();
+
+  void * freeNodes[classes];		// freed nodes, ready for reuse
+  void * freeScratch[classes];		// freed in the current scratch scope
+  void * returned[classes];		// freed with another context current
+  std::mutex returnedLock;		// guards returned
+  std::atomic<bool> anyReturned;
+  nodeChunk * chunks;			// holding nodes of the problem
+  nodeChunk * scratch;			// of the current scratch scope
+  nodeChunk * kept;			// scratch chunks still in use
+  nodeChunk * spare;			// empty, ready to be used again
+  char * next, * scratchNext;		// where the next node is carved
+  int spares;
+  int scratchDepth, problemDepth;
+  unsigned long made;			// nodes not yet counted in the stats
+  unsigned long copies;			// trees copied, likewise
+};
+
+class scratchNodes
+{
+public:
+  scratchNodes();
+  ~scratchNodes();
+private:
+  nodeArena * arena;
+};
+
+class problemNodes
+{
+public:
+  problemNodes();
+  ~problemNodes();
+private:
+  nodeArena * arena;
+};
+
+std::string nodeStatsReport();		// for solverStats
+void nodeStatsReset();
+
+#endif
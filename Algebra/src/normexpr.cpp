@@ -93,7 +93,7 @@ void kmult(expr * & ex, numvalexp * nv)
   retexp = (n_opexp * ) ex;
   
   // if doesn't begin with numval, just add factor:
-  if (retexp->args->size() == 0 || (*retexp->args)[0]->etype != numval) 
+  if (retexp->args.size() == 0 || retexp->args[0]->etype != numval) 
     {
       retexp->addarg(nv);
       cleanup(retexp);
@@ -103,8 +103,8 @@ void kmult(expr * & ex, numvalexp * nv)
       return;
     }
   // else multiplication begins with numval: multiply by factor
-  ((numvalexp *)(*retexp->args)[0])->value *= nv->value;
-  (*retexp->args)[0]->MKS += nv->MKS; // Update units of numval.
+  ((numvalexp *)retexp->args[0])->value *= nv->value;
+  retexp->args[0]->MKS += nv->MKS; // Update units of numval.
   retexp->MKS += nv->MKS; // Update units of the multiply.
   nv->destroy();
   DBG( cout << "kmult returns " << ex->getInfix()<< endl);
@@ -144,7 +144,7 @@ numvalexp * normexpr(expr * & ex)
   n_opexp * nopptr;
   functexp * fptr;
 #ifdef WITHDBG // for debugging
-  static int normcall=0;    
+  static thread_local int normcall=0;    
   int thiscall=normcall++;  
 #endif
 
@@ -200,7 +200,7 @@ numvalexp * normexpr(expr * & ex)
 		  return(answer);
 		}
 	      cleanup(argnop);
-	      if (argnop->args->size() == 0) // did cleanup make 0?
+	      if (argnop->args.size() == 0) // did cleanup make 0?
 		{
 		  ex = new numvalexp(0);
 		  answer = new numvalexp(1.);
@@ -209,12 +209,12 @@ numvalexp * normexpr(expr * & ex)
 		      << ex->getInfix() << endl); 
 		  return(answer);
 		}
-	      if ((*argnop->args)[0]->etype == numval)
+	      if (argnop->args[0]->etype == numval)
 		{
 		  answer = new numvalexp(
-					 exp(((numvalexp *)(*argnop->args)[0])->value));
+					 exp(((numvalexp *)argnop->args[0])->value));
 		  answer->MKS.put(0,0,0,0,0);
-		  ((numvalexp *)(*argnop->args)[0])->value = 0;
+		  ((numvalexp *)argnop->args[0])->value = 0;
 		  fptr->arg = argnop; // I don't know, it could have changed
 		  flatten(fptr->arg);
 		  DBG(cout << "normexpr call " << thiscall << " returning " 
@@ -355,14 +355,14 @@ numvalexp * normexpr(expr * & ex)
 #if 0
       DBG( cout << "n_op cleaned up in normexpr " << ex->getInfix() << endl;);
 #endif
-      if (nopptr->args->size()==0)
+      if (nopptr->args.size()==0)
 	throw(string("I didn't think null n_op could occur in normfact"));
       if (nopptr->op->opty == multe)
 	{
 #if 0
 	  DBG( cout << "n_op is multe in normexpr " << endl; );
 #endif
-	  if ((*nopptr->args)[0]->etype != numval) 
+	  if (nopptr->args[0]->etype != numval) 
 	    {
 	      ex = nopptr;
 	      answer = new numvalexp(1.);
@@ -373,10 +373,10 @@ numvalexp * normexpr(expr * & ex)
 	    }
 	  else
 	    {
-	      answer = (numvalexp *)(*nopptr->args)[0];
-	      for (k=0; k+1<nopptr->args->size(); k++)
-		(*nopptr->args)[k] = (*nopptr->args)[k+1];
-	      nopptr->args->pop_back();
+	      answer = (numvalexp *)nopptr->args[0];
+	      for (k=0; k+1<nopptr->args.size(); k++)
+		nopptr->args[k] = nopptr->args[k+1];
+	      nopptr->args.pop_back();
 	      nopptr->MKS += answer->MKS * -1.; // BvdS: adjust units, too
 	      ex = nopptr;
 	      eqnumsimp(ex,true);
@@ -387,7 +387,7 @@ numvalexp * normexpr(expr * & ex)
 	}
       else			// must be plus
 	{
-	  expr * tempexp = copyexpr((*nopptr->args)[0]);
+	  expr * tempexp = copyexpr(nopptr->args[0]);
 	  answer = normexpr(tempexp);
 	  tempexp->destroy();
 	  ex = nopptr;
@@ -423,7 +423,7 @@ bool uptonum(const expr * const ans, const expr * const term,
 {				
   bool answer;
 #ifdef WITHDBG // for debugging
-  static int call=0;    
+  static thread_local int call=0;    
   int thiscall=call++;  
 #endif
 
@@ -145,10 +145,10 @@ int numfactorsof(const expr * factor,const expr * expression)
       nopexpr = (n_opexp *) expression;
       if (nopexpr->op->opty == pluse)
   	{
-	  if (nopexpr->args->size() == 0) return(0);
-  	  q = numfactorsof(factor, (*nopexpr->args)[0]);
-  	  for (k=1; k < nopexpr->args->size(); k++)
-  	    q = min(q,numfactorsof(factor, (*nopexpr->args)[k]));
+	  if (nopexpr->args.size() == 0) return(0);
+  	  q = numfactorsof(factor, nopexpr->args[0]);
+  	  for (k=1; k < nopexpr->args.size(); k++)
+  	    q = min(q,numfactorsof(factor, nopexpr->args[k]));
 	  DBG(cout << "NUMFACT " << thisdbg << " returning " << q 
 	      << " on numval factor of n_op +";);
   	  return(q);
@@ -156,8 +156,8 @@ int numfactorsof(const expr * factor,const expr * expression)
       if (nopexpr->op->opty == multe)
   	{				// this doesn't treat returns of -1
   	  q = 0;			// properly
-	  for (k=0; k < nopexpr->args->size(); k++)
-	    q += numfactorsof(factor, (*nopexpr->args)[k]);
+	  for (k=0; k < nopexpr->args.size(); k++)
+	    q += numfactorsof(factor, nopexpr->args[k]);
 	  DBG( cout << "NUMFACT " << thisdbg << " returning " << q 
 	       << " on numval factor of n_op *";);
   	  return(q);
@@ -240,14 +240,14 @@ int numfactorsof(const expr * factor,const expr * expression)
       return(0);		// only binops considered are ^ and / and =
     case n_op:				// physvar factor of n_op?
       nopexpr = (n_opexp *) expression;
-      if (nopexpr->args->size() == 0) return(0);
+      if (nopexpr->args.size() == 0) return(0);
       if (nopexpr->op->opty == pluse)
   	{
 	  DBG(cout << "NUMFACT " << thisdbg << " physvar on " 
 	      << nopexpr->getInfix() << endl;);
-  	  q = numfactorsof(factor, (*nopexpr->args)[0]);
-  	  for (k=1; k < nopexpr->args->size(); k++)
-  	    q = min(q,numfactorsof(factor, (*nopexpr->args)[k]));
+  	  q = numfactorsof(factor, nopexpr->args[0]);
+  	  for (k=1; k < nopexpr->args.size(); k++)
+  	    q = min(q,numfactorsof(factor, nopexpr->args[k]));
 	  DBG( cout << "NUMFACT " << thisdbg << " returning " << q 
 		 <<" on physvar factor of n_op +" << endl;);
   	  return(q);
@@ -257,8 +257,8 @@ int numfactorsof(const expr * factor,const expr * expression)
 	  DBG( cout << "NUMFACT " << thisdbg << " physvar on " 
 	       << nopexpr->getInfix() << endl;);
   	  q = 0;
-	  for (k=0; k < nopexpr->args->size(); k++)
-	    q += numfactorsof(factor, (*nopexpr->args)[k]);
+	  for (k=0; k < nopexpr->args.size(); k++)
+	    q += numfactorsof(factor, nopexpr->args[k]);
 	  DBG( cout << "NUMFACT " << thisdbg << " returning " << q 
 		 << " on physvar factor of n_op *" << endl;);
   	  return(q);
@@ -308,16 +308,16 @@ int numfactorsof(const expr * factor,const expr * expression)
       nopexpr = (n_opexp *) expression;
       if (nopexpr->op->opty == pluse)
   	{
-  	  q = numfactorsof(factor, (*nopexpr->args)[0]);
-  	  for (k=1; k < nopexpr->args->size(); k++)
-  	    q = min(q,numfactorsof(factor, (*nopexpr->args)[k]));
+  	  q = numfactorsof(factor, nopexpr->args[0]);
+  	  for (k=1; k < nopexpr->args.size(); k++)
+  	    q = min(q,numfactorsof(factor, nopexpr->args[k]));
   	  return(q);
   	}
       if (nopexpr->op->opty == multe)
   	{
   	  q = 0;
-	  for (k=0; k < nopexpr->args->size(); k++)
-	    q += numfactorsof(factor, (*nopexpr->args)[k]);
+	  for (k=0; k < nopexpr->args.size(); k++)
+	    q += numfactorsof(factor, nopexpr->args[k]);
   	  return(q);
   	}
       throw(string("unknown n_op as expression in numfactorsof"));
@@ -367,8 +367,8 @@ int numfactorsof(const expr * factor,const expr * expression)
       nopexpr = (n_opexp *) expression;
       if (nopexpr->op->opty != multe) return(0);
       q = 0;
-      for (k=0; k < nopexpr->args->size(); k++)
-	q += numfactorsof(factor,(*nopexpr->args)[k]);
+      for (k=0; k < nopexpr->args.size(); k++)
+	q += numfactorsof(factor,nopexpr->args[k]);
       return(q);
     case unknown:
     case fake:
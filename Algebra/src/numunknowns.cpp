@@ -22,6 +22,52 @@
 using namespace std;
 // no diagnostics
 
+/************************************************************************
+ * varsseen   the variables numunknowns has already put on varl. Most	*
+ *	equations have only a few, so while varl is short it is simply	*
+ *	searched; once it has linearMax, they are put in a bitset, one	*
+ *	bit per varindx, so each physvar found is checked at once.	*
+ ************************************************************************/
+class varsseen
+{
+ public:
+  varsseen(const vector<varindx> & varl) : varl(varl), indexed(false) { }
+  bool add(varindx v) {		// false if v was already seen
+    if (!indexed) {
+      if (varl.size() < linearMax) {
+	for (size_t k = 0; k < varl.size(); k++) if (varl[k] == v) return(false);
+	return(true);
+      }
+      indexed = true;
+      for (size_t k = 0; k < varl.size(); k++) mark(varl[k]);
+    }
+    return(mark(v));
+  }
+ private:
+  bool mark(varindx v) {	// false if v was already marked
+    if (v < 0) {
+      for (size_t k = 0; k < negs.size(); k++) if (negs[k] == v) return(false);
+      negs.push_back(v);
+      return(true);
+    }
+    size_t w = v / wordbits;
+    if (w >= words.size()) words.resize(w + 1, 0UL);
+    unsigned long bit = 1UL << (v % wordbits);
+    if (words[w] & bit) return(false);
+    words[w] |= bit;
+    return(true);
+  }
+  static const size_t linearMax = 16;
+  static const int wordbits = 8 * sizeof(unsigned long);
+  const vector<varindx> & varl;	// which the caller adds v to, if new
+  bool indexed;			// the bitset holds all of varl
+  vector<unsigned long> words;
+  vector<varindx> negs;		// physvarptrs not (yet) given a var
+};
+
+static int countunknowns(const expr * eq, vector<varindx> & varl,
+			 varsseen & seen, const bool chkknown);
+
 /************************************************************************
  * int numunknowns(expr * eq, vector<int> & varl,const bool chkknown)	*
  *	returns number of  unknown vars in equation, and adds any	*
@@ -30,6 +76,13 @@ using namespace std;
 //  NOTE: we need to rething what it means to be known. 
 
 int numunknowns(expr * eq, vector<varindx> & varl, const bool chkknown)
+{
+  varsseen seen(varl);
+  return(countunknowns(eq, varl, seen, chkknown));
+}
+
+static int countunknowns(const expr * eq, vector<varindx> & varl,
+			 varsseen & seen, const bool chkknown)
 {		
   int k, indx;	
   switch (eq->etype)
@@ -42,20 +95,20 @@ int numunknowns(expr * eq, vector<varindx> & varl, const bool chkknown)
     case physvart:
       if (chkknown && ((physvarptr *) eq)->known) return(0);
       indx = ((physvarptr *) eq)->varindex;
-      for (k=0; k < varl.size(); k++) if (indx == varl[k]) return(0);
+      if (!seen.add(indx)) return(0);
       varl.push_back(indx);
       return(1);
     case binop:
-      return(numunknowns(((binopexp *)eq)->lhs, varl, chkknown)
-	     + numunknowns(((binopexp *)eq)->rhs, varl, chkknown));
+      return(countunknowns(((binopexp *)eq)->lhs, varl, seen, chkknown)
+	     + countunknowns(((binopexp *)eq)->rhs, varl, seen, chkknown));
     case function:
-      return(numunknowns(((functexp *) eq)->arg, varl, chkknown));
+      return(countunknowns(((functexp *) eq)->arg, varl, seen, chkknown));
     case n_op:
       {
 	n_opexp * thexp = (n_opexp *) eq;
 	int val=0;
-	for (k=0; k < thexp->args->size(); k++)
-	  val += numunknowns((*thexp->args)[k], varl, chkknown);
+	for (k=0; k < thexp->args.size(); k++)
+	  val += countunknowns(thexp->args[k], varl, seen, chkknown);
       return(val);
       }
     default:
@@ -63,4 +116,3 @@ int numunknowns(expr * eq, vector<varindx> & varl, const bool chkknown)
     }
   throw("got to impossible place in numunknowns");
 }
-
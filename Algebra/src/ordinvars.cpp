@@ -28,22 +28,58 @@
  ************************************************************************/
 #include "decl.h"
 #include <math.h>
+#include <algorithm>
 #include "dbg.h"
 using namespace std;
 
 #define DBG(A) DBGF(ORDUNK,A)
 
+// the orders of the variables in a subexpression, as (place in vars,
+// order) by increasing place, leaving out those it doesn't have
+typedef vector<pair<int,int> > sparseords;
+
+static bool ordsof(const expr * ex, const vector<int> & where,
+		   sparseords & orders);
+static void combineords(sparseords & all, const size_t parts, const bool add,
+			sparseords & orders);
+
 bool ordinvars(const expr * ex, const vector<varindx> * vars, 
 	       vector<int> * & orders)
 {
-  n_opexp *thnop;
-  binopexp *thbin;
-  int k, q;
+  int k;
 
   DBG( cout << "Entering ordinvars with " <<  ex->getInfix() << endl; );
   if (orders != NULL)
     throw(string("ordinvars called with non-null orders"));
-  vector<int> * rorders = NULL;
+  // where[v] is the place of variable v in vars, so each physvar
+  // met is found at once rather than by searching vars.
+  vector<int> where;
+  for (k = vars->size() - 1; k >= 0; k--)
+    {
+      varindx v = (*vars)[k];
+      if (v < 0) continue;
+      if ((size_t) v >= where.size()) where.resize(v + 1, -1);
+      where[v] = k;
+    }
+  sparseords found;
+  if (!ordsof(ex, where, found)) return(false);
+  orders = new vector<int>(vars->size(),0);
+  for (size_t f = 0; f < found.size(); f++)
+    (*orders)[found[f].first] = found[f].second;
+  return(true);
+}
+
+/************************************************************************
+ * ordsof  does the work of ordinvars, appending the orders of ex to	*
+ *	orders, at most once for each variable. Each node costs only as	*
+ *	much as the variables below it, rather than the length of vars.	*
+ ************************************************************************/
+static bool ordsof(const expr * ex, const vector<int> & where,
+		   sparseords & orders)
+{
+  n_opexp *thnop;
+  binopexp *thbin;
+  int k, q;
 
  switch (ex->etype)
     {
@@ -51,16 +87,13 @@ bool ordinvars(const expr * ex, const vector<varindx> * vars,
     case fake:
       throw("ordinvars called on unknown or fake expr");
     case numval:
-      DBG( cout << "ordinvars entering numval"<<endl; );
-      orders = new vector<int>(vars->size(),0);
-      DBG( cout << "ordinvars numval return"<<endl; );
       return(true);
     case physvart:
-      orders = new vector<int>(vars->size(),0);
-      for (k=0; k < vars->size(); k++)
-	if ((*vars)[k] == ((physvarptr *)ex)->varindex) 
-	  { (*orders)[k] = 1; return(true); }
-      throw(string("ordinvars called with physvar not on vars list"));
+      k = ((physvarptr *)ex)->varindex;
+      if ((k < 0) || ((size_t) k >= where.size()) || (where[k] < 0))
+	throw(string("ordinvars called with physvar not on vars list"));
+      orders.push_back(make_pair(where[k], 1));
+      return(true);
     case binop:
       thbin = (binopexp *) ex;
       switch (thbin->op->opty)
@@ -68,63 +101,50 @@ bool ordinvars(const expr * ex, const vector<varindx> * vars,
 	case equalse:
 	case grte:
 	case gree:
-	    if (!ordinvars(thbin->lhs,vars,rorders)) return(false);
-	    if (!ordinvars(thbin->rhs,vars,orders)) 
-	      {
-		delete rorders;
-		rorders = NULL;
-		return(false);
-	      }
-	    for (k=0; k < vars->size(); k++)
-	      if ((*rorders)[k] > (*orders)[k]) (*orders)[k] = (*rorders)[k];
-	    delete rorders;
-	    rorders = NULL;
+	  {
+	    sparseords all;
+	    if (!ordsof(thbin->lhs,where,all)) return(false);
+	    if (!ordsof(thbin->rhs,where,all)) return(false);
+	    combineords(all,2,false,orders);
 	    return(true);
+	  }
 	case divbye:
 	  if (thbin->rhs->etype != numval) return(false);
-	  else return(ordinvars(thbin->lhs,vars,orders));
+	  else return(ordsof(thbin->lhs,where,orders));
 	case topowe:
 	  if (thbin->rhs->etype != numval) return(false);
 	  if (!lookslikeint(((numvalexp *)thbin->rhs)->value, q))
 	    return(false);
-	  if (!ordinvars(thbin->lhs,vars,orders)) return(false);
-	  for (k=0; k < vars->size(); k++) (*orders)[k] *= q;
+	  {
+	    size_t first = orders.size();
+	    if (!ordsof(thbin->lhs,where,orders)) return(false);
+	    for (size_t j = first; j < orders.size(); j++) orders[j].second *= q;
+	  }
 	  return(true);
 	default:
 	  break;  // goto error below
 	} // end of switch on binop type
       break;
     case n_op:
-      DBG( cout << "ordinvars entering n_op"<<endl; );
-      thnop = (n_opexp *) ex;
-      orders = new vector<int>(vars->size(),0);
-      for (k=0; k < thnop->args->size(); k++)
-	{
-	  DBG( cout << "ordinvars will call arg "<< k<<endl; );
-	  if (!ordinvars((*thnop->args)[k],vars,rorders))
-	    {
-	      DBG( cout << "arg "<< k <<" gave false"<<endl; );
-	      delete orders;
-	      orders = NULL;
-	      return(false);
-	    }
-	  DBG( { cout << "arg "<< k <<" gave true" << endl;
-		 cout << "orders and rorders have sizes " << endl;
-		 cout << orders->size() << " and " << endl;
-		 cout << rorders->size() << endl; } ) ;
-	  for (q=0; q < vars->size(); q++)
-	    {
-	      if (thnop->op->opty == pluse) {
-		if ((*rorders)[q] > (*orders)[q]) (*orders)[q] = (*rorders)[q];
+      {
+	DBG( cout << "ordinvars entering n_op"<<endl; );
+	thnop = (n_opexp *) ex;
+	if ((thnop->op->opty != pluse) && (thnop->op->opty != multe))
+	  throw(string("unknown n_op in ordinvars"));
+	sparseords all;			// those of each arg in turn
+	for (k=0; k < thnop->args.size(); k++)
+	  {
+	    DBG( cout << "ordinvars will call arg "<< k<<endl; );
+	    if (!ordsof(thnop->args[k],where,all))
+	      {
+		DBG( cout << "arg "<< k <<" gave false"<<endl; );
+		return(false);
 	      }
-	      else if (thnop->op->opty == multe)
-		(*orders)[q] += (*rorders)[q];
-	      else throw(string("unknown n_op in ordinvars"));
-	    }
-	  delete rorders;
-	  rorders = NULL;
-	}
-      return(true);
+	  }
+	// as before, a sum is never of lower order than 0 in a variable
+	combineords(all,thnop->args.size() + 1,thnop->op->opty == multe,orders);
+	return(true);
+      }
     case function:
       return(false);
     default:
@@ -133,3 +153,24 @@ bool ordinvars(const expr * ex, const vector<varindx> * vars,
  throw(string("got to impossible place in ordinvars"));
 }
 
+/************************************************************************
+ * combineords  sets orders from all, the orders of parts subexpressions *
+ *	one after the other, adding those of each variable if add (for *
+ *	a product), otherwise taking the largest (for a sum or 	*
+ *	equation), where a subexpression without the variable has	*
+ *	order 0.							*
+ ************************************************************************/
+static void combineords(sparseords & all, const size_t parts, const bool add,
+			sparseords & orders)
+{
+  size_t j, k;
+  sort(all.begin(), all.end());
+  for (j = 0; j < all.size(); j = k)
+    {
+      int ord = all[j].second;
+      for (k = j + 1; (k < all.size()) && (all[k].first == all[j].first); k++)
+	ord = add ? ord + all[k].second : max(ord, all[k].second);
+      if (!add && (k - j < parts)) ord = max(ord, 0);
+      orders.push_back(make_pair(all[j].first, ord));
+    }
+}
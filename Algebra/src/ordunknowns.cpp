@@ -95,11 +95,11 @@ int ordunknowns(const expr * eq, const bool chkknown)
       thnop = (n_opexp *) eq;
       ans = 0;
       if (thnop->op->opty == pluse)
-	for (k=0; k < thnop->args->size(); k++)
-	  ans = max(ans,ordunknowns((*thnop->args)[k], chkknown));
+	for (k=0; k < thnop->args.size(); k++)
+	  ans = max(ans,ordunknowns(thnop->args[k], chkknown));
       else if (thnop->op->opty == multe)
-	for (k=0; k < thnop->args->size(); k++)
-	  ans += ordunknowns((*thnop->args)[k], chkknown);
+	for (k=0; k < thnop->args.size(); k++)
+	  ans += ordunknowns(thnop->args[k], chkknown);
       else throw("n_op neither plus or mult in ordunknowns");
       if (ans>3) return(3);
       else return(ans);
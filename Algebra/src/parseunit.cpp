@@ -29,9 +29,9 @@
 
 #define DBG(A) DBGF(GETEQS,A)
 
-extern unitabrs unittable;
-extern vector<string> * constnames;
-extern vector<numvalexp *> * constnumvals;
+extern const unitabrs unittable;
+extern const vector<string> * constnames;
+extern const vector<numvalexp *> * constnumvals;
 double geterr(const string value); // below
 
 /************************************************************************
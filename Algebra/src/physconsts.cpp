@@ -28,8 +28,8 @@ using namespace std;
 
 #define DBG(A) DBGF(UNITS,A)
 
-extern vector<string> * constnames;
-extern vector<numvalexp *> * constnumvals;
+extern const vector<string> * constnames;
+extern const vector<numvalexp *> * constnumvals;
 
 struct physc {
   string name;
@@ -47,18 +47,28 @@ struct physc {
 #include "pconsts.h"
 };
 
+/************************************************************************
+ * constsfill  makes the table of constants from pctab. It is called	*
+ *	once before main, by constsfilled below, and later calls do	*
+ *	nothing, so the table never changes while threads may read it.	*
+ ************************************************************************/
 void constsfill()
 {
-  string name;
-  dimens dim;
-  constnames = new vector<string>;
-  constnumvals = new vector<numvalexp *>;
+  if (constnames != 0L) return;
+  vector<string> * names = new vector<string>;
+  vector<numvalexp *> * numvals = new vector<numvalexp *>;
   numvalexp * thisnumval;
   for (int k = 0; k < Asize(pctab); k++) {
-    constnames->push_back(pctab[k].name);
+    names->push_back(pctab[k].name);
     thisnumval = new numvalexp(pctab[k].value);
     thisnumval->MKS.put(pctab[k].lenu, pctab[k].massu, pctab[k].secu,
 	    pctab[k].chgu, pctab[k].ku);
-    constnumvals->push_back(thisnumval);
+    numvals->push_back(thisnumval);
   }
-}		 
+  constnames = names;
+  constnumvals = numvals;
+}
+
+static struct constsfiller {
+  constsfiller() { constsfill(); }
+} constsfilled;		 
@@ -23,7 +23,7 @@
 using namespace std;
 
 #define DBG(A) DBGF(PLUSSORT,A)
-void qsrtexpr(vector<expr *> *Vptr);
+void qsrtexpr(exprlist *Vptr);
 
 
 /************************************************************************
@@ -41,7 +41,7 @@ bool plussort(expr * & ex)
   if (ex->etype != n_op) throw(string("plussort called on non-n_op"));
   if (((n_opexp *)ex)->op->opty != pluse)
     throw(string("plussort called on non-plus n_op"));
-  vector<expr *> *v = ((n_opexp *)ex)->args;
+  exprlist *v = &((n_opexp *)ex)->args;
   DBG(cout << "Plussort about to call qsrtexpr" << endl;);
   qsrtexpr(v);
   DBG(cout << "Plussort after sort, " << ex->getInfix() << endl;);
@@ -103,18 +103,18 @@ bool plussort(expr * & ex)
 		}	// end of not mult
 	      else		// is already a mult
 		{
-		  if ( (*((n_opexp *)(*v)[q+1])->args)[0]->etype != numval)
+		  if ( ((n_opexp *)(*v)[q+1])->args[0]->etype != numval)
 		    {		// need to add arg at front of list, move rest
 		      DBG(cout << "Plussort needs to add numval to args of " 
 			  << (*v)[q+1]->getInfix() << endl;);
-		      vector<expr *> *targs = ((n_opexp *)(*v)[q+1])->args;
+		      exprlist *targs = &((n_opexp *)(*v)[q+1])->args;
 		      targs->push_back((*targs)[targs->size()-1]);
 		      for (k = ((int)targs->size()) -2; k > 0; k--)
 			(*targs)[k] = (*targs)[k-1];
 		      (*targs)[0] = new numvalexp(addfact->value+1.);
 		      (*targs)[0]->MKS.put(0,0,0,0,0); // added 12/10/01 JaS
 		    } // end of needed to add a numval to mult
-		  else ((numvalexp *)(*((n_opexp *)(*v)[q+1])->args)[0])->value
+		  else ((numvalexp *)((n_opexp *)(*v)[q+1])->args[0])->value
 			 *= addfact->value + 1.;
 		} // was already a mult
 	      (*v)[q]->destroy();
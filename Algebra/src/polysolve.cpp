@@ -128,8 +128,9 @@ vector<double> *slvpolyexpr(const expr * eq, varindx var)
   expr * eqcpy = copyexpr(eq);
   numvalexp * temp=normexpr(eqcpy);
   if(temp) temp->destroy(); //stop memory leak
-  if (!polyexpand(((binopexp *)eqcpy)->lhs,var,poly))
-    return(poly);
+  bool expanded = polyexpand(((binopexp *)eqcpy)->lhs,var,poly);
+  eqcpy->destroy();
+  if (!expanded) return(poly);
   vector<double> * answer = findallroots(poly);
   delete poly;
   return(answer);
@@ -189,8 +190,8 @@ bool polyexpand(const expr * ex,varindx var,vector<double> * & coefs)
 	if (nopex->op->opty == multe)
 	  {
 	    (*polyt)[0] = 1.;
-	    for (k = 0; k < nopex->args->size(); k++)
-	      if (!polyexpand((*nopex->args)[k],var,polya))
+	    for (k = 0; k < nopex->args.size(); k++)
+	      if (!polyexpand(nopex->args[k],var,polya))
 		{ delete polyt; return(false); }
 	      else 
 		{
@@ -204,8 +205,8 @@ bool polyexpand(const expr * ex,varindx var,vector<double> * & coefs)
 	else			// n_op is plus
 	  {
 	    (*polyt)[0]=0.;
-	    for (k = 0; k < nopex->args->size(); k++)
-	      if (!polyexpand((*nopex->args)[k],var,polya))
+	    for (k = 0; k < nopex->args.size(); k++)
+	      if (!polyexpand(nopex->args[k],var,polya))
 		{ delete polyt; return(false); }
 	      else 
 		{
@@ -85,11 +85,11 @@ int powonev(const expr * eq, const varindx var)
       thnop = (n_opexp *) eq;
       ans = 0;
       if (thnop->op->opty == pluse)
-	for (k=0; k < thnop->args->size(); k++)
-	  ans = max(ans,powonev((*thnop->args)[k],var));
+	for (k=0; k < thnop->args.size(); k++)
+	  ans = max(ans,powonev(thnop->args[k],var));
       else if (thnop->op->opty == multe)
-	for (k=0; k < thnop->args->size(); k++)
-	  ans += powonev((*thnop->args)[k],var);
+	for (k=0; k < thnop->args.size(); k++)
+	  ans += powonev(thnop->args[k],var);
       else throw("n_op neither plus or mult in powonev");
       if (ans>3) return(3);
       else return(ans);
@@ -97,8 +97,8 @@ bool purelinsolv(vector<binopexp *> const * eqs,
 	    break;
 	  }
 	}
-	for (q=0; q < lhs->args->size(); q++)
-	  if (!doterm((*lhs->args)[q],A[k],vars)) 
+	for (q=0; q < lhs->args.size(); q++)
+	  if (!doterm(lhs->args[q],A[k],vars)) 
 	    throw(string("lhs of eq has term not OK, in purelinsolv"));
 	break;
       case numval:
@@ -328,23 +328,23 @@ bool doterm(const expr * term, double * A, const vector<varindx> * vars)
 	n_opexp * termnop = (n_opexp *)term;
 	if (termnop->op->opty == pluse)
 	  throw(string("term in sum is sum, not OK in doterm"));
-	switch (termnop->args->size())
+	switch (termnop->args.size())
 	  {
 	  case 0:
 	    A[vars->size()] -= 1.; // null product is 1
 	    return(true);
 	  case 1:
-	    if ((q = findwhichvar((*termnop->args)[0],vars)) < 0)
+	    if ((q = findwhichvar(termnop->args[0],vars)) < 0)
 	      throw(string("variable not in vars list in doterm"));
 	    A[q] += 1.;
 	    return(true);
 	  case 2:
-	    if ( ((*termnop->args)[0]->etype != numval) ||
-		 ((*termnop->args)[1]->etype != physvart))
+	    if ( (termnop->args[0]->etype != numval) ||
+		 (termnop->args[1]->etype != physvart))
 	      throw(string("term a*b but not number * var in doterm"));
-	    if ((q = findwhichvar((*termnop->args)[1],vars)) < 0)
+	    if ((q = findwhichvar(termnop->args[1],vars)) < 0)
 	      throw(string("variable not in vars list in doterm"));
-	    A[q] += ((numvalexp *)(*termnop->args)[0])->value;
+	    A[q] += ((numvalexp *)termnop->args[0])->value;
 	    return(true);
 	  default:
 	    throw(string("term a*b*c... not allowed in doterm"));
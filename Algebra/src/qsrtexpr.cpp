@@ -18,7 +18,7 @@
 //  You should have received a copy of the GNU Lesser General Public License
 //  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
 
-// void qsrtexpr(vector<expr *> *Vptr)	
+// void qsrtexpr(exprlist *Vptr)	
 //	sorts a vector of expressions in order desscribed below
 //	(see outoforder)
 
@@ -30,21 +30,21 @@ using namespace std;
 #define DBG(A) DBGF(QSRT,A)
 
 // auxiliary functions:
-void qsortpc(vector<expr *> *Vptr, int low, int high);
-int pivotpart(vector<expr *> *Vptr , int low, int high);
-void swap(vector<expr *> *Vptr, int i, int j);
+void qsortpc(exprlist *Vptr, int low, int high);
+int pivotpart(exprlist *Vptr , int low, int high);
+void swap(exprlist *Vptr, int i, int j);
 bool outoforder(const expr * ex1, const expr * ex2);
 
 
 /************************************************************************
- * void qsrtexpr(vector<expr *> *Vptr)					*
+ * void qsrtexpr(exprlist *Vptr)					*
  *	sorts a vector of expressions, as might occur in an n_op	*
  *	in a somewhat arbitrary but nearly definite order		*
  *	(terms which differ by numerical factors are not 		*
  *	deterministically ordered, unless one is an n_op and one isn't)	*
  *	(for details of ordering, see outoforder below)			*
  ************************************************************************/
-void qsrtexpr(vector<expr *> *Vptr)	// sorts a vector of expressions as
+void qsrtexpr(exprlist *Vptr)	// sorts a vector of expressions as
 {					//  in a n_op->args
   DBG( { cout << "qsrtexpr called on " << Vptr->size() << " exprs" << endl;
     for (int k=0; k<Vptr->size();k++) cout << (*Vptr)[k]->getInfix() << endl;
@@ -55,7 +55,7 @@ void qsrtexpr(vector<expr *> *Vptr)	// sorts a vector of expressions as
   } ) ;
 }				
 
-void qsortpc(vector<expr *> *Vptr, int low, int high)
+void qsortpc(exprlist *Vptr, int low, int high)
 {
   int pivot;
   DBG(cout << "qsortpc called with low/high "<< low << " / " << high << endl;);
@@ -71,7 +71,7 @@ void qsortpc(vector<expr *> *Vptr, int low, int high)
  * returns the index of the entry placed in correct place. Still need	*
  *	to sort, separately, the stuff below and the stuff above	*
  ************************************************************************/
-int pivotpart(vector<expr *> *Vptr, int low, int high)
+int pivotpart(exprlist *Vptr, int low, int high)
 {
   int lastlow, i;
   expr *pivotex;
@@ -101,7 +101,7 @@ int pivotpart(vector<expr *> *Vptr, int low, int high)
 /************************************************************************
  * swap(Vptr,i,j) interchanges the i'th and j'th elements of the vector V  *
  ************************************************************************/
-void swap(vector <expr *> * Vptr, int i, int j)
+void swap(exprlist * Vptr, int i, int j)
 {
   expr * temp;
   temp = (*Vptr)[i];
@@ -163,8 +163,8 @@ bool outoforder(const expr * ex1, const expr * ex2)
 	return(true);
       if ( ((n_opexp *)ex1)->op->opty < ((n_opexp *)ex2)->op->opty) 
 	return(false);
-      vector<expr *> *v1 = ((n_opexp *)ex1)->args;
-      vector<expr *> *v2 = ((n_opexp *)ex2)->args;
+      const exprlist *v1 = &((n_opexp *)ex1)->args;
+      const exprlist *v2 = &((n_opexp *)ex2)->args;
       for (k1=k2=0; k1 < v1->size() && k2 < v2->size(); k1++, k2++)
 	{
 	  if ((*v1)[k1]->etype == numval) { k2--; continue; }
@@ -66,19 +66,19 @@ bool rationalize(binopexp * & bineq)
   int ksum;
   n_opexp * denom = new n_opexp(&mult);	// current lowest common denom
   n_opexp * tempnop;
-  for (ksum = 0; ksum < ourf->args->size(); ksum++)
+  for (ksum = 0; ksum < ourf->args.size(); ksum++)
     {
-      switch((*ourf->args)[ksum]->etype)
+      switch(ourf->args[ksum]->etype)
 	{
 	case numval:
 	case physvart:
-	  if (denom->args->size() == 0) continue; 	// multiply by
+	  if (denom->args.size() == 0) continue; 	// multiply by
 	  tempnop = new n_opexp(&mult);			// current LCD
 //	  tempnop->MKS.put(0,0,0,0,0); // REMOVE after fixing constructor 
-	  tempnop->addarg((*ourf->args)[ksum]); // and continue
-	  for (k = 0; k < denom->args->size(); k++)
-	    tempnop->addarg((*denom->args)[k]);
-	  (*ourf->args)[ksum]=tempnop;
+	  tempnop->addarg(ourf->args[ksum]); // and continue
+	  for (k = 0; k < denom->args.size(); k++)
+	    tempnop->addarg(denom->args[k]);
+	  ourf->args[ksum]=tempnop;
 	  continue;
 	case function:		// functions violate the restriction to polys
 	  ourf->destroy();	// clean up and return false
@@ -87,7 +87,7 @@ bool rationalize(binopexp * & bineq)
 	  return(false);
 	case binop:
 	  {
-	    binopexp * binterm = (binopexp *)(*ourf->args)[ksum];
+	    binopexp * binterm = (binopexp *)ourf->args[ksum];
 	    if (binterm->op->opty == divbye) 	// this term is a ratio
 	      {					// make sure denom is mult
 		if ((binterm->rhs->etype != n_op) ||
@@ -100,55 +100,55 @@ bool rationalize(binopexp * & bineq)
 		  } 		// ratio denom to be compared to denom to 
 		n_opexp * thisden = (n_opexp *) binterm->rhs;   // remove com- 
 		n_opexp * denleft = (n_opexp *) copyexpr(denom); // mon factors
-		for (int qthd=0; qthd < thisden->args->size(); qthd++) 
-		  for (int qdl=0; qdl < denleft->args->size(); qdl++) 
-		    if (equaleqs((*thisden->args)[qthd],(*denleft->args)[qdl]))
+		for (int qthd=0; qthd < thisden->args.size(); qthd++) 
+		  for (int qdl=0; qdl < denleft->args.size(); qdl++) 
+		    if (equaleqs(thisden->args[qthd],denleft->args[qdl]))
 		      {				// remove common factors
-			(*thisden->args)[qthd]->destroy();
-			(*thisden->args)[qthd] = 
-			  (*thisden->args)[thisden->args->size()-1];
-			thisden->args->pop_back();
-			(*denleft->args)[qdl]->destroy();
-			(*denleft->args)[qdl] = 
-			  (*denleft->args)[denleft->args->size()-1];
-			denleft->args->pop_back();
+			thisden->args[qthd]->destroy();
+			thisden->args[qthd] = 
+			  thisden->args[thisden->args.size()-1];
+			thisden->args.pop_back();
+			denleft->args[qdl]->destroy();
+			denleft->args[qdl] = 
+			  denleft->args[denleft->args.size()-1];
+			denleft->args.pop_back();
 			qthd--;
 			break;
 		      }
 		// if factors in this terms denom not already in QCD, add
 		// them to QCD and correct all prior terms in sum
-		if (thisden->args->size() > 0)
+		if (thisden->args.size() > 0)
 		  {
 		    for (k=0 ; k < ksum; k++) {
-		      if (((*ourf->args)[k]->etype != n_op) ||
-			  ((n_opexp *)(*ourf->args)[k])->op->opty != multe)
+		      if ((ourf->args[k]->etype != n_op) ||
+			  ((n_opexp *)ourf->args[k])->op->opty != multe)
 			{
 			  n_opexp * temp = new n_opexp(&mult);
 //	  temp->MKS.put(0,0,0,0,0); // REMOVE after fixing constructor 
-			  temp->addarg(((*ourf->args)[k]));
-			  (*ourf->args)[k] = temp;
+			  temp->addarg((ourf->args[k]));
+			  ourf->args[k] = temp;
 			}
-		      for (q = 0; q < thisden->args->size(); q++)
-			((n_opexp *)(*ourf->args)[k])->args->
-			  push_back(copyexpr((*thisden->args)[q]));
+		      for (q = 0; q < thisden->args.size(); q++)
+			((n_opexp *)ourf->args[k])->args.
+			  push_back(copyexpr(thisden->args[q]));
 		    }
 		    thisden->destroy();
 		  }
-		(*ourf->args)[ksum] = binterm->lhs;
+		ourf->args[ksum] = binterm->lhs;
 		delete binterm;
-		if (denleft->args->size() > 0)
+		if (denleft->args.size() > 0)
 		  {
-		    if (((*ourf->args)[ksum]->etype != n_op) ||
-			((n_opexp *)(*ourf->args)[ksum])->op->opty != multe)
+		    if ((ourf->args[ksum]->etype != n_op) ||
+			((n_opexp *)ourf->args[ksum])->op->opty != multe)
 		      {
 			n_opexp * temp = new n_opexp(&mult);
 //	  temp->MKS.put(0,0,0,0,0); // REMOVE after fixing constructor 
-			temp->addarg(((*ourf->args)[ksum]));
-			(*ourf->args)[ksum] = temp;
+			temp->addarg((ourf->args[ksum]));
+			ourf->args[ksum] = temp;
 		      }
-		    for (q = 0; q < denleft->args->size(); q++)
-			((n_opexp *)(*ourf->args)[ksum])->args->
-			  push_back((*denleft->args)[q]);
+		    for (q = 0; q < denleft->args.size(); q++)
+			((n_opexp *)ourf->args[ksum])->args.
+			  push_back(denleft->args[q]);
 		  }
 		delete denleft;
 		continue;
@@ -166,13 +166,13 @@ bool rationalize(binopexp * & bineq)
 		if (binterm->lhs->etype != physvart)
 		  throw(string("Could happen, but rationalize is not prepared")
 			+string(" for powers of other than simple variables"));
-		if (denom->args->size() == 0) continue; 	// multiply by
+		if (denom->args.size() == 0) continue; 	// multiply by
 		n_opexp * tempnop = new n_opexp(&mult);		// current LCD
 //	  tempnop->MKS.put(0,0,0,0,0); // REMOVE after fixing constructor 
-		tempnop->addarg((*ourf->args)[ksum]); // and continue
-		for (k = 0; k < denom->args->size(); k++)
-		  tempnop->addarg((*denom->args)[k]);
-		(*ourf->args)[ksum]=tempnop;
+		tempnop->addarg(ourf->args[ksum]); // and continue
+		for (k = 0; k < denom->args.size(); k++)
+		  tempnop->addarg(denom->args[k]);
+		ourf->args[ksum]=tempnop;
 		continue;
 	      }
 	    else
@@ -185,11 +185,11 @@ bool rationalize(binopexp * & bineq)
 	  } // end of case binop
 	case n_op:
 	  {
-	    n_opexp * thnop = (n_opexp *)(*ourf->args)[ksum];
+	    n_opexp * thnop = (n_opexp *)ourf->args[ksum];
 	    if (thnop->op->opty != multe)
 	      throw(string("rationalize: terms in sum cant be sums"));
-	    for (k = 0; k < thnop->args->size(); k++)
-	      switch((*thnop->args)[k]->etype)
+	    for (k = 0; k < thnop->args.size(); k++)
+	      switch(thnop->args[k]->etype)
 		{
 		case numval:
 		case physvart:
@@ -203,7 +203,7 @@ bool rationalize(binopexp * & bineq)
 		case binop:
 		  // not supposed to be a divbye inside a mult, 
 		  {
-		    binopexp * binterm = (binopexp *)(*thnop->args)[k];
+		    binopexp * binterm = (binopexp *)thnop->args[k];
 		    if ((binterm->op->opty != topowe) ||
 			(binterm->rhs->etype != numval) ||
 			(!lookslikeint(((numvalexp *)binterm->rhs)->value,q)))
@@ -227,8 +227,8 @@ bool rationalize(binopexp * & bineq)
 			("impossible expr deep into expr in rationalize"));
 		} // end of switch over thnop[k] type, 
 		  // and of loop over mult args
-	    for (k = 0; k < denom->args->size(); k++)
-	      thnop->addarg(copyexpr((*denom->args)[k]));
+	    for (k = 0; k < denom->args.size(); k++)
+	      thnop->addarg(copyexpr(denom->args[k]));
 	    continue;
 	  } // end of case term = n_op
 	case unknown:
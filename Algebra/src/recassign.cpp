@@ -98,7 +98,7 @@ void recassign( vector<binopexp *> * eqn, // equations remaining to be slvd
 		DBG(cout << "About to push onto soleqs " 
 		    << (*eqn)[numsolved]->getInfix() << endl; );
 		// was	solfile << (*eqn)[numsolved]->solprint()  << endl;
-		soleqs->push_back((binopexp *)copyexpr((*eqn)[numsolved]));
+		// it goes on soleqs, rather than a copy, when done with below
 
 		numsolved++;
 		DBGM(cout << "After solving the " << numsolved << 
@@ -203,9 +203,9 @@ void recassign( vector<binopexp *> * eqn, // equations remaining to be slvd
 	      << " left with " << vars->size() << " variables unsolved" 
 	      << endl; );
   
-  // destroy used-up equations
+  // used-up equations are the solutions, in the order solved
   for (q=0; q < numsolved; q++)
-    (*eqn)[q]->destroy();
+    soleqs->push_back((*eqn)[q]);
   for (q=0; q+numsolved < eqn->size(); q++)
     (*eqn)[q]=(*eqn)[q+numsolved];
   for (q=0; q < numsolved; q++)
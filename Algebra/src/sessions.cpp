@@ -0,0 +1,113 @@
+// sessions.cpp
+//    Several independent problems (sessions) held in one solver process
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  Each session is a SolverContext; selecting a session makes its 
+//  context the current one. The session named "" is the default 
+//  context, which always exists.
+//  Sessions may be created, destroyed and selected from several 
+//  threads at once (see solver-program -threads), so the table of 
+//  sessions is locked; a context itself is only used by one thread 
+//  at a time.
+
+#include "decl.h"
+#include "dbg.h"
+#include "extstruct.h"
+#include "indysgg.h"
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+#define DBG(A) DBGF(INDYEMP,A)
+
+void doinitinit();
+
+static map<string, SolverContext *> sessions;
+static mutex sessionsLock;
+
+/************************************************************************
+ * findSession(name)  returns the context of session name, or throws	*
+ ************************************************************************/
+static SolverContext * findSession(const string & name)
+{
+  if (name.empty()) return(defaultSolverContext());
+  lock_guard<mutex> guard(sessionsLock);
+  map<string, SolverContext *>::iterator it = sessions.find(name);
+  if (it == sessions.end())
+    throw(string("no solver session named ") + name);
+  return(it->second);
+}
+
+/************************************************************************
+ * sessionCreate(name)  makes a new session with an empty problem,	*
+ *    initialized as doinitinit would. The current session is unchanged.*
+ ************************************************************************/
+void sessionCreate(const string & name)
+{
+  {
+    lock_guard<mutex> guard(sessionsLock);
+    if (name.empty() || sessions.count(name) > 0)
+      throw(string("solver session already exists: ") + name);
+  }
+  SolverContext * ctx = new SolverContext;
+  ctx->name = name;
+  SolverContext * previous = useSolverContext(ctx);
+  try { doinitinit(); }
+  catch (string message) { 
+    useSolverContext(previous); 
+    delete ctx; 
+    throw message; 
+  }
+  useSolverContext(previous);
+  lock_guard<mutex> guard(sessionsLock);
+  if (sessions.count(name) > 0) {	// made meanwhile by another thread
+    delete ctx;
+    throw(string("solver session already exists: ") + name);
+  }
+  sessions[name] = ctx;
+  DBG(cout << "created solver session " << name << ", now "
+      << sessions.size() << " sessions" << endl);
+}
+
+/************************************************************************
+ * sessionDestroy(name)  frees the problem held by session name and	*
+ *    forgets the session. If it was current, the default session 	*
+ *    becomes current. The default session cannot be destroyed.		*
+ ************************************************************************/
+void sessionDestroy(const string & name)
+{
+  if (name.empty())
+    throw(string("can't destroy the default solver session"));
+  SolverContext * ctx = findSession(name);
+  {
+    lock_guard<mutex> guard(sessionsLock);
+    sessions.erase(name);
+  }
+  delete ctx;		// which leaves the default current if ctx was
+  DBG(cout << "destroyed solver session " << name << endl);
+}
+
+/************************************************************************
+ * sessionSelect(name)  makes session name the target of all following	*
+ *    solver calls.							*
+ ************************************************************************/
+void sessionSelect(const string & name)
+{
+  useSolverContext(findSession(name));
+}
@@ -244,9 +244,9 @@ bool linvarcoefs(const expr * ex, const varindx var,
 	if (thnop->op->opty == multe) {
 	  cf = new n_opexp(&mult);
 	  ov = new n_opexp(&mult);
-	  for (k=0; k < thnop->args->size(); k++){
+	  for (k=0; k < thnop->args.size(); k++){
 	    DBGM( cout << "Linvarcoefs n_op mult arg " << k << endl; );
-	    if (!linvarcoefs((*thnop->args)[k],var,coef,numer))
+	    if (!linvarcoefs(thnop->args[k],var,coef,numer))
 	      { cf->destroy(); ov->destroy(); 
 	      DBG(cout << "linvarcoefs " << thisdbg << " returning false" 
 		  << endl);
@@ -254,7 +254,7 @@ bool linvarcoefs(const expr * ex, const varindx var,
 	    DBGM( cout << "Linvarcoefs mult arg " << k<< " true" <<endl; );
 	    if ((coef->etype != numval) || ((numvalexp *)coef)->value != 0)
 	      {
-		if (cf->args->size() > 0) {
+		if (cf->args.size() > 0) {
 		  cf->destroy(); ov->destroy(); 
 		  coef->destroy(); numer->destroy();
 		  coef = NULL; numer = NULL; 
@@ -264,19 +264,19 @@ bool linvarcoefs(const expr * ex, const varindx var,
 		}
 		cf->addarg(coef);
 		coef = NULL;
-		for (q = 0; q < ov->args->size(); q++)
-		  cf->addarg(copyexpr((*ov->args)[q]));
+		for (q = 0; q < ov->args.size(); q++)
+		  cf->addarg(copyexpr(ov->args[q]));
 		ov->addarg(numer); numer = NULL;
 	      }
 	    else 
 	      {
-		if (cf->args->size() > 0) cf->addarg(copyexpr(numer));
+		if (cf->args.size() > 0) cf->addarg(copyexpr(numer));
 		ov->addarg(numer); numer = NULL;
 		coef->destroy(); coef = NULL;
 	      }
 	  }
 	  DBGM( cout << "Linvarcoefs mult preparing return true" << endl; );
-	  if (cf->args->size() == 0) {
+	  if (cf->args.size() == 0) {
 	    coef = new numvalexp(0);
 	    cf->destroy();
 	  }
@@ -296,10 +296,10 @@ bool linvarcoefs(const expr * ex, const varindx var,
 	if (thnop->op->opty == pluse)
 	  cf = new n_opexp(&myplus);
 	  ov = new n_opexp(&myplus);
-	  for (k=0; k < thnop->args->size(); k++)
+	  for (k=0; k < thnop->args.size(); k++)
 	    {
 	      DBGM( cout << "Linvarcoefs plus arg " << k << endl; );
-	      if (!linvarcoefs((*thnop->args)[k],var,coef,numer))
+	      if (!linvarcoefs(thnop->args[k],var,coef,numer))
 		{ cf->destroy(); ov->destroy(); 
 		DBG(cout << "linvarcoefs " << thisdbg << " returning false" 
 		      << endl);
@@ -355,8 +355,8 @@ bool doesnthave(const expr * ex, const varindx var)
       return (doesnthave(((binopexp *)ex)->lhs,var) &&
 	      doesnthave(((binopexp *)ex)->rhs,var));
     case n_op:
-      for (k=0; k < ((n_opexp *)ex)->args->size(); k++)
-	if (!doesnthave((*((n_opexp *)ex)->args)[k],var)) return(false);
+      for (k=0; k < ((n_opexp *)ex)->args.size(); k++)
+	if (!doesnthave(((n_opexp *)ex)->args[k],var)) return(false);
       return(true);
     case unknown:
     case fake:
@@ -0,0 +1,178 @@
+// solutioncache.cpp
+//    Solutions kept on disk, keyed by the statements of the problem
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  Each problem is solved the same way every time it is loaded, so its
+//  solution text and numsols may be kept in a directory and reused by
+//  any later session, or any other solver process, given the same
+//  statements. The context records the statements that made its
+//  problem (solveAdd, indyAddVar, indyAddCanonEq), with white space
+//  normalized; a hash of them names the file.
+//  A file is written under a temporary name and renamed into place,
+//  so a reader sees either no file or a whole one. The statements are
+//  stored in the file too and compared on reading, so two problems
+//  with the same hash are never confused.
+
+#include "decl.h"
+#include "dbg.h"
+#include "extstruct.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <unistd.h>
+
+using namespace std;
+
+#define DBG(A) DBGF(INDYEMP,A)
+
+static string cacheDirectory;		// "" when there is no cache
+static mutex cacheDirectoryLock;
+static atomic<unsigned long> tempFiles(0);
+
+static const char * const cacheHeader = "andes-solution 1";
+
+/************************************************************************
+ * setSolutionCache(dir)  keeps solutions in directory dir from now on,	*
+ *	or in no directory if dir is empty				*
+ ************************************************************************/
+void setSolutionCache(const string & dir)
+{
+  lock_guard<mutex> guard(cacheDirectoryLock);
+  cacheDirectory = dir;
+}
+
+static string solutionCache()
+{
+  lock_guard<mutex> guard(cacheDirectoryLock);
+  return(cacheDirectory);
+}
+
+/************************************************************************
+ * noteStatement(kind, text)  adds a statement of the current problem	*
+ *	to those keying its solution, with runs of white space made	*
+ *	single spaces							*
+ ************************************************************************/
+void noteStatement(const char * const kind, const string & text)
+{
+  string & statements = solverContext()->statements;
+  statements += kind;
+  bool space = true;
+  for (size_t k = 0; k < text.size(); k++) {
+    if (isspace((unsigned char) text[k])) space = true;
+    else {
+      if (space) statements += ' ';
+      statements += text[k];
+      space = false;
+    }
+  }
+  statements += '\n';
+}
+
+/************************************************************************
+ * cacheFile(dir, statements)  the name of the file holding the		*
+ *	solution for statements: a 64 bit FNV-1a hash, in hex		*
+ ************************************************************************/
+static string cacheFile(const string & dir, const string & statements)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+  for (size_t k = 0; k < statements.size(); k++) {
+    hash ^= (unsigned char) statements[k];
+    hash *= 1099511628211ULL;
+  }
+  char name[20];
+  snprintf(name, sizeof(name), "%016llx", hash);
+  return(dir + "/" + name);
+}
+
+/************************************************************************
+ * cachedSolution(solution, sols)  if the solution of the current	*
+ *	problem is in the cache, puts its text in solution and its	*
+ *	values in sols and returns true. Otherwise returns false and	*
+ *	leaves both alone.						*
+ ************************************************************************/
+bool cachedSolution(string & solution, vector<double> & sols)
+{
+  string dir = solutionCache();
+  if (dir.empty()) return(false);
+  const string & statements = solverContext()->statements;
+  ifstream in(cacheFile(dir, statements).c_str(), ios::binary);
+  if (!in) return(false);
+
+  string header, number;
+  size_t length, count;
+  if (!getline(in, header) || header != cacheHeader) return(false);
+  // the statements
+  if (!(in >> length) || in.get() != '\n' || length != statements.size())
+    return(false);
+  string text(length, ' ');
+  if (length > 0 && !in.read(&text[0], length)) return(false);
+  if (text != statements) return(false);
+  // the values, written exactly as %a
+  if (!(in >> count) || count != canonvars->size()) return(false);
+  vector<double> values(count);
+  for (size_t k = 0; k < count; k++) {
+    if (!(in >> number)) return(false);
+    values[k] = strtod(number.c_str(), 0);
+  }
+  // the solution text
+  if (!(in >> length) || in.get() != '\n') return(false);
+  text.assign(length, ' ');
+  if (length > 0 && !in.read(&text[0], length)) return(false);
+
+  DBG(cout << "cachedSolution found " << count << " values" << endl;);
+  solution.swap(text);
+  sols.swap(values);
+  return(true);
+}
+
+/************************************************************************
+ * cacheSolution(solution, sols)  keeps the solution of the current	*
+ *	problem in the cache, if there is one. A failure to write only	*
+ *	loses the saving.						*
+ ************************************************************************/
+void cacheSolution(const string & solution, const vector<double> & sols)
+{
+  string dir = solutionCache();
+  if (dir.empty()) return;
+  const string & statements = solverContext()->statements;
+  string file = cacheFile(dir, statements);
+  char suffix[40];
+  snprintf(suffix, sizeof(suffix), ".%ld.%lu", (long) getpid(), tempFiles++);
+  string temp = file + suffix;
+
+  {
+    ofstream out(temp.c_str(), ios::binary);
+    out << cacheHeader << '\n' << statements.size() << '\n' << statements
+	<< sols.size() << '\n';
+    char number[40];
+    for (size_t k = 0; k < sols.size(); k++) {
+      snprintf(number, sizeof(number), "%a", sols[k]);
+      out << number << '\n';
+    }
+    out << solution.size() << '\n' << solution;
+    out.close();
+    if (!out) {
+      remove(temp.c_str());
+      return;
+    }
+  }
+  if (rename(temp.c_str(), file.c_str()) != 0) remove(temp.c_str());
+}
@@ -106,25 +106,25 @@ bool solveknownvar(expr * & eq)
       n_opexp * eqlhs = (n_opexp *) bineq->lhs;
       if (eqlhs->op->opty == multe) // if eq is num * var = 0 or var * num = 0
 	{			    //   drop num, but (as of 8/17/01) fix
-	  if (! ((eqlhs->args->size() == 2) && 		// 0's MKS
-		 ( ( ((*eqlhs->args)[0]->etype == numval) &&
-		     ((*eqlhs->args)[1]->etype == physvart))   ||
-		   ( ((*eqlhs->args)[1]->etype == numval) &&
-		     ((*eqlhs->args)[0]->etype == physvart))   ) ))
+	  if (! ((eqlhs->args.size() == 2) && 		// 0's MKS
+		 ( ( (eqlhs->args[0]->etype == numval) &&
+		     (eqlhs->args[1]->etype == physvart))   ||
+		   ( (eqlhs->args[1]->etype == numval) &&
+		     (eqlhs->args[0]->etype == physvart))   ) ))
 	    throw(string("got impossible lhs n_op in solveknownvar"));
-	  if ((*eqlhs->args)[1]->etype == physvart)
+	  if (eqlhs->args[1]->etype == physvart)
 	    {
-	      bineq->lhs = (*eqlhs->args)[1];
-	      bineq->rhs->MKS += (*eqlhs->args)[0]->MKS * -1.; // 8/17/01
-	      bineq->MKS += (*eqlhs->args)[0]->MKS * -1.; // 8/17/01
-	      (*eqlhs->args)[0]->destroy();
+	      bineq->lhs = eqlhs->args[1];
+	      bineq->rhs->MKS += eqlhs->args[0]->MKS * -1.; // 8/17/01
+	      bineq->MKS += eqlhs->args[0]->MKS * -1.; // 8/17/01
+	      eqlhs->args[0]->destroy();
 	    }
 	  else
 	    {
-	      bineq->lhs = (*eqlhs->args)[0];
-	      bineq->rhs->MKS += (*eqlhs->args)[1]->MKS * -1.; // 8/17/01
-	      bineq->MKS += (*eqlhs->args)[1]->MKS * -1.; // 8/17/01
-	      (*eqlhs->args)[1]->destroy();
+	      bineq->lhs = eqlhs->args[0];
+	      bineq->rhs->MKS += eqlhs->args[1]->MKS * -1.; // 8/17/01
+	      bineq->MKS += eqlhs->args[1]->MKS * -1.; // 8/17/01
+	      eqlhs->args[1]->destroy();
 	    }
 	  // rmed 2/4/01 need to check	  delete eqlhs->args;
 	  delete eqlhs;
@@ -143,53 +143,53 @@ bool solveknownvar(expr * & eq)
 	  int pv = -1;		// will hold index to single physvar if found
 	  int indx;
 	  
-	  for (k=0; k < eqlhs->args->size(); k++)
+	  for (k=0; k < eqlhs->args.size(); k++)
 	    {
-	      if ((*eqlhs->args)[k]->etype == numval) {
-		b = addnum(b,((numvalexp *)(*eqlhs->args)[k])->value);
-		if (dimb.unknp()) dimb = (*eqlhs->args)[k]->MKS;
-		if (!(dimb == (*eqlhs->args)[k]->MKS)) 
+	      if (eqlhs->args[k]->etype == numval) {
+		b = addnum(b,((numvalexp *)eqlhs->args[k])->value);
+		if (dimb.unknp()) dimb = eqlhs->args[k]->MKS;
+		if (!(dimb == eqlhs->args[k]->MKS)) 
 		  throw(string(
 			   "Solveknownvar couldnt add different dimensions"));
 	      }
-	      else if ((*eqlhs->args)[k]->etype == n_op)
+	      else if (eqlhs->args[k]->etype == n_op)
 		{
-		  n_opexp * eqlharg = (n_opexp *) (*eqlhs->args)[k];
-		  if (eqlharg->args->size() != 2) {
+		  n_opexp * eqlharg = (n_opexp *) eqlhs->args[k];
+		  if (eqlharg->args.size() != 2) {
 		    cout << "in solveknownvar, plus term " << k 
-			 << " has " << eqlharg->args->size()
+			 << " has " << eqlharg->args.size()
 			 << " factors, it is " << eqlharg->getInfix() << endl;
 		    throw(string(
 			 "arg of + lhs of solveknownvar != two terms mult"));
 		    }
 		  
-		  if ((*eqlharg->args)[0]->etype == numval)
+		  if (eqlharg->args[0]->etype == numval)
 		    {			// put them in order with numval second
-		      expr * temp = (*eqlharg->args)[0];
-		      (*eqlharg->args)[0] = (*eqlharg->args)[1];
-		      (*eqlharg->args)[1] = temp;
+		      expr * temp = eqlharg->args[0];
+		      eqlharg->args[0] = eqlharg->args[1];
+		      eqlharg->args[1] = temp;
 		    }
-		  if ((*eqlharg->args)[0]->etype != physvart)
+		  if (eqlharg->args[0]->etype != physvart)
 		    throw(string(
 			 "lh of lhs of solveknownvar no physvar"));
-		  indx = ((physvarptr *)(*eqlharg->args)[0])->varindex;
+		  indx = ((physvarptr *)eqlharg->args[0])->varindex;
 		  if (pv < 0) pv = indx;
 		  if (pv != indx) {
 		    bineq->destroy();
 		    return(false);}
-		  if ((*eqlharg->args)[1]->etype != numval)
+		  if (eqlharg->args[1]->etype != numval)
 		    throw(string(
 			 "lh of lhs of solveknownvar no physvar"));
-		  a = addnum(a,((numvalexp *)(*eqlharg->args)[1])->value);
-		  if (dima.unknp()) dima = (*eqlharg->args)[1]->MKS;
-		  if (!(dima == (*eqlharg->args)[1]->MKS) )
+		  a = addnum(a,((numvalexp *)eqlharg->args[1])->value);
+		  if (dima.unknp()) dima = eqlharg->args[1]->MKS;
+		  if (!(dima == eqlharg->args[1]->MKS) )
 		  throw(string(
 			   "Solveknownvar couldnt add different dimensions"));
 
 		}
-	      else if ((*eqlhs->args)[k]->etype == physvart)
+	      else if (eqlhs->args[k]->etype == physvart)
 		{
-		  indx = ((physvarptr *)(*eqlhs->args)[k])->varindex;
+		  indx = ((physvarptr *)eqlhs->args[k])->varindex;
 		  if (pv < 0) pv = indx;
 		  if (pv != indx) {
 		    bineq->destroy();
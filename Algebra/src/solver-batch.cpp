@@ -0,0 +1,312 @@
+//////////////////////////////////////////////////////////////////////////////
+// solver-batch.cpp -- solve a directory of problems on all cores
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+//  solver-batch [-threads n] [-cache dir] [-images] [-library file]
+//		 problems solutions
+//  Each file in directory problems is a problem, one statement a line
+//  as given to solveAdd, such as (SVAR m kg) or (= m (DNUM 2.0 |kg|)).
+//  Each is solved, as by solveBubble and solveMoreBubble, and its
+//  solution written to solutions/<file>.sol. If the solution has any
+//  tagged sections (<DISCREPANCIES>, <UNSLVEQS> and so on), they are
+//  also written to solutions/<file>.dis, the report of what wasn't
+//  solved or didn't check. With -images, the problem image of each
+//  (see checkpoint.cpp) is written to solutions/<file>.img, for
+//  sessions to load with solverLoadProblemImage. With -library, the
+//  images of all the problems solved are also put in a problem library
+//  file, for solverOpenProblemLibrary, each named by its file.
+//  Problems are solved by n threads (by default one for each core),
+//  each in a session of its own. Each thread has a queue of problems,
+//  dealt out largest first; a thread whose queue is empty takes from
+//  the back of another's, so the threads finish at about the same time
+//  however the problems are spread. At the end, each problem is listed
+//  with the time it took and how it came out. The exit status is 1 if
+//  any problem failed.
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "decl.h"
+#include "Solver.h"
+#include "indysgg.h"
+#include "dbg.h"
+using namespace std;
+
+void doinitinit();
+void makeProblemLibrary(const string & file, const vector<string> & names,
+			const vector<string> & images);	// in checkpoint.cpp
+
+struct batchProblem {
+  string name;			// its file, in the problems directory
+  long size;			// of the file
+  int statements;
+  double millis;		// to solve it
+  string outcome;		// "solved", its tags, or what went wrong
+  bool failed;
+};
+
+static vector<batchProblem> problems;
+static bool images = false;		// write the problem images too
+
+// the problems waiting for each thread
+struct workQueue {
+  mutex lock;
+  deque<int> waiting;
+};
+static vector<workQueue *> queues;
+
+/************************************************************************
+ * takeProblem(self, p)  takes the next problem of thread self, or if	*
+ *	it has none, the last of another thread, into p. Returns false	*
+ *	when no problems are left.					*
+ ************************************************************************/
+static bool takeProblem(int self, int & p)
+{
+  {
+    lock_guard<mutex> guard(queues[self]->lock);
+    if (!queues[self]->waiting.empty()) {
+      p = queues[self]->waiting.front();
+      queues[self]->waiting.pop_front();
+      return(true);
+    }
+  }
+  for (size_t k = 1; k < queues.size(); k++) {
+    workQueue * victim = queues[(self + k) % queues.size()];
+    lock_guard<mutex> guard(victim->lock);
+    if (!victim->waiting.empty()) {
+      p = victim->waiting.back();
+      victim->waiting.pop_back();
+      return(true);
+    }
+  }
+  return(false);
+}
+
+static bool isError(const string & result)
+{
+  return(result.compare(0, 13, "(solverError ") == 0);
+}
+
+/************************************************************************
+ * solveProblem(in, out, prob)  solves the problem in file in, in the	*
+ *	current session, writing its solution to out.sol and out.dis	*
+ ************************************************************************/
+static void solveProblem(const string & in, const string & out,
+			 batchProblem & prob)
+{
+  prob.failed = true;
+  ifstream statements(in.c_str());
+  if (!statements) { prob.outcome = "can't read " + in; return; }
+  string result = solveClear();
+  if (result != "t") { prob.outcome = result; return; }
+  string line;
+  for (int lineno = 1; getline(statements, line); lineno++) {
+    if (!line.empty() && line[line.size()-1] == '\r') line.erase(line.size()-1);
+    if (line.find_first_not_of(" \t") == string::npos) continue;
+    prob.statements++;
+    result = solveAdd(line.c_str());
+    if (result != "t") {
+      prob.outcome = "line " + itostr(lineno) + ": " + result;
+      return;
+    }
+  }
+
+  // the solution ends at nil, as for the lisp side
+  vector<string> solution;
+  for (result = solveBubble(); result != "nil"; result = solveMoreBubble()) {
+    if (isError(result)) { prob.outcome = result; return; }
+    solution.push_back(result);
+  }
+
+  string sol = out + ".sol", dis = out + ".dis";
+  ofstream solfile(sol.c_str());
+  string tags;
+  bool tagged = false;		// in the tagged part of the solution
+  ofstream disfile;
+  for (size_t k = 0; k < solution.size(); k++) {
+    solfile << solution[k] << endl;
+    if (!solution[k].empty() && solution[k][0] == '<') {
+      if (!tagged) disfile.open(dis.c_str());
+      tagged = true;
+      tags += (tags.empty() ? "" : " ") + solution[k];
+    }
+    if (tagged) disfile << solution[k] << endl;
+  }
+  solfile.close();
+  if (!solfile) { prob.outcome = "can't write " + sol; return; }
+  if (tagged) {
+    disfile.close();
+    if (!disfile) { prob.outcome = "can't write " + dis; return; }
+  }
+  else remove(dis.c_str());	// left from an earlier run
+  if (images) {
+    result = solverWriteProblemImage((out + ".img").c_str());
+    if (result != "t") { prob.outcome = result; return; }
+  }
+  prob.outcome = tagged ? tags : "solved";
+  prob.failed = false;
+}
+
+/************************************************************************
+ * solveProblems(self, in, out)  thread self solves problems until none	*
+ *	are left								*
+ ************************************************************************/
+static void solveProblems(int self, const string & in, const string & out)
+{
+  string session = "batch" + itostr(self);
+  solverCreateSession(session.c_str());
+  solverSelectSession(session.c_str());
+  for (int p; takeProblem(self, p); ) {
+    batchProblem & prob = problems[p];
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    solveProblem(in + "/" + prob.name, out + "/" + prob.name, prob);
+    prob.millis = chrono::duration<double, milli>
+      (chrono::steady_clock::now() - start).count();
+  }
+  solverSelectSession("");
+  solverDestroySession(session.c_str());
+}
+
+static bool byName(const batchProblem & a, const batchProblem & b)
+{
+  return(a.name < b.name);
+}
+
+static bool largerProblem(int a, int b)
+{
+  return(problems[a].size > problems[b].size);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  int nthreads = thread::hardware_concurrency();
+  string library;
+  int arg = 1;
+
+  for (; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (arg + 1 < argc && strcmp(argv[arg],"-threads") == 0)
+      nthreads = atoi(argv[++arg]);
+    else if (arg + 1 < argc && strcmp(argv[arg],"-cache") == 0)
+      solverSolutionCache(argv[++arg]);
+    else if (strcmp(argv[arg],"-images") == 0) images = true;
+    else if (arg + 1 < argc && strcmp(argv[arg],"-library") == 0) {
+      library = argv[++arg];
+      images = true;
+    }
+    else break;
+  }
+  if (nthreads == 0) nthreads = 1;	// when the cores can't be counted
+  if (argc != arg + 2 || nthreads < 0) {
+    cerr << "Usage: " << argv[0] << " [-threads n] [-cache dir] [-images]"
+	 << " [-library file] problems solutions" << endl;
+    exit(1) ; }
+  string in = argv[arg], out = argv[arg + 1];
+
+  DIR * dir = opendir(in.c_str());
+  if (dir == 0L) { cerr << "can't read directory " << in << endl; exit(1); }
+  for (struct dirent * entry; (entry = readdir(dir)) != 0L; ) {
+    struct stat info;
+    if (entry->d_name[0] == '.' ||
+	stat((in + "/" + entry->d_name).c_str(), &info) != 0 ||
+	!S_ISREG(info.st_mode)) continue;
+    batchProblem prob;
+    prob.name = entry->d_name;
+    prob.size = info.st_size;
+    prob.statements = 0;
+    prob.millis = 0;
+    prob.failed = true;
+    problems.push_back(prob);
+  }
+  closedir(dir);
+  sort(problems.begin(), problems.end(), byName);
+  mkdir(out.c_str(), 0777);
+  struct stat info;
+  if (stat(out.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+    cerr << "can't make directory " << out << endl;
+    exit(1);
+  }
+  doinitinit();
+
+  // the largest problems are started first
+  vector<int> order(problems.size());
+  for (size_t p = 0; p < problems.size(); p++) order[p] = p;
+  sort(order.begin(), order.end(), largerProblem);
+  for (int t = 0; t < nthreads; t++) queues.push_back(new workQueue);
+  for (size_t k = 0; k < order.size(); k++)
+    queues[k % nthreads]->waiting.push_back(order[k]);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  vector<thread *> threads;
+  for (int t = 0; t < nthreads; t++)
+    threads.push_back(new thread(solveProblems, t, in, out));
+  for (int t = 0; t < nthreads; t++) {
+    threads[t]->join();
+    delete threads[t];
+  }
+  double seconds = chrono::duration<double>
+    (chrono::steady_clock::now() - start).count();
+
+  // by name, with the failures listed again at the end
+  vector<string> failures;
+  double total = 0;
+  char row[200];
+  for (size_t k = 0; k < problems.size(); k++) {
+    const batchProblem & prob = problems[k];
+    snprintf(row, sizeof(row), "%-30s %5d statements %10.1f ms  ",
+	     prob.name.c_str(), prob.statements, prob.millis);
+    cout << row << (prob.failed ? "FAILED " : "") << prob.outcome << endl;
+    if (prob.failed) failures.push_back(prob.name);
+    total += prob.millis;
+  }
+  snprintf(row, sizeof(row), "%lu problems, %.3f s on %d threads"
+	   " (%.3f s solving)", (unsigned long) problems.size(), seconds,
+	   nthreads, total / 1000);
+  cout << row << endl;
+  cout << failures.size() << " failed";
+  for (size_t k = 0; k < failures.size(); k++) cout << " " << failures[k];
+  cout << endl;
+
+  if (!library.empty()) {
+    vector<string> names, files;
+    for (size_t k = 0; k < problems.size(); k++) {
+      if (problems[k].failed) continue;
+      names.push_back(problems[k].name);
+      files.push_back(out + "/" + problems[k].name + ".img");
+    }
+    try {
+      makeProblemLibrary(library, names, files);
+      cout << "library " << library << " has " << names.size()
+	   << " problems" << endl;
+    } catch (string message) {
+      cout << message << endl;
+      failures.push_back(library);
+    }
+  }
+  closeupshop();
+  return(failures.empty() ? 0 : 1);
+}
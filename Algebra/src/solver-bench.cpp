@@ -0,0 +1,246 @@
+//////////////////////////////////////////////////////////////////////////////
+// solver-bench.cpp -- time small calls to solver-program by each transport
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+//  solver-bench [-calls n] [-program file]
+//  Starts solver-program (by default the one beside solver-bench) with
+//  each transport in turn: lines on stdin and stdout, -framed on stdin
+//  and stdout, and -shm. Each loads a small problem and is then sent n
+//  small calls, c_indyStudHowIndy and c_indyCanonHowIndy, one at a time,
+//  each waiting for its result. The round trips are listed, for each
+//  transport, as percentiles in microseconds and as calls a second.
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include "solvershm.h"
+using namespace std;
+
+// a small problem, as in Algebra/test/capi.c
+static const char * problem[] = {
+  "c_indyEmpty",
+  "c_indyAddVariable (m 2.0 kg)",
+  "c_indyAddVariable (a 3.0 m/s^2)",
+  "c_indyAddVariable (F 6.0 N)",
+  "c_indyDoneAddVariable",
+  "c_indyAddEquation (0 (= m (DNUM 2.0 |kg|)))",
+  "c_indyAddEquation (1 (= F (* m a)))",
+  "c_indyAddEquation (2 (= a (DNUM 3.0 |m/s^2|)))",
+  "c_indyAddEq2Set (0 0)",
+  "c_indyAddEq2Set (0 1)",
+  "c_indyStudentAddEquationOkay (3 (= F (* 2 a)))",
+  0L
+};
+static const char * calls[] = {
+  "c_indyStudHowIndy (0 3)",
+  "c_indyCanonHowIndy (0 2)",
+};
+
+enum transport { lines, frames, shared };
+static const char * transportName[] = { "stdio lines", "stdio -framed", "-shm" };
+
+// a running solver-program, and how to talk to it
+struct solverLink {
+  transport how;
+  pid_t pid;
+  FILE * to, * from;			// for lines and frames
+  shmChannel * channel;			// for shared
+  shmbuf * buf;
+  iostream * stream;
+  int id;
+};
+
+static void startSolver(solverLink & s, const string & program)
+{
+  int in[2] = { -1, -1 }, out[2] = { -1, -1 };
+  string shm = "/solver-bench-" + to_string(getpid());
+  s.channel = 0L;
+  s.id = 0;
+  if (s.how == shared) s.channel = shmChannel::create(shm, 1 << 16);
+  else if (pipe(in) != 0 || pipe(out) != 0) throw(string("can't make pipes"));
+  s.pid = fork();
+  if (s.pid < 0) throw(string("fork failed"));
+  if (s.pid == 0) {
+    if (s.how == shared) {
+      // the debug output is thrown away
+      int null = open("/dev/null", O_WRONLY);
+      dup2(null, 1);
+      execl(program.c_str(), program.c_str(), "-shm", shm.c_str(), (char *) 0);
+    } else {
+      dup2(in[0], 0);
+      dup2(out[1], 1);
+      close(in[1]);
+      close(out[0]);
+      if (s.how == frames)
+	execl(program.c_str(), program.c_str(), "-framed", (char *) 0);
+      else execl(program.c_str(), program.c_str(), (char *) 0);
+    }
+    perror(program.c_str());
+    _exit(1);
+  }
+  if (s.how == shared) {
+    s.channel->watchChild(s.pid);
+    s.buf = new shmbuf(s.channel);
+    s.stream = new iostream(s.buf);
+  } else {
+    close(in[0]);
+    close(out[1]);
+    s.to = fdopen(in[1], "w");
+    s.from = fdopen(out[0], "r");
+  }
+}
+
+// sends request and waits for its result
+static string call(solverLink & s, const string & request)
+{
+  string result;
+  string id = to_string(++s.id);
+  if (s.how == lines) {
+    fprintf(s.to, "#%s %s\n", id.c_str(), request.c_str());
+    fflush(s.to);
+    char * line = 0L;
+    size_t room = 0;
+    string mark = "#" + id + " //";
+    for (ssize_t n; (n = getline(&line, &room, s.from)) > 0; )
+      if (strncmp(line, mark.c_str(), mark.size()) == 0) {
+	result.assign(line + mark.size(), n - mark.size() - 1);
+	break;
+      }
+    free(line);
+    return(result);
+  }
+  string rid;
+  size_t length = 0;
+  if (s.how == frames) {
+    fprintf(s.to, "%s %lu\n%s", id.c_str(), (unsigned long) request.size(),
+	    request.c_str());
+    fflush(s.to);
+    char header[64];
+    unsigned long n;
+    if (fscanf(s.from, "%63s %lu", header, &n) != 2 || fgetc(s.from) != '\n')
+      return(result);
+    rid = header;
+    length = n;
+    result.resize(length);
+    if (length > 0 && fread(&result[0], 1, length, s.from) != length)
+      result.clear();
+  } else {
+    *s.stream << id << " " << request.size() << "\n" << request << flush;
+    if (!(*s.stream >> rid >> length) || s.stream->get() != '\n')
+      return(result);
+    result.resize(length);
+    if (length > 0) s.stream->read(&result[0], length);
+  }
+  if (rid != id) cerr << "result " << rid << " for request " << id << endl;
+  return(result);
+}
+
+static void stopSolver(solverLink & s)
+{
+  if (s.how == lines) fprintf(s.to, "exit\n");
+  else if (s.how == frames) fprintf(s.to, "0 4\nexit");
+  if (s.how == shared) {
+    *s.stream << "0 4\nexit" << flush;
+    delete s.stream;
+    delete s.buf;
+    delete s.channel;
+  } else {
+    fclose(s.to);
+    fclose(s.from);
+  }
+  waitpid(s.pid, 0L, 0);
+}
+
+static double percentile(const vector<double> & sorted, double p)
+{
+  return(sorted[(size_t) (p * (sorted.size() - 1))]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  int ncalls = 20000;
+  string program = argv[0];
+  string::size_type slash = program.rfind('/');
+  program = (slash == string::npos ? string("./") : program.substr(0, slash + 1))
+    + "solver-program";
+  int arg = 1;
+
+  for (; arg + 1 < argc && argv[arg][0] == '-'; arg++) {
+    if (strcmp(argv[arg],"-calls") == 0) ncalls = atoi(argv[++arg]);
+    else if (strcmp(argv[arg],"-program") == 0) program = argv[++arg];
+    else break;
+  }
+  if (arg != argc || ncalls <= 0) {
+    cerr << "Usage: " << argv[0] << " [-calls n] [-program file]" << endl;
+    exit(1) ; }
+
+  printf("%-14s %8s %8s %8s %8s %10s\n", "transport", "p50 us", "p90 us",
+	 "p99 us", "max us", "calls/s");
+  int failed = 0;
+  for (int how = lines; how <= shared; how++) {
+    solverLink s;
+    s.how = (transport) how;
+    try {
+      startSolver(s, program);
+    } catch (string message) {
+      cerr << transportName[how] << ": " << message << endl;
+      failed++;
+      continue;
+    }
+    for (int k = 0; problem[k]; k++) call(s, problem[k]);
+    string expected[2];
+    for (int k = 0; k < 2; k++) expected[k] = call(s, calls[k]);
+    if (expected[0].empty() || expected[0].compare(0, 12, "(solverError") == 0) {
+      cerr << transportName[how] << ": no answer from " << program << endl;
+      stopSolver(s);
+      failed++;
+      continue;
+    }
+
+    vector<double> micros(ncalls);
+    int wrong = 0;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    for (int k = 0; k < ncalls; k++) {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      string result = call(s, calls[k % 2]);
+      micros[k] = chrono::duration<double, micro>
+	(chrono::steady_clock::now() - start).count();
+      if (result != expected[k % 2]) wrong++;
+    }
+    double seconds = chrono::duration<double>
+      (chrono::steady_clock::now() - begin).count();
+    stopSolver(s);
+
+    sort(micros.begin(), micros.end());
+    printf("%-14s %8.1f %8.1f %8.1f %8.1f %10.0f\n", transportName[how],
+	   percentile(micros, 0.5), percentile(micros, 0.9),
+	   percentile(micros, 0.99), micros.back(), ncalls / seconds);
+    if (wrong > 0) {
+      cerr << transportName[how] << ": " << wrong << " wrong results" << endl;
+      failed++;
+    }
+  }
+  return(failed == 0 ? 0 : 1);
+}
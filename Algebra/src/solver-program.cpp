@@ -19,16 +19,31 @@
 //////////////////////////////////////////////////////////////////////////////
 #include <iostream>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <map>
+#include <deque>
+#include <list>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include "decl.h"
 #include "extstruct.h"
 #include "Solver.h"
 #include "indysgg.h"
 #include "indyset.h"
 #include "dbg.h"
+#include "solvershm.h"
 using namespace std; 
 
 #define LOGn(s) cout << s << endl
-extern vector<indyset> *listofsets;
 
 int indyCanonHowIndy(int setID, int eqnID, vector<int> * & linexpand,
 		     vector<int> * & mightdepend );
@@ -37,108 +52,697 @@ int indyStudHowIndy(int setID, int eqnID, vector<int> * & linexpand,
 string powersolve(const int howstrong, const string varname, 
 		  const int destslot);
 
-extern vector<valander *> *canongrads;
-extern vector<valander *> studgrads;
 void doinitinit();
+void sessionSelect(const string & name);		// in sessions.cpp
 
-//////////////////////////////////////////////////////////////////////////////
-int main(int argc, char* argv[]) {
-  string buf;
-  
-  if (argc > 2) { cerr << "Usage: " << argv[0] << " [dbgmask]" << endl; 
-    exit(1) ; }
-  if (argc == 2) dbglevel = strtoul(argv[1],0,0);
-  doinitinit();
-#if 0
-  solverDoLog("t");  // make log file
-#endif
-  // Loop through stdin until "exit" and post result into stdout
-  while (getline(std::cin,buf)) {
-    int space;
-    string command, action;
-    char* result=NULL;
+/************************************************************************
+ * dispatchCommand  does one command for the current session and	*
+ *	returns its result, or an error if the command is unknown.	*
+ ************************************************************************/
+static string dispatchCommand(const string & command, const string & action)
+{
+  char* result=NULL;
+
+  if(command == "solverDoLog"){
+    result=solverDoLog(action.c_str());
+  }
+  else if(command == "solverStartLog"){
+    result=solverStartLog(action.c_str());
+  }
+  else if(command == "solverLogSessions"){
+    result=solverLogSessions(action.c_str());
+  }
+  else if(command == "solverLogRotate"){
+    result=solverLogRotate(strtoul(action.c_str(), 0, 10));
+  }
+  else if(command == "solverSolutionCache"){
+    result=solverSolutionCache(action.c_str());
+  }
+  else if(command == "solverStats"){
+    result=solverStats();
+  }
+  else if(command == "solverResetStats"){
+    result=solverResetStats();
+  }
+  else if(command == "solverCheckpoint"){
+    result=solverCheckpoint(action.c_str());
+  }
+  else if(command == "solverRestore"){
+    result=solverRestore(action.c_str());
+  }
+  else if(command == "solverWriteProblemImage"){
+    result=solverWriteProblemImage(action.c_str());
+  }
+  else if(command == "solverLoadProblemImage"){
+    result=solverLoadProblemImage(action.c_str());
+  }
+  else if(command == "solverOpenProblemLibrary"){
+    result=solverOpenProblemLibrary(action.c_str());
+  }
+  else if(command == "solverLoadLibraryProblem"){
+    result=solverLoadLibraryProblem(action.c_str());
+  }
+  else if(command == "solverCreateSession"){
+    result=solverCreateSession(action.c_str());
+  }
+  else if(command == "solverDestroySession"){
+    result=solverDestroySession(action.c_str());
+  }
+  else if(command == "solverBatch"){
+    result=solverBatch(action.c_str());
+  }
+  else if(command == "solverDebugLevel"){
+    result=solverDebugLevel(atoi(action.c_str()));
+  }
+  else if(command == "solveBubble"){
+    result=solveBubble();
+  }
+  else if(command == "solveMoreBubble"){
+    result=solveMoreBubble();
+  }
+  else if(command == "solveAll"){
+    result=solveAll();
+  }
+  else if(command == "solveAdd"){
+    result=solveAdd(action.c_str());
+  }
+  else if(command == "solveClear"){
+    result=solveClear();
+  }
+  else if(command == "c_indyCanonHowIndy"){
+    result=c_indyCanonHowIndy(action.c_str());
+  }
+  else if(command == "c_indyAddVariable"){
+    result=c_indyAddVariable(action.c_str());
+  }
+  else if(command == "c_indyDoneAddVariable"){
+    result=c_indyDoneAddVariable();
+  }
+  else if(command == "c_indyAddEquation"){
+    result=c_indyAddEquation(action.c_str());
+  }
+  else if(command == "c_indyEmpty"){
+    result=c_indyEmpty();
+  }
+  else if(command == "c_indyAddEq2Set"){
+    result=c_indyAddEq2Set(action.c_str());
+  }
+  else if(command == "c_indyKeepNOfSet"){
+    result=c_indyKeepNOfSet(action.c_str());
+  }
+  else if(command == "c_indyStudHowIndy"){
+    result=c_indyStudHowIndy(action.c_str());
+  }
+  else if(command == "c_indyStudentAddEquationOkay"){
+    result=c_indyStudentAddEquationOkay(action.c_str());
+  }
+  else if(command == "c_indyIsStudentEquationOkay"){
+    result=c_indyIsStudentEquationOkay(action.c_str());
+  }
+  else if(command == "c_subInOneEqn"){
+    result=c_subInOneEqn(action.c_str());
+  }
+  else if(command == "c_powersolve"){
+    result=c_powersolve(action.c_str());
+  }
+  else if(command == "c_solveOneEqn"){
+    result=c_solveOneEqn(action.c_str());
+  }
+  else if(command == "c_simplifyEqn"){
+    result=c_simplifyEqn(action.c_str());
+  }
+  else {
+    // error handling for bad command
+    return "(solverError solver-program \"" + command
+      + "\" \"unknown command\")";
+  }
+  return result;
+}
+
+/************************************************************************
+ * runCommand  is dispatchCommand, but always gives a result, so that	*
+ *	each request gets exactly one even if something escapes the	*
+ *	error handling of the routines in Solver.cpp.			*
+ ************************************************************************/
+static string runCommand(const string & command, const string & action)
+{
+  try {
+    return dispatchCommand(command, action);
+  } catch (...) {
+    return "(solverError solver-program \"" + command
+      + "\" \"unexpected and unhandled exception\")";
+  }
+}
+
+/************************************************************************
+ * Session commands are done by the session they name, so the prefix	*
+ *	of "@name solverCreateSession name" is not selected first (it	*
+ *	doesn't exist yet); this lets each line carry the name of the	*
+ *	session it is about.						*
+ ************************************************************************/
+static bool isSessionCommand(const string & command)
+{
+  return(command == "solverCreateSession" || 
+	 command == "solverDestroySession");
+}
+
+// split "[@session ]command[ action]"
+static void parseLine(string buf, string & session, string & command,
+		      string & action)
+{
+  string::size_type space;
+  // A command may be prefixed by "@name " to direct it to
+  // session name; otherwise it goes to the default session.
+  if(buf.size() > 0 && buf[0] == '@'){
     space=buf.find_first_of(" ");
-    if(space != string::npos){  
-      command=buf.substr(0,space);
-      action=buf.substr(space+1); // don't include space itself
-    } else {
-      command=buf;
-      action="";
-    }
-    // debug print
-    // cout << "     Solver got " << command << " " << action << endl;    
+    session=buf.substr(1,space==string::npos ? string::npos : space-1);
+    buf=(space==string::npos) ? string() : buf.substr(space+1);
+  }
+  space=buf.find_first_of(" ");
+  if(space != string::npos){  
+    command=buf.substr(0,space);
+    action=buf.substr(space+1); // don't include space itself
+  } else {
+    command=buf;
+    action="";
+  }
+  // debug print
+  // cout << "     Solver got " << command << " " << action << endl;    
+}
 
-    if(command == "solverDoLog"){
-      result=solverDoLog(action.c_str());
-    }
-    else if(command == "solverStartLog"){
-      result=solverStartLog(action.c_str());
-    }
-    else if(command == "solverDebugLevel"){
-      result=solverDebugLevel(atoi(action.c_str()));
-    }
-    else if(command == "solveBubble"){
-      result=solveBubble();
-    }
-    else if(command == "solveMoreBubble"){
-      result=solveMoreBubble();
-    }
-    else if(command == "solveAdd"){
-      result=solveAdd(action.c_str());
-    }
-    else if(command == "solveClear"){
-      result=solveClear();
+//////////////////////////////////////////////////////////////////////////////
+// Requests and results
+//
+// Normally a request is one line, "[#id ][@session ]command[ action]",
+// and its result is the line "[#id ]//result"; anything else written 
+// to stdout is the solver's debug output.  With -framed, each request 
+// is a header "id length\n" followed by exactly length bytes holding 
+// "[@session ]command[ action]", and each result is a header with the
+// same id and its length followed by the result.  Debug output then
+// goes to stderr, so stdout holds only results; so it does with
+// -threads, as the workers' debug output comes at any time.
+//
+// With -shm name, requests and results are frames as with -framed, but
+// they go through a segment of shared memory made by the client (see
+// solvershm.h) instead of stdin and stdout, which saves the pipe and
+// the system calls on each small call. Debug output stays on stdout.
+//
+// Requests may be sent without waiting for results (pipelined).  Every
+// request gets exactly one result, in the order of the requests (with
+// -threads, in order for each session), whether it succeeds or fails:
+// unknown commands and sessions give a (solverError ...) result, and in
+// line mode a newline in a result is written as a space.  "sync" waits
+// until all earlier requests have their results and then gives "t".
+//////////////////////////////////////////////////////////////////////////////
+struct solverRequest {
+  string id;			// from "#id " or the frame header
+  string session;		// session named in the request
+  string command;
+  string action;
+};
+
+static bool framed = false;
+static ostream * results = &cout;	// where results are written
+static mutex outputLock;		// one result at a time
+
+/************************************************************************
+ * readRequest  reads the next request from in; returns false at end 	*
+ *	of input or if a frame is malformed, which can't be recovered.	*
+ ************************************************************************/
+static bool readRequest(istream & in, solverRequest & r)
+{
+  string buf;
+  r = solverRequest();
+  if (!framed) {
+    if (!getline(in,buf)) return(false);
+    if (buf.size() > 0 && buf[0] == '#') {
+      string::size_type space = buf.find_first_of(" ");
+      r.id = buf.substr(1, space == string::npos ? string::npos : space-1);
+      buf = (space == string::npos) ? string() : buf.substr(space+1);
     }
-    else if(command == "c_indyCanonHowIndy"){
-      result=c_indyCanonHowIndy(action.c_str());
+  } else {
+    long length;
+    if (!(in >> r.id)) return(false);
+    if (!(in >> length) || length < 0 || in.get() != '\n') {
+      cerr << "solver-program: bad frame header for request " << r.id 
+	   << endl;
+      return(false);
     }
-    else if(command == "c_indyAddVariable"){
-      result=c_indyAddVariable(action.c_str());
+    buf.resize(length);
+    if (length > 0 && !in.read(&buf[0], length)) {
+      cerr << "solver-program: request " << r.id << " ended after " 
+	   << in.gcount() << " of " << length << " bytes" << endl;
+      return(false);
     }
-    else if(command == "c_indyDoneAddVariable"){
-      result=c_indyDoneAddVariable();
+  }
+  parseLine(buf, r.session, r.command, r.action);
+  return(true);
+}
+
+/************************************************************************
+ * writeResult  writes the result of request r, with its id in front,	*
+ *	or if it has none, its session name if tagged is set. The	*
+ *	result is put together first and written in one call, so that	*
+ *	nothing else written to the stream can come in the middle of it.*
+ ************************************************************************/
+static void writeResult(const solverRequest & r, const string & result,
+			bool tagged)
+{
+  string out;
+  if (framed) out = r.id + " " + itostr(result.size()) + "\n" + result;
+  else {
+    if (!r.id.empty()) out = "#" + r.id + " ";
+    else if (tagged && !r.session.empty()) out = "@" + r.session + " ";
+    // The solver has a lot of print statements, so we mark
+    // the actual result as a line beginning with two slashes.
+    string::size_type start = out.size() + 2;
+    out += "//" + result + "\n";
+    for (string::size_type k = start; k + 1 < out.size(); k++)
+      if (out[k] == '\n' || out[k] == '\r') out[k] = ' ';
+  }
+  lock_guard<mutex> guard(outputLock);
+  results->write(out.data(), out.size());
+  results->flush();
+}
+
+/************************************************************************
+ * enterSession(name, logged)  makes session name current for the next	*
+ *	command. logged is the session last selected in the log; only	*
+ *	a change from it goes through solverSelectSession, to be logged	*
+ *	and counted, so a replay does each command where it was done	*
+ *	here. Staying in the same session is not a call.		*
+ ************************************************************************/
+static string enterSession(const string & name, string & logged)
+{
+  if (name == logged) {
+    try { sessionSelect(name); return("t"); }
+    catch (string message) { }		// gone: solverSelectSession says so
+  }
+  string result = solverSelectSession(name.c_str());
+  if (result == "t") logged = name;
+  return(result);
+}
+
+// a session destroyed while current leaves the default current
+static void noteDestroyed(const solverRequest & r, const string & result,
+			  string & logged)
+{
+  if (r.command == "solverDestroySession" && result == "t" &&
+      r.action == logged)
+    logged = "";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Worker pool, used with -threads n
+//
+// Each session has a queue of its commands, done in order by one
+// worker at a time.  A session with commands waiting is in the ready
+// queue; a worker takes it, does one command, and puts it back at the
+// end if more are waiting, so sessions share the workers fairly and
+// a slow command holds up only its own session.  Results are written
+// whole, as "@session //result" (or as a frame), in the order they 
+// finish.
+//////////////////////////////////////////////////////////////////////////////
+struct sessionQueue {
+  string name;
+  deque<solverRequest> pending;
+  bool scheduled;		// in the ready queue or being worked on
+  bool retiring;		// in retired, below
+};
+
+static mutex poolLock;			// guards everything below
+static condition_variable poolWork;	// a session became ready
+static condition_variable poolIdle;	// outstanding went to zero
+static deque<sessionQueue *> ready;
+static vector<sessionQueue *> retired;	// idle after a destroy, to be freed
+static int outstanding = 0;		// commands queued or running
+static bool stopping = false;
+
+static void poolSubmit(sessionQueue * q, const solverRequest & r)
+{
+  lock_guard<mutex> guard(poolLock);
+  q->pending.push_back(r);
+  outstanding++;
+  if (!q->scheduled) {
+    q->scheduled = true;
+    ready.push_back(q);
+    poolWork.notify_one();
+  }
+}
+
+static void poolWorker()
+{
+  // holds the results of session commands, which have no session
+  // of their own to select
+  SolverContext scratch;
+  useSolverContext(&scratch);
+  string logged;			// session selected in this thread's log
+  for (;;) {
+    sessionQueue * q;
+    solverRequest r;
+    {
+      unique_lock<mutex> guard(poolLock);
+      while (ready.empty() && !stopping) poolWork.wait(guard);
+      if (ready.empty()) return;
+      q = ready.front();
+      ready.pop_front();
+      r = q->pending.front();
+      q->pending.pop_front();
     }
-    else if(command == "c_indyAddEquation"){
-      result=c_indyAddEquation(action.c_str());
+    string result;
+    if (isSessionCommand(r.command))
+      result = runCommand(r.command, r.action);
+    else {
+      result = enterSession(q->name, logged);
+      if (result == "t") result = runCommand(r.command, r.action);
     }
-    else if(command == "c_indyEmpty"){
-      result=c_indyEmpty();
+    noteDestroyed(r, result, logged);
+    // the session may be destroyed by another thread once q is released
+    useSolverContext(&scratch);
+    writeResult(r, result, true);
+    {
+      lock_guard<mutex> guard(poolLock);
+      if (q->pending.empty()) {
+	q->scheduled = false;
+	// runPool frees the queue of a destroyed session, this thread
+	// being done with it
+	if (r.command == "solverDestroySession" && !q->retiring) {
+	  q->retiring = true;
+	  retired.push_back(q);
+	}
+      } else {
+	ready.push_back(q);
+	poolWork.notify_one();
+      }
+      if (--outstanding == 0) poolIdle.notify_all();
     }
-    else if(command == "c_indyAddEq2Set"){
-      result=c_indyAddEq2Set(action.c_str());
+  }
+}
+
+/************************************************************************
+ * retireQueues  frees the queues of destroyed sessions which are still	*
+ *	idle, so that a server doesn't keep one for every session it	*
+ *	has served. One given more commands since is kept.		*
+ ************************************************************************/
+static void retireQueues(map<string, sessionQueue *> & queues)
+{
+  lock_guard<mutex> guard(poolLock);
+  for (size_t k = 0; k < retired.size(); k++) {
+    sessionQueue * q = retired[k];
+    q->retiring = false;
+    if (q->scheduled) continue;
+    queues.erase(q->name);
+    delete q;
+  }
+  retired.clear();
+}
+
+/************************************************************************
+ * runPool  reads commands and hands them to nthreads workers until	*
+ *	"exit" or end of input, then waits for them all to be done.	*
+ ************************************************************************/
+static void runPool(istream & in, int nthreads)
+{
+  map<string, sessionQueue *> queues;	// used by this thread only
+  vector<thread> workers;
+  solverRequest r;
+  for (int k = 0; k < nthreads; k++) workers.push_back(thread(poolWorker));
+  while (readRequest(in,r)) {
+    if(r.command == "exit") break;
+    if(r.command == "sync") {
+      unique_lock<mutex> guard(poolLock);
+      while (outstanding > 0) poolIdle.wait(guard);
+      guard.unlock();
+      retireQueues(queues);
+      writeResult(r, "t", true);
+      continue;
     }
-    else if(command == "c_indyKeepNOfSet"){
-      result=c_indyKeepNOfSet(action.c_str());
+    // commands for one session, including making and destroying it, 
+    // go through one queue
+    const string & name = isSessionCommand(r.command) ? r.action : r.session;
+    retireQueues(queues);
+    sessionQueue * & q = queues[name];
+    if (q == 0L) {
+      q = new sessionQueue;
+      q->name = name;
+      q->scheduled = false;
+      q->retiring = false;
     }
-    else if(command == "c_indyStudHowIndy"){
-      result=c_indyStudHowIndy(action.c_str());
+    poolSubmit(q, r);
+  }
+  {
+    unique_lock<mutex> guard(poolLock);
+    while (outstanding > 0) poolIdle.wait(guard);
+    stopping = true;
+    poolWork.notify_all();
+  }
+  for (int k = 0; k < nthreads; k++) workers[k].join();
+  retired.clear();
+  for (map<string, sessionQueue *>::iterator it = queues.begin(); 
+       it != queues.end(); ++it)
+    delete it->second;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Templates, used with -zygote n
+//
+// Each session is kept as a warm template of its problem.  A problem is
+// loaded once, with the usual commands for its session, and then
+// "solverFork name" makes a child process holding a copy of session
+// name, shared copy-on-write, which is ready at once.  The result is 
+// ("socket" pid): the child takes one connection on the unix socket
+// and serves requests on it just as solver-program does on stdin and
+// stdout, with requests naming no session going to its copy of name.
+// Only the n most recently used sessions are kept; making another 
+// destroys the least recently used.
+//////////////////////////////////////////////////////////////////////////////
+static int maxTemplates = 0;		// 0 unless -zygote
+static list<string> templates;		// most recently used first
+static string forkedSession;		// in a child, the session it serves
+static string loggedSession;		// as for enterSession
+static int forkCount = 0;
+static const int connectWait = 60000;	// ms a child waits for its client
+
+// a streambuf reading and writing a file descriptor, for the child
+class fdbuf : public streambuf
+{
+public:
+  fdbuf(int fd) : fd(fd) { setg(in, in, in); setp(out, out + sizeof(out)); }
+  ~fdbuf() { sync(); close(fd); }
+protected:
+  int underflow() {
+    ssize_t n;
+    do n = read(fd, in, sizeof(in)); while (n < 0 && errno == EINTR);
+    if (n <= 0) return(EOF);
+    setg(in, in, in + n);
+    return((unsigned char) *gptr());
+  }
+  int overflow(int c) {
+    if (sync() != 0) return(EOF);
+    if (c != EOF) { *pptr() = c; pbump(1); }
+    return(c == EOF ? 0 : c);
+  }
+  int sync() {
+    for (char * p = pbase(); p < pptr(); ) {
+      ssize_t n = write(fd, p, pptr() - p);
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return(-1);
+      p += n;
     }
-    else if(command == "c_indyStudentAddEquationOkay"){
-      result=c_indyStudentAddEquationOkay(action.c_str());
+    setp(out, out + sizeof(out));
+    return(0);
+  }
+private:
+  int fd;
+  char in[4096], out[4096];
+};
+
+// name was used: it becomes the most recent template
+static void touchTemplate(const string & name)
+{
+  for (list<string>::iterator it = templates.begin(); 
+       it != templates.end(); ++it)
+    if (*it == name) {
+      templates.splice(templates.begin(), templates, it);
+      return;
     }
-    else if(command == "c_indyIsStudentEquationOkay"){
-      result=c_indyIsStudentEquationOkay(action.c_str());
+}
+
+// keeps track of the templates after request r gave result
+static void noteTemplates(const solverRequest & r, const string & result)
+{
+  if (r.command == "solverCreateSession" && result == "t") {
+    templates.push_front(r.action);
+    while ((int) templates.size() > maxTemplates) {
+      solverDestroySession(templates.back().c_str());
+      templates.pop_back();
     }
-    else if(command == "c_subInOneEqn"){
-      result=c_subInOneEqn(action.c_str());
+  } else if (r.command == "solverDestroySession" && result == "t")
+    templates.remove(r.action);
+  else if (!r.session.empty()) touchTemplate(r.session);
+}
+
+static void serveRequests(istream & in);
+
+/************************************************************************
+ * forkTemplate(name)  makes a child holding session name and returns	*
+ *	("socket" pid), or an error. The child serves the connection	*
+ *	on socket and exits, never returning.				*
+ ************************************************************************/
+static string forkTemplate(const string & name)
+{
+  string error = "(solverError solverFork \"" + name + "\" ";
+  if (maxTemplates == 0) return(error + "\"not started with -zygote\")");
+  if (name.empty()) return(error + "\"no such template\")");
+  SolverContext * previous = solverContext();
+  try { sessionSelect(name); }
+  catch (string message) { return(error + "\"no such template\")"); }
+  useSolverContext(previous);
+  touchTemplate(name);
+
+  const char * tmpdir = getenv("TMPDIR");
+  string path = string(tmpdir ? tmpdir : "/tmp") + "/solver-" 
+    + itostr(getpid()) + "-" + itostr(++forkCount);
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path))
+    return(error + "\"socket path too long\")");
+  strcpy(addr.sun_path, path.c_str());
+  unlink(path.c_str());
+  // the socket is listening before the client hears of it
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0 || bind(listener, (sockaddr *) &addr, sizeof(addr)) < 0 ||
+      listen(listener, 1) < 0) {
+    if (listener >= 0) close(listener);
+    return(error + "\"can't make socket " + path + "\")");
+  }
+  cout.flush();
+  results->flush();
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(listener);
+    unlink(path.c_str());
+    return(error + "\"fork failed\")");
+  }
+  if (pid > 0) {
+    close(listener);
+    return("(\"" + path + "\" " + itostr(pid) + ")");
+  }
+
+  // the child lets go of the parent's stdin and stdout
+  close(0);
+  dup2(2, 1);
+  cout.rdbuf(cerr.rdbuf());
+  pollfd waiting = { listener, POLLIN, 0 };
+  int connection = -1;
+  if (poll(&waiting, 1, connectWait) > 0) connection = accept(listener, 0, 0);
+  close(listener);
+  unlink(path.c_str());
+  if (connection >= 0) {
+    fdbuf channel(connection);
+    istream in(&channel);
+    ostream out(&channel);
+    results = &out;
+    forkedSession = name;
+    maxTemplates = 0;
+    serveRequests(in);
+    out.flush();
+  }
+  closeupshop();
+  exit(0);
+}
+
+/************************************************************************
+ * serveRequests  does the requests read from in, one at a time, until	*
+ *	"exit" or end of input						*
+ ************************************************************************/
+static void serveRequests(istream & in)
+{
+  solverRequest r;
+  // Loop through requests until "exit" and post each result
+  while (readRequest(in,r)) {
+    string result;
+    if(r.command == "exit") break;
+    // results are written as each command is done
+    if(r.command == "sync") { writeResult(r, "t", false); continue; }
+    if(r.command == "solverFork") {
+      writeResult(r, forkTemplate(r.action), false);
+      continue;
     }
-    else if(command == "c_powersolve"){
-      result=c_powersolve(action.c_str());
+    if(r.session.empty()) r.session = forkedSession;
+    result=enterSession(isSessionCommand(r.command) && 
+			r.session == r.action ? "" : r.session, loggedSession);
+    if(result == "t") result=runCommand(r.command, r.action);
+    noteDestroyed(r, result, loggedSession);
+    writeResult(r, result, false);
+    if (maxTemplates > 0) noteTemplates(r, result);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  int nthreads = 0;
+  string shm;
+  int arg = 1;
+
+  for (; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (strcmp(argv[arg],"-framed") == 0) framed = true;
+    else if (arg + 1 < argc && strcmp(argv[arg],"-shm") == 0) {
+      shm = argv[++arg];
+      framed = true;
     }
-    else if(command == "c_solveOneEqn"){
-      result=c_solveOneEqn(action.c_str());
+    else if (arg + 1 < argc && strcmp(argv[arg],"-threads") == 0)
+      nthreads = atoi(argv[++arg]);
+    else if (arg + 1 < argc && strcmp(argv[arg],"-cache") == 0)
+      solverSolutionCache(argv[++arg]);
+    else if (arg + 1 < argc && strcmp(argv[arg],"-zygote") == 0)
+      maxTemplates = atoi(argv[++arg]);
+    else if (arg + 1 < argc && strcmp(argv[arg],"-library") == 0) {
+      string opened = solverOpenProblemLibrary(argv[++arg]);
+      if (opened != "t") { cerr << opened << endl; exit(1); }
     }
-    else if(command == "c_simplifyEqn"){
-      result=c_simplifyEqn(action.c_str());
-    }     
-    else if(command == "exit"){
-      break;
-    } else {
-      // error handling for bad command
+    else break;
+  }
+  if (argc > arg + 1 || (arg < argc && argv[arg][0] == '-') || nthreads < 0 ||
+      maxTemplates < 0 || (maxTemplates > 0 && nthreads > 0)) { 
+    cerr << "Usage: " << argv[0] << " [-framed | -shm name]"
+	 << " [-threads n | -zygote n]"
+	 << " [-cache dir] [-library file] [dbgmask]" << endl; 
+    exit(1) ; }
+  if (argc == arg + 1) dbglevel = strtoul(argv[arg],0,0);
+  shmChannel * channel = 0L;
+  shmbuf * channelbuf = 0L;
+  if (!shm.empty()) {
+    try {
+      channel = shmChannel::attach(shm);
+    } catch (string message) {
+      cerr << "solver-program: " << message << endl;
+      exit(1);
     }
-    // The solver has a lot of print statements, so we mark
-    // the actual result as a line beginning with two slashes.
-    cout << "//" << result << endl;
+    channelbuf = new shmbuf(channel);
+    results = new ostream(channelbuf);
+  } else if (framed || nthreads > 0) {
+    // results keep stdout; everything else written to cout goes to stderr,
+    // where with -threads it can't come between the parts of a result
+    results = new ostream(cout.rdbuf());
+    cout.rdbuf(cerr.rdbuf());
+  }
+  doinitinit();
+#if 0
+  solverDoLog("t");  // make log file
+#endif
+  istream requests(channelbuf ? channelbuf : std::cin.rdbuf());
+  if (nthreads > 0) runPool(requests, nthreads);
+  else {
+    // children are not waited for
+    if (maxTemplates > 0) signal(SIGCHLD, SIG_IGN);
+    serveRequests(requests);
+  }
+  if (channel) {
+    results->flush();
+    delete channelbuf;
+    delete channel;		// the client sees the end of the results
   }
   closeupshop();
   return 0;
@@ -0,0 +1,348 @@
+//////////////////////////////////////////////////////////////////////////////
+// solver-replay.cpp -- replay solver logs, checking and timing each call
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+//  solver-replay [-threads n] [-repeat n] [-tolerance x] log...
+//  reads logs made by solverDoLog("t") (see solverlog.cpp), does their
+//  calls again and compares each result with the one logged. It then
+//  gives, for each command, the percentiles of the time its calls took,
+//  and for all of them the number of calls a second.
+//  Each replay has a session of its own, replayN, standing for the
+//  default session of the log; a session s made by the log is replayN-s.
+//  So with -threads n, n replays run at once as a load test, each log
+//  replayed -repeat times. With -tolerance x, a command whose median
+//  time is more than x times its median in the logs (from the //@ lines)
+//  is too slow. The exit status is 1 if any result differs or any
+//  command is too slow, so the replay can gate a change.
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include "decl.h"
+#include "Solver.h"
+#include "dbg.h"
+using namespace std;
+
+void doinitinit();
+
+typedef char * (*noArgCommand)();
+typedef char * (*argCommand)(const char* const);
+
+// the routines of Solver.h that are logged
+static const struct {
+  const char * name;
+  noArgCommand noArg;
+  argCommand withArg;
+} commands[] = {
+  { "solveBubble", solveBubble, 0L },
+  { "solveMoreBubble", solveMoreBubble, 0L },
+  { "solveAll", solveAll, 0L },
+  { "solveAdd", 0L, solveAdd },
+  { "solveClear", solveClear, 0L },
+  { "c_powersolve", 0L, c_powersolve },
+  { "c_simplifyEqn", 0L, c_simplifyEqn },
+  { "c_solveOneEqn", 0L, c_solveOneEqn },
+  { "c_subInOneEqn", 0L, c_subInOneEqn },
+  { "c_indyAddVariable", 0L, c_indyAddVariable },
+  { "c_indyDoneAddVariable", c_indyDoneAddVariable, 0L },
+  { "c_indyAddEquation", 0L, c_indyAddEquation },
+  { "c_indyEmpty", c_indyEmpty, 0L },
+  { "c_indyAddEq2Set", 0L, c_indyAddEq2Set },
+  { "c_indyKeepNOfSet", 0L, c_indyKeepNOfSet },
+  { "c_indyStudentAddEquationOkay", 0L, c_indyStudentAddEquationOkay },
+  { "c_indyIsStudentEquationOkay", 0L, c_indyIsStudentEquationOkay },
+  { "c_indyCanonHowIndy", 0L, c_indyCanonHowIndy },
+  { "c_indyStudHowIndy", 0L, c_indyStudHowIndy },
+  { "solverBatch", 0L, solverBatch },
+  { "solverCheckpoint", 0L, solverCheckpoint },
+  { "solverRestore", 0L, solverRestore },
+  { "solverWriteProblemImage", 0L, solverWriteProblemImage },
+  { "solverLoadProblemImage", 0L, solverLoadProblemImage },
+  { "solverOpenProblemLibrary", 0L, solverOpenProblemLibrary },
+  { "solverLoadLibraryProblem", 0L, solverLoadLibraryProblem },
+  { "solverCreateSession", 0L, solverCreateSession },
+  { "solverDestroySession", 0L, solverDestroySession },
+  { "solverSelectSession", 0L, solverSelectSession },
+  { "solverSolutionCache", 0L, solverSolutionCache },
+  { "solverStats", solverStats, 0L },
+  { "solverResetStats", solverResetStats, 0L },
+};
+static const int numCommands = sizeof(commands) / sizeof(commands[0]);
+
+static bool isSessionCommand(const string & name)
+{
+  return(name == "solverCreateSession" || name == "solverDestroySession" ||
+	 name == "solverSelectSession");
+}
+
+// whose results differ from run to run
+static bool isUncheckedCommand(const string & name)
+{
+  return(name == "solverStats" || name == "solverResetStats");
+}
+
+struct loggedCall {
+  int line;			// in the log file
+  int command;			// index in commands
+  string arg;
+  bool hasResult;
+  string result;		// as logged
+  long micros;			// as logged, or -1
+};
+
+struct replayLog {
+  string file;
+  vector<loggedCall> calls;
+};
+
+/************************************************************************
+ * readLog(log)  reads the calls in log.file, each with its result and	*
+ *	time if they were logged. Returns an error, or "" if all is well.*
+ ************************************************************************/
+static string readLog(replayLog & log)
+{
+  ifstream in(log.file.c_str());
+  if (!in) return("can't open " + log.file);
+  string line;
+  bool openResult = false;	// a result with new lines in it
+  for (int lineno = 1; getline(in, line); lineno++) {
+    if (openResult) {
+      string & result = log.calls.back().result;
+      result += "\n" + line;
+      openResult = result.empty() || result[result.size()-1] != ';';
+      if (!openResult) result.erase(result.size()-1);
+      continue;
+    }
+    if (line.empty() || line == "Begin") continue;
+    if (line.compare(0, 3, "//@") == 0) {
+      string::size_type us = line.rfind("us");
+      string::size_type space = line.rfind(' ', us);
+      if (!log.calls.empty() && us != string::npos && space != string::npos)
+	log.calls.back().micros = atol(line.c_str() + space + 1);
+      continue;
+    }
+    if (line.compare(0, 2, "//") == 0) {
+      if (log.calls.empty()) continue;
+      loggedCall & call = log.calls.back();
+      call.hasResult = true;
+      call.result = line.substr(line.compare(0, 3, "// ") == 0 ? 3 : 2);
+      openResult = call.result.empty() ||
+	call.result[call.result.size()-1] != ';';
+      if (!openResult) call.result.erase(call.result.size()-1);
+      continue;
+    }
+    // a call: name("arg"); or name();
+    string::size_type paren = line.find('(');
+    string::size_type close = line.rfind(");");
+    if (paren == string::npos || close == string::npos || close < paren)
+      return(log.file + ":" + itostr(lineno) + ": can't read " + line);
+    loggedCall call;
+    call.line = lineno;
+    call.hasResult = false;
+    call.micros = -1;
+    string name = line.substr(0, paren);
+    for (call.command = 0; call.command < numCommands; call.command++)
+      if (name == commands[call.command].name) break;
+    if (call.command == numCommands)
+      return(log.file + ":" + itostr(lineno) + ": unknown command " + name);
+    call.arg = line.substr(paren + 1, close - paren - 1);
+    if (call.arg.size() >= 2 && call.arg[0] == '"' &&
+	call.arg[call.arg.size()-1] == '"')
+      call.arg = call.arg.substr(1, call.arg.size() - 2);
+    log.calls.push_back(call);
+  }
+  return("");
+}
+
+// what one thread measured and found
+struct replayStats {
+  vector<vector<long> > micros;		// by command
+  vector<vector<long> > logged;		// by command
+  long calls;
+  long mismatches;
+  replayStats() : micros(numCommands), logged(numCommands),
+		  calls(0), mismatches(0) {}
+};
+
+static mutex reportLock;
+static const int maxReported = 10;	// mismatches for each replay
+
+/************************************************************************
+ * replay(log, k, stats)  does the calls of log in sessions of replay k,*
+ *	adding their times to stats and reporting results that differ	*
+ ************************************************************************/
+static void replay(const replayLog & log, int k, replayStats & stats)
+{
+  string mine = "replay" + itostr(k);
+  string prefix = mine + "-";
+  set<string> made;
+  solverCreateSession(mine.c_str());
+  solverSelectSession(mine.c_str());
+  int reported = 0;
+
+  for (size_t c = 0; c < log.calls.size(); c++) {
+    const loggedCall & call = log.calls[c];
+    const string & name = commands[call.command].name;
+    string arg = call.arg;
+    if (isSessionCommand(name)) {
+      arg = arg.empty() ? mine : prefix + arg;
+      if (name == "solverCreateSession") made.insert(arg);
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    string result = commands[call.command].noArg ?
+      commands[call.command].noArg() : commands[call.command].withArg(arg.c_str());
+    long took = chrono::duration_cast<chrono::microseconds>
+      (chrono::steady_clock::now() - start).count();
+    stats.micros[call.command].push_back(took);
+    if (call.micros >= 0) stats.logged[call.command].push_back(call.micros);
+    stats.calls++;
+
+    if (!call.hasResult || isUncheckedCommand(name)) continue;
+    // session names are given back as the log had them
+    for (string::size_type at; (at = result.find(prefix)) != string::npos; )
+      result.erase(at, prefix.size());
+    if (result == call.result) continue;
+    stats.mismatches++;
+    if (reported++ < maxReported) {
+      lock_guard<mutex> guard(reportLock);
+      cout << log.file << ":" << call.line << ": " << name << " returned "
+	   << result.substr(0, 200) << endl << "  but the log has "
+	   << call.result.substr(0, 200) << endl;
+    }
+  }
+  if (reported > maxReported) {
+    lock_guard<mutex> guard(reportLock);
+    cout << log.file << ": " << reported - maxReported
+	 << " more results differ" << endl;
+  }
+
+  solverSelectSession("");
+  for (set<string>::iterator s = made.begin(); s != made.end(); ++s)
+    solverDestroySession(s->c_str());
+  solverDestroySession(mine.c_str());
+}
+
+static long percentile(const vector<long> & sorted, int p)
+{
+  if (sorted.empty()) return(0);
+  size_t at = (sorted.size() * p + 99) / 100;
+  return(sorted[at > 0 ? at - 1 : 0]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  int nthreads = 1;
+  int repeat = 1;
+  double tolerance = 0;
+  int arg = 1;
+
+  for (; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (arg + 1 < argc && strcmp(argv[arg],"-threads") == 0)
+      nthreads = atoi(argv[++arg]);
+    else if (arg + 1 < argc && strcmp(argv[arg],"-repeat") == 0)
+      repeat = atoi(argv[++arg]);
+    else if (arg + 1 < argc && strcmp(argv[arg],"-tolerance") == 0)
+      tolerance = atof(argv[++arg]);
+    else break;
+  }
+  if (arg >= argc || argv[arg][0] == '-' || nthreads < 1 || repeat < 1 ||
+      tolerance < 0) {
+    cerr << "Usage: " << argv[0] << " [-threads n] [-repeat n]"
+	 << " [-tolerance x] log..." << endl;
+    exit(1) ; }
+
+  vector<replayLog> logs(argc - arg);
+  for (size_t k = 0; k < logs.size(); k++) {
+    logs[k].file = argv[arg + k];
+    string error = readLog(logs[k]);
+    if (!error.empty()) { cerr << error << endl; exit(1); }
+  }
+  doinitinit();
+
+  // replays are taken in turn by the threads
+  int replays = logs.size() * repeat;
+  atomic<int> next(0);
+  vector<replayStats> stats(nthreads);
+  vector<thread *> threads;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int t = 0; t < nthreads; t++)
+    threads.push_back(new thread([&, t] {
+	  for (int k; (k = next++) < replays; )
+	    replay(logs[k % logs.size()], k, stats[t]);
+	}));
+  for (int t = 0; t < nthreads; t++) {
+    threads[t]->join();
+    delete threads[t];
+  }
+  double seconds = chrono::duration<double>
+    (chrono::steady_clock::now() - start).count();
+
+  replayStats all;
+  for (int t = 0; t < nthreads; t++) {
+    all.calls += stats[t].calls;
+    all.mismatches += stats[t].mismatches;
+    for (int c = 0; c < numCommands; c++) {
+      all.micros[c].insert(all.micros[c].end(), stats[t].micros[c].begin(),
+			   stats[t].micros[c].end());
+      all.logged[c].insert(all.logged[c].end(), stats[t].logged[c].begin(),
+			   stats[t].logged[c].end());
+    }
+  }
+
+  int slow = 0;
+  char row[200];
+  snprintf(row, sizeof(row), "%-30s %8s %8s %8s %8s %8s %8s", "command",
+	   "calls", "p50us", "p90us", "p99us", "maxus", "logged");
+  cout << row << endl;
+  for (int c = 0; c < numCommands; c++) {
+    vector<long> & m = all.micros[c];
+    if (m.empty()) continue;
+    sort(m.begin(), m.end());
+    sort(all.logged[c].begin(), all.logged[c].end());
+    long logged = percentile(all.logged[c], 50);
+    string then = all.logged[c].empty() ? "-" : itostr(logged);
+    snprintf(row, sizeof(row), "%-30s %8lu %8ld %8ld %8ld %8ld %8s",
+	     commands[c].name, (unsigned long) m.size(), percentile(m, 50),
+	     percentile(m, 90), percentile(m, 99), m.back(), then.c_str());
+    cout << row;
+    // a call too quick to time isn't slow
+    if (tolerance > 0 && !all.logged[c].empty() && percentile(m, 50) >
+	max(tolerance * logged, 1.0 * tolerance)) {
+      cout << "  too slow";
+      slow++;
+    }
+    cout << endl;
+  }
+  snprintf(row, sizeof(row), "%ld calls in %d replays, %.3f s, %.0f calls/s",
+	   all.calls, replays, seconds, seconds > 0 ? all.calls / seconds : 0.0);
+  cout << row << endl;
+  cout << all.mismatches << " results differ from the logs";
+  if (tolerance > 0) cout << ", " << slow << " commands too slow";
+  cout << endl;
+  return(all.mismatches == 0 && slow == 0 ? 0 : 1);
+}
@@ -0,0 +1,320 @@
+// solverapi.cpp
+//    The C interface to the solver, see solverapi.h
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  Each call makes the context current for the thread, calls the
+//  routine of Solver.h, so it is logged and counted as any other, and
+//  puts the current context back. A (solverError routine args "what")
+//  result becomes SOLVER_FAILED with just "what". A result too long
+//  for the caller's buffer is kept until solver_fetch_result, as the
+//  routine can't be called again without doing it twice.
+
+#include "decl.h"
+#include "extstruct.h"
+#include "Solver.h"
+#include "solverapi.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+
+using namespace std;
+
+void doinitinit();			// in coldriver.cpp
+
+struct solver_context {
+  SolverContext * ctx;
+  bool kept;			// a result too long for the caller's buffer
+  int keptCode;			// and the code it would have had
+  string keptResult;
+};
+
+typedef char * (*noArgRoutine)();
+typedef char * (*argRoutine)(const char* const);
+typedef char * (*numberRoutine)(const unsigned long int);
+
+struct apiRoutine {
+  noArgRoutine noArg;
+  argRoutine withArg;
+  numberRoutine withNumber;
+};
+
+static map<string, apiRoutine> routines;
+static once_flag routinesMade;
+
+static void add(const char * name, noArgRoutine f)
+{
+  apiRoutine r = { f, 0L, 0L };
+  routines[name] = r;
+}
+static void add(const char * name, argRoutine f)
+{
+  apiRoutine r = { 0L, f, 0L };
+  routines[name] = r;
+}
+static void add(const char * name, numberRoutine f)
+{
+  apiRoutine r = { 0L, 0L, f };
+  routines[name] = r;
+}
+
+// the routines of Solver.h, except those for sessions and solveBubbleFile
+static void makeRoutines()
+{
+  add("solveBubble", solveBubble);
+  add("solveMoreBubble", solveMoreBubble);
+  add("solveAll", solveAll);
+  add("solveAdd", solveAdd);
+  add("solveClear", solveClear);
+  add("c_powersolve", c_powersolve);
+  add("c_simplifyEqn", c_simplifyEqn);
+  add("c_solveOneEqn", c_solveOneEqn);
+  add("c_subInOneEqn", c_subInOneEqn);
+  add("c_indyAddVariable", c_indyAddVariable);
+  add("c_indyDoneAddVariable", c_indyDoneAddVariable);
+  add("c_indyAddEquation", c_indyAddEquation);
+  add("c_indyEmpty", c_indyEmpty);
+  add("c_indyAddEq2Set", c_indyAddEq2Set);
+  add("c_indyKeepNOfSet", c_indyKeepNOfSet);
+  add("c_indyStudentAddEquationOkay", c_indyStudentAddEquationOkay);
+  add("c_indyIsStudentEquationOkay", c_indyIsStudentEquationOkay);
+  add("c_indyCanonHowIndy", c_indyCanonHowIndy);
+  add("c_indyStudHowIndy", c_indyStudHowIndy);
+  add("solverBatch", solverBatch);
+  add("solverCheckpoint", solverCheckpoint);
+  add("solverRestore", solverRestore);
+  add("solverWriteProblemImage", solverWriteProblemImage);
+  add("solverLoadProblemImage", solverLoadProblemImage);
+  add("solverOpenProblemLibrary", solverOpenProblemLibrary);
+  add("solverLoadLibraryProblem", solverLoadLibraryProblem);
+  add("solverDoLog", solverDoLog);
+  add("solverStartLog", solverStartLog);
+  add("solverDebugLevel", solverDebugLevel);
+  add("solverLogSessions", solverLogSessions);
+  add("solverLogRotate", solverLogRotate);
+  add("solverSolutionCache", solverSolutionCache);
+  add("solverStats", solverStats);
+  add("solverResetStats", solverResetStats);
+}
+
+/************************************************************************
+ * where the solver's debugging output goes. cout is given a buffer	*
+ *	passing on what the program writes to the one cout had, but	*
+ *	throwing away what is written by a thread while it is in the	*
+ *	solver (see solverOutput), or sending it to the file given to	*
+ *	solver_debug_output.						*
+ ************************************************************************/
+static ofstream debugFile;
+static mutex debugLock;
+static once_flag outputSet;
+static thread_local bool inSolver = false;
+
+class splitbuf : public streambuf
+{
+public:
+  splitbuf() : host(0L) { }
+  streambuf * host;		// what cout had
+protected:
+  int overflow(int c) {
+    if (c == EOF) return(0);
+    char ch = (char) c;
+    return(xsputn(&ch, 1) == 1 ? c : EOF);
+  }
+  streamsize xsputn(const char * s, streamsize n) {
+    if (!inSolver) return(host ? host->sputn(s, n) : n);
+    lock_guard<mutex> guard(debugLock);
+    if (debugFile.is_open()) debugFile.write(s, n);
+    return(n);
+  }
+  int sync() {
+    if (!inSolver) return(host ? host->pubsync() : 0);
+    lock_guard<mutex> guard(debugLock);
+    if (debugFile.is_open()) debugFile.flush();
+    return(0);
+  }
+};
+
+static splitbuf split;
+
+static void splitOutput() { split.host = cout.rdbuf(&split); }
+
+// while one is in scope, what the thread writes to cout is the solver's
+class solverOutput
+{
+public:
+  solverOutput() : was(inSolver) { inSolver = true; }
+  ~solverOutput() { inSolver = was; }
+private:
+  bool was;
+};
+
+int solver_debug_output(const char * file)
+{
+  call_once(outputSet, splitOutput);
+  lock_guard<mutex> guard(debugLock);
+  if (debugFile.is_open()) debugFile.close();
+  if (file == 0L) return(SOLVER_OK);
+  debugFile.clear();
+  debugFile.open(file, ios::app);
+  if (!debugFile) return(SOLVER_BAD_ARGUMENT);
+  return(SOLVER_OK);
+}
+
+/************************************************************************
+ * solver_open, solver_close  make and free a context, as sessions.cpp	*
+ *	does for a session						*
+ ************************************************************************/
+solver_context * solver_open(void)
+{
+  call_once(routinesMade, makeRoutines);
+  call_once(outputSet, splitOutput);
+  solver_context * context = new(nothrow) solver_context;
+  if (context == 0L) return(0L);
+  context->kept = false;
+  try {
+    context->ctx = new SolverContext;
+  } catch (...) {
+    delete context;
+    return(0L);
+  }
+  solverOutput quiet;
+  SolverContext * previous = useSolverContext(context->ctx);
+  try { doinitinit(); }
+  catch (...) {
+    useSolverContext(previous);
+    delete context->ctx;
+    delete context;
+    return(0L);
+  }
+  useSolverContext(previous);
+  return(context);
+}
+
+void solver_close(solver_context * context)
+{
+  if (context == 0L) return;
+  solverOutput quiet;
+  delete context->ctx;		// which leaves the default current if it was
+  delete context;
+}
+
+// "what" from (solverError routine arg "what"), or the whole if it isn't so
+static string errorDescription(const string & result, const string & arg)
+{
+  string::size_type space = result.find(' ', 13);
+  if (space == string::npos) return(result);
+  string head = " " + arg + " \"";
+  if (result.compare(space, head.size(), head) != 0 ||
+      result.size() < space + head.size() + 2 ||
+      result.compare(result.size() - 2, 2, "\")") != 0)
+    return(result);
+  return(result.substr(space + head.size(),
+		       result.size() - space - head.size() - 2));
+}
+
+// copies answer to out as solver_call does, returning code or, if it
+// doesn't fit, SOLVER_TOO_SMALL
+static int copyResult(const char * answer, int code, char * out, size_t size,
+		      size_t * length)
+{
+  size_t n = strlen(answer) + 1;
+  if (length) *length = n;
+  if (n > size) {
+    code = SOLVER_TOO_SMALL;
+    n = size;
+  }
+  if (n > 0) {
+    memcpy(out, answer, n - 1);
+    out[n - 1] = '\0';
+  }
+  return(code);
+}
+
+/************************************************************************
+ * solver_call  see solverapi.h						*
+ ************************************************************************/
+int solver_call(solver_context * context, const char * command,
+		const char * arg, char * out, size_t size, size_t * length)
+{
+  call_once(routinesMade, makeRoutines);
+  if (context == 0L || command == 0L || (out == 0L && size > 0))
+    return(SOLVER_BAD_ARGUMENT);
+  context->kept = false;
+  context->keptResult.clear();
+  map<string, apiRoutine>::const_iterator it = routines.find(command);
+  if (it == routines.end()) return(SOLVER_UNKNOWN_COMMAND);
+  const apiRoutine & r = it->second;
+  if (r.noArg == 0L && arg == 0L) return(SOLVER_BAD_ARGUMENT);
+  unsigned long number = 0;
+  if (r.withNumber) {
+    char * end;
+    number = strtoul(arg, &end, 0);
+    if (*arg == '\0' || *end != '\0') return(SOLVER_BAD_ARGUMENT);
+  }
+
+  solverOutput quiet;
+  SolverContext * previous = useSolverContext(context->ctx);
+  const char * answer = r.noArg ? r.noArg() :
+    r.withArg ? r.withArg(arg) : r.withNumber(number);
+  int code = SOLVER_OK;
+  string description;
+  if (strncmp(answer, "(solverError ", 13) == 0) {
+    code = SOLVER_FAILED;
+    description = errorDescription(answer, arg ? arg : "");
+    answer = description.c_str();
+  }
+  int copied = copyResult(answer, code, out, size, length);
+  if (copied == SOLVER_TOO_SMALL) {
+    context->kept = true;
+    context->keptCode = code;
+    context->keptResult = answer;
+  }
+  useSolverContext(previous);
+  return(copied);
+}
+
+/************************************************************************
+ * solver_fetch_result  see solverapi.h					*
+ ************************************************************************/
+int solver_fetch_result(solver_context * context, char * out, size_t size,
+			size_t * length)
+{
+  if (context == 0L || !context->kept || (out == 0L && size > 0))
+    return(SOLVER_BAD_ARGUMENT);
+  int code = copyResult(context->keptResult.c_str(), context->keptCode,
+			out, size, length);
+  if (code != SOLVER_TOO_SMALL) {
+    context->kept = false;
+    context->keptResult.clear();
+  }
+  return(code);
+}
+
+const char * solver_code_name(int code)
+{
+  switch (code) {
+  case SOLVER_OK: return("SOLVER_OK");
+  case SOLVER_FAILED: return("SOLVER_FAILED");
+  case SOLVER_TOO_SMALL: return("SOLVER_TOO_SMALL");
+  case SOLVER_UNKNOWN_COMMAND: return("SOLVER_UNKNOWN_COMMAND");
+  case SOLVER_BAD_ARGUMENT: return("SOLVER_BAD_ARGUMENT");
+  }
+  return("unknown solver code");
+}
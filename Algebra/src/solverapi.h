@@ -0,0 +1,101 @@
+/* solverapi.h	calling the solver from within another program
+ * Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+ *
+ *  This file is part of the Andes Solver.
+ *
+ *  The Andes Solver is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The Andes Solver is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*  A C interface to libSolver, for a program (such as the Lisp help
+ *  system, through its foreign function interface) that loads the
+ *  library instead of running solver-program:
+ *
+ *	solver_context * s = solver_open();
+ *	char answer[4096];
+ *	size_t length;
+ *	int code = solver_call(s, "c_indyIsStudentEquationOkay",
+ *			       "(= F (* m a))", answer, sizeof(answer), &length);
+ *	...
+ *	solver_close(s);
+ *
+ *  Each context holds a problem of its own, as a session of
+ *  solver-program does. A context may be used by any thread, but by
+ *  one thread at a time; different contexts may be used at once.
+ *  The solver writes nothing to stdout: what it would print while
+ *  debugging goes nowhere, or to the file given to solver_debug_output.
+ *  What the rest of the program writes to std::cout is left alone.
+ */
+
+#ifndef SOLVERAPI_INCLUDED
+#define SOLVERAPI_INCLUDED
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct solver_context solver_context;
+
+/* what solver_call returns */
+#define SOLVER_OK		0	/* out holds the result */
+#define SOLVER_FAILED		1	/* out holds what went wrong */
+#define SOLVER_TOO_SMALL	2	/* *length is the room needed */
+#define SOLVER_UNKNOWN_COMMAND	3
+#define SOLVER_BAD_ARGUMENT	4	/* no context, or arg is missing */
+
+/* a new context with an empty problem, or 0 if there is no memory */
+solver_context * solver_open(void);
+
+/* frees the context and its problem */
+void solver_close(solver_context * context);
+
+/* solver_call(context, command, arg, out, size, length)
+ *	does command, one of the routines of Solver.h (without the
+ *	session routines, which contexts replace), with arg, its
+ *	argument if it takes one, for the problem of context. The result,
+ *	or the description of the error for SOLVER_FAILED, is copied to
+ *	out with a terminating 0, and *length set to its size counting
+ *	the 0. If that is more than size, as much as fits is copied and
+ *	SOLVER_TOO_SMALL returned. The command has been done all the
+ *	same, so don't call it again: the whole result is kept by the
+ *	context, for solver_fetch_result.
+ */
+int solver_call(solver_context * context, const char * command,
+		const char * arg, char * out, size_t size, size_t * length);
+
+/* solver_fetch_result(context, out, size, length)
+ *	copies the result kept when solver_call last returned
+ *	SOLVER_TOO_SMALL, as solver_call would have, and returns the code
+ *	solver_call would have returned with room enough. It is kept
+ *	until it fits (SOLVER_TOO_SMALL again if it still doesn't) or
+ *	the next solver_call. SOLVER_BAD_ARGUMENT if nothing is kept.
+ */
+int solver_fetch_result(solver_context * context, char * out, size_t size,
+			size_t * length);
+
+/* the name of a code returned by solver_call, such as "SOLVER_OK" */
+const char * solver_code_name(int code);
+
+/* sends what the solver prints while debugging to file, or nowhere if
+ * file is 0 (as it is to begin with). Returns SOLVER_OK, or
+ * SOLVER_BAD_ARGUMENT if file can't be opened.
+ */
+int solver_debug_output(const char * file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+// solvercontext.cpp	construction, destruction and selection of contexts,
+//    and the problems they share
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+#define SOLVERCONTEXT_MEMBERS
+#include "decl.h"
+#include "extstruct.h"
+#include "indyset.h"
+#include "indysgg.h"
+#include "nodearena.h"
+#include "valander.h"
+
+using namespace std;
+
+void doinitinit();				// in coldriver.cpp
+
+// each thread has its own current context, so threads working on
+// different contexts don't disturb each other
+static thread_local SolverContext * current = 0L;
+
+/************************************************************************
+ * A new context is empty, as the globals were when the process	*
+ *   started: nothing is allocated until doinitinit (or indyEmpty) is	*
+ *   called with the context current.					*
+ ************************************************************************/
+SolverContext::SolverContext() :
+  canonvars(0L), canoneqf(0L), paramasgn(0L), solsexpr(0L), numsols(0L),
+  numpasses(0), setupdone(false), gotthevars(false), numindyvars(0),
+  canongrads(0L), studgrads(HELPEQSZ,0L), numindysets(0), listofsets(0L),
+  listsetrefs(0L), lasttriedeq(0L), theargs(0L), numparams(0), randseed(1),
+  isFirst(true), result(4096, '\0'), nodes(new nodeArena)
+{
+  studeqf.assign(HELPEQSZ, (binopexp*)NULL);
+  studeqsorig.assign(HELPEQSZ, (string*)NULL);
+}
+
+/************************************************************************
+ * The destructor frees the problem. indyRelease works on the current	*
+ *   context, so this one is made current while it runs.		*
+ ************************************************************************/
+SolverContext::~SolverContext()
+{
+  SolverContext * previous = useSolverContext(this);
+  try { indyRelease(); } catch (...) { }
+  delete theargs;
+  useSolverContext(previous == this ? 0L : previous);
+  // whatever nodes are left go with it
+  delete nodes;
+}
+
+SolverContext * defaultSolverContext()
+{
+  static SolverContext * dflt = new SolverContext;
+  return(dflt);
+}
+
+SolverContext * solverContext()
+{
+  if (current == 0L) current = defaultSolverContext();
+  return(current);
+}
+
+SolverContext * useSolverContext(SolverContext * ctx)
+{
+  SolverContext * previous = solverContext();
+  current = (ctx == 0L) ? defaultSolverContext() : ctx;
+  return(previous);
+}
+
+/************************************************************************
+ * shareProblem(from)  replaces the problem of the current context by	*
+ *	that of from, whose variables, canonical equations and		*
+ *	gradients it uses in place until it changes them. Everything	*
+ *	else (the solution values, the parameter assignments, the	*
+ *	independence sets and the counters) is copied, as the session	*
+ *	changes it as it goes.						*
+ ************************************************************************/
+void shareProblem(const shared_ptr<SolverContext> & from)
+{
+  SolverContext * ctx = solverContext();
+  if (ctx->isFirst) doinitinit();
+  else indyEmpty();
+  ctx->gotthevars = from->gotthevars;
+  ctx->numindyvars = from->numindyvars;
+  ctx->numindysets = from->numindysets;
+  ctx->numparams = from->numparams;
+  ctx->numpasses = from->numpasses;
+  ctx->randseed = from->randseed;
+  ctx->statements = from->statements;
+  *ctx->numsols = *from->numsols;
+  {
+    problemNodes keep;		// they stay with the problem
+    for (size_t k = 0; k < from->paramasgn->size(); k++)
+      ctx->paramasgn->push_back((binopexp *) copyexpr((*from->paramasgn)[k]));
+  }
+  *ctx->listofsets = *from->listofsets;
+  *ctx->listsetrefs = *from->listsetrefs;
+  *ctx->lasttriedeq = *from->lasttriedeq;
+  delete ctx->canonvars;
+  delete ctx->canoneqf;
+  delete ctx->canongrads;
+  ctx->canonvars = from->canonvars;
+  ctx->canoneqf = from->canoneqf;
+  ctx->canongrads = from->canongrads;
+  ctx->canonOwner = from;
+}
+
+/************************************************************************
+ * ownCanon()  gives the current context its own copy of the variables,	*
+ *	canonical equations and gradients it shares, if it does. It is	*
+ *	called by whatever changes them.				*
+ ************************************************************************/
+void ownCanon()
+{
+  SolverContext * ctx = solverContext();
+  if (!ctx->canonOwner) return;
+  problemNodes keep;		// the copies stay with the problem
+  vector<physvar *> * vars = new vector<physvar *>;
+  vector<binopexp *> * eqs = new vector<binopexp *>;
+  vector<valander *> * grads = new vector<valander *>;
+  size_t k;
+  vars->reserve(ctx->canonvars->size());
+  for (k = 0; k < ctx->canonvars->size(); k++)
+    vars->push_back(new physvar(*(*ctx->canonvars)[k]));
+  eqs->reserve(ctx->canoneqf->size());
+  for (k = 0; k < ctx->canoneqf->size(); k++)
+    eqs->push_back((binopexp *) copyexpr((*ctx->canoneqf)[k]));
+  grads->reserve(ctx->canongrads->size());
+  for (k = 0; k < ctx->canongrads->size(); k++)
+    grads->push_back(new valander(*(*ctx->canongrads)[k]));
+  ctx->canonvars = vars;
+  ctx->canoneqf = eqs;
+  ctx->canongrads = grads;
+  ctx->canonOwner.reset();
+}
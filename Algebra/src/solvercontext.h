@@ -0,0 +1,144 @@
+// solvercontext.h	class SolverContext: everything the solver knows about
+//    one problem
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+/************************************************************************
+ * A SolverContext owns the state of one problem: the variables,	*
+ *	canonical and student equations, their gradients, the sets of	*
+ *	equations used for independence checking, the solution, and 	*
+ *	the buffers used to return results to the caller.		*
+ *   The solving, parsing, independence and checking routines act on	*
+ *	the current context, given by solverContext(). The names below	*
+ *	that used to be globals (canonvars, canoneqf, ...) are defined	*
+ *	as the corresponding member of the current context, so those	*
+ *	routines read as before.					*
+ *   The unit table and the table of constants are not per problem	*
+ *	and are shared by all contexts.					*
+ ************************************************************************/
+#ifndef SOLVERCONTEXT_INCLUDED
+#define SOLVERCONTEXT_INCLUDED
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <memory>
+
+class physvar;
+class expr;
+class binopexp;
+class valander;
+class indyset;
+class nodeArena;
+
+class SolverContext
+{
+public:
+  SolverContext();
+  ~SolverContext();
+
+  // problem state, formerly in extstruct.h
+  // in the vectors below, indices of *:* match, and indices of &^& match
+  std::vector<physvar*>* canonvars;	// the canonical variables	&^&
+  std::vector<std::string*> studvars;	// student defined variables	*:*
+  std::vector<expr*> studvarvals;	// studvar in canonical vars	*:*
+  std::vector<physvar*> studvarcanon;	// canonical var for studvar	*:*
+  std::vector<binopexp*>* canoneqf;	// the canonical equations
+  std::vector<binopexp*>* paramasgn;	// parameter artificial assignments
+  std::vector<binopexp*> studeqf;	// student eqs by slot, as f = 0
+  std::vector<std::string*> studeqsorig; // student eqs by slot, as given
+  std::vector<binopexp*>* solsexpr;	// solution eqs of canonvars	&^&
+  std::vector<double>* numsols;	 	// solution values of canonvars	&^&
+  int numpasses;
+
+  // independence state, formerly in indysgg.cpp
+  bool setupdone;		// set when indyEmpty has made the structures
+  bool gotthevars;		// set by indyDoneAddVar, reset by indyEmpty
+  int numindyvars;		// number of canonvars at indyDoneAddVar
+  std::vector<valander *> *canongrads;
+  std::vector<valander *> studgrads;
+  int numindysets;
+  std::vector<indyset> *listofsets;
+  std::vector<std::vector<int> > * listsetrefs;
+  std::vector<int> *lasttriedeq;
+  // set while canonvars, canoneqf and canongrads are those of a library
+  // problem, kept by the context it points to and shared read only by
+  // every session of the problem, see ownCanon
+  std::shared_ptr<SolverContext> canonOwner;
+  std::vector<expr *> * theargs;	// used by backdoor.cpp
+  int numparams;		// parameters seen, formerly in getallfile.cpp
+  unsigned int randseed;	// for dummy parameter values, in solvetool.cpp
+  std::string statements;	// what made the problem, see solutioncache.cpp
+
+  // solution text, formerly in coldriver.cpp
+  bool isFirst;			// doinitinit not yet called
+  std::stringstream resultBuffer;
+  std::string lzbfr;		// the line (or all of it) last returned
+
+  // the string returned by the routines of Solver.h. It grows to fit
+  // and keeps its size, so a context soon stops allocating.
+  std::vector<char> result;
+  std::string batchResult;	// returned by solverBatch
+  std::string name;		// of its session, "" for the default
+  nodeArena * nodes;		// where its expressions are kept
+
+private:
+  SolverContext(const SolverContext &);		// not copyable
+  SolverContext & operator=(const SolverContext &);
+};
+
+SolverContext * solverContext();		// the current context
+SolverContext * defaultSolverContext();		// used unless changed
+// make ctx current (0 for the default), returning the previous one
+SolverContext * useSolverContext(SolverContext * ctx);
+// make the problem of from that of the current context, sharing its
+// variables, canonical equations and gradients
+void shareProblem(const std::shared_ptr<SolverContext> & from);
+// give the current context its own copy of what it shares, before it
+// changes any of it
+void ownCanon();
+
+// solvercontext.cpp, and the files which look the context up once per
+// call (Solver.cpp and the solve and independence loops), refer to the
+// members themselves
+#ifndef SOLVERCONTEXT_MEMBERS
+#define canonvars	(solverContext()->canonvars)
+#define studvars	(solverContext()->studvars)
+#define studvarvals	(solverContext()->studvarvals)
+#define studvarcanon	(solverContext()->studvarcanon)
+#define canoneqf	(solverContext()->canoneqf)
+#define paramasgn	(solverContext()->paramasgn)
+#define studeqf		(solverContext()->studeqf)
+#define studeqsorig	(solverContext()->studeqsorig)
+#define solsexpr	(solverContext()->solsexpr)
+#define numsols		(solverContext()->numsols)
+#define numpasses	(solverContext()->numpasses)
+#define setupdone	(solverContext()->setupdone)
+#define gotthevars	(solverContext()->gotthevars)
+#define numindyvars	(solverContext()->numindyvars)
+#define canongrads	(solverContext()->canongrads)
+#define studgrads	(solverContext()->studgrads)
+#define numindysets	(solverContext()->numindysets)
+#define listofsets	(solverContext()->listofsets)
+#define listsetrefs	(solverContext()->listsetrefs)
+#define lasttriedeq	(solverContext()->lasttriedeq)
+#define theargs		(solverContext()->theargs)
+#define numparams	(solverContext()->numparams)
+#define randseed	(solverContext()->randseed)
+#endif
+
+#endif
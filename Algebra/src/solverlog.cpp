@@ -0,0 +1,342 @@
+// solverlog.cpp
+//    The log of the calls made to the solver, written in the background
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  Each call to a routine of Solver.h is logged as the C++ statement
+//  making it, and its result as a comment, preceded by a comment with
+//  the time of the call and how long it took:
+//	solveAdd("(SVAR m kg)");
+//	//@ 2009-06-01 14:03:27.123456 153us
+//	// t;
+//  so a log can be replayed by including it in a program (see
+//  Algebra/test/main.cpp) or by reading it.
+//  The entries are copied into a ring buffer, and a thread writes them
+//  out when the buffer is a quarter full or every flushMillis, so a
+//  call doesn't wait for the disk. Log files stay open between writes.
+//  With setLogSessions, each session has its own file, named by
+//  putting the session name before the extension (Solver-s1.log), so
+//  that the log of a session can be replayed alone even when several
+//  threads run sessions at once. A call and its result always go to
+//  the same file. With setLogRotate, a file about to grow past the
+//  given size is renamed to file.1 (and file.1 to file.2, ..., keeping
+//  rotateKeep old files) and started afresh.
+
+#include "decl.h"
+#include "extstruct.h"
+#include "solverlog.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+
+using namespace std;
+
+static const size_t ringSize = 1 << 20;
+static const size_t flushAt = ringSize / 4;
+static const int flushMillis = 200;
+static const int rotateKeep = 5;
+
+struct logRecord {			// in front of each entry in the ring
+  unsigned int file;
+  unsigned int length;
+};
+
+struct logFile {
+  string name;
+  ofstream out;
+  unsigned long size;
+};
+
+// guarded by ringLock
+static vector<char> ring;
+static size_t head = 0;			// first byte not yet taken
+static size_t used = 0;
+static bool writing = false;		// the flusher has taken bytes out
+static bool flushWanted = false;
+static bool stopping = false;
+static thread * flusher = 0L;
+static string logName = "Solver.log";
+static bool separateSessions = false;
+static map<string, unsigned int> fileIds;
+static vector<string> fileNames;	// by id
+static mutex ringLock;
+static condition_variable ringRoom;	// bytes were taken out
+static condition_variable ringWork;	// there is something to write
+static condition_variable ringDone;	// what was taken out is written
+
+// guarded by fileLock, and used only to write
+static vector<logFile *> files;		// by id
+static unsigned long rotateBytes = 0;
+static mutex fileLock;
+
+// the file and start of the call being logged by this thread
+static thread_local unsigned int callFile = 0;
+static thread_local chrono::steady_clock::time_point callStart;
+
+/************************************************************************
+ * writing the files, done by the flusher or with the ring empty	*
+ ************************************************************************/
+static void rotate(logFile * f)
+{
+  f->out.close();
+  for (int k = rotateKeep - 1; k > 0; k--)
+    rename((f->name + "." + itostr(k)).c_str(),
+	   (f->name + "." + itostr(k+1)).c_str());
+  rename(f->name.c_str(), (f->name + ".1").c_str());
+  f->out.open(f->name.c_str(), ios::out | ios::trunc);
+  f->size = 0;
+}
+
+static void writeEntry(unsigned int id, const string & name,
+		       const char * text, size_t length)
+{
+  while (files.size() <= id) files.push_back(0L);
+  logFile * & f = files[id];
+  if (f == 0L) {
+    f = new logFile;
+    f->name = name;
+    f->out.open(name.c_str(), ios::out | ios::app);
+    f->size = f->out.tellp();
+  }
+  if (rotateBytes > 0 && f->size > 0 && f->size + length > rotateBytes)
+    rotate(f);
+  f->out.write(text, length);
+  f->size += length;
+}
+
+static void flushFiles()
+{
+  for (size_t k = 0; k < files.size(); k++)
+    if (files[k]) files[k]->out.flush();
+}
+
+/************************************************************************
+ * flushRing  the thread writing out the ring			*
+ ************************************************************************/
+static void flushRing()
+{
+  vector<char> batch;
+  unique_lock<mutex> guard(ringLock);
+  for (;;) {
+    ringWork.wait_for(guard, chrono::milliseconds(flushMillis), [] {
+	return(used >= flushAt || flushWanted || stopping); });
+    if (used == 0) {
+      flushWanted = false;
+      ringDone.notify_all();
+      if (stopping) return;
+      continue;
+    }
+    // take out all of it at once
+    batch.resize(used);
+    size_t first = min(used, ringSize - head);
+    memcpy(&batch[0], &ring[head], first);
+    memcpy(&batch[first], &ring[0], used - first);
+    head = (head + used) % ringSize;
+    used = 0;
+    writing = true;
+    vector<string> names = fileNames;
+    ringRoom.notify_all();
+    guard.unlock();
+    {
+      lock_guard<mutex> files(fileLock);
+      for (size_t at = 0; at < batch.size(); ) {
+	logRecord r;
+	memcpy(&r, &batch[at], sizeof(r));
+	at += sizeof(r);
+	writeEntry(r.file, names[r.file], &batch[at], r.length);
+	at += r.length;
+      }
+      flushFiles();
+    }
+    guard.lock();
+    writing = false;
+    ringDone.notify_all();
+  }
+}
+
+// a forked child has no flusher, and must not write again what its
+// parent has yet to write
+static void beforeFork() { ringLock.lock(); fileLock.lock(); flushFiles(); }
+static void afterFork() { fileLock.unlock(); ringLock.unlock(); }
+static void inChild()
+{
+  flusher = 0L;
+  used = 0;
+  writing = false;
+  afterFork();
+}
+
+static struct logStopper {
+  ~logStopper() {
+    {
+      lock_guard<mutex> guard(ringLock);
+      if (flusher == 0L) return;
+      stopping = true;
+      ringWork.notify_all();
+    }
+    flusher->join();
+  }
+} stopper;
+
+// guard holds ringLock
+static void startFlusher()
+{
+  static bool registered = false;
+  if (!registered) {
+    pthread_atfork(beforeFork, afterFork, inChild);
+    registered = true;
+  }
+  ring.resize(ringSize);
+  flusher = new thread(flushRing);
+}
+
+// waits until all of the ring is written; guard holds ringLock
+static void drain(unique_lock<mutex> & guard)
+{
+  if (flusher == 0L) return;
+  flushWanted = true;
+  ringWork.notify_all();
+  while (used > 0 || writing) ringDone.wait(guard);
+}
+
+// the log file of the current session
+static unsigned int currentFile()
+{
+  string name = logName;
+  const string & session = solverContext()->name;
+  if (separateSessions && !session.empty()) {
+    string::size_type dot = name.find_last_of('.');
+    string::size_type slash = name.find_last_of('/');
+    if (dot == string::npos || (slash != string::npos && dot < slash))
+      dot = name.size();
+    name.insert(dot, "-" + session);
+  }
+  map<string, unsigned int>::iterator it = fileIds.find(name);
+  if (it != fileIds.end()) return(it->second);
+  fileIds[name] = fileNames.size();
+  fileNames.push_back(name);
+  return(fileNames.size() - 1);
+}
+
+/************************************************************************
+ * append(id, text)  puts an entry for file id in the ring, waiting for	*
+ *	room if need be. One larger than the ring is written at once.	*
+ ************************************************************************/
+static void append(unsigned int id, const string & text)
+{
+  logRecord r = { id, (unsigned int) text.size() };
+  size_t length = sizeof(r) + text.size();
+  unique_lock<mutex> guard(ringLock);
+  if (flusher == 0L) startFlusher();
+  if (length > ringSize) {
+    drain(guard);
+    lock_guard<mutex> files(fileLock);
+    writeEntry(id, fileNames[id], text.data(), text.size());
+    flushFiles();
+    return;
+  }
+  while (ringSize - used < length) ringRoom.wait(guard);
+  const char * parts[2] = { (const char *) &r, text.data() };
+  size_t sizes[2] = { sizeof(r), text.size() };
+  for (int p = 0; p < 2; p++) {
+    size_t tail = (head + used) % ringSize;
+    size_t first = min(sizes[p], ringSize - tail);
+    memcpy(&ring[tail], parts[p], first);
+    memcpy(&ring[0], parts[p] + first, sizes[p] - first);
+    used += sizes[p];
+  }
+  if (used >= flushAt) ringWork.notify_one();
+}
+
+void logCall(const string & call)
+{
+  unsigned int id;
+  {
+    lock_guard<mutex> guard(ringLock);
+    id = currentFile();
+  }
+  callFile = id;
+  append(id, call + ";\n");
+  callStart = chrono::steady_clock::now();
+}
+
+void logResult(const string & result)
+{
+  long usec = chrono::duration_cast<chrono::microseconds>
+    (chrono::steady_clock::now() - callStart).count();
+  chrono::system_clock::time_point now = chrono::system_clock::now();
+  time_t seconds = chrono::system_clock::to_time_t(now);
+  long micro = chrono::duration_cast<chrono::microseconds>
+    (now.time_since_epoch()).count() % 1000000;
+  tm local;
+  localtime_r(&seconds, &local);
+  char stamp[80];
+  size_t n = strftime(stamp, sizeof(stamp), "//@ %Y-%m-%d %H:%M:%S", &local);
+  snprintf(stamp + n, sizeof(stamp) - n, ".%06ld %ldus\n", micro, usec);
+  append(callFile, stamp + ("// " + result) + ";\n");
+}
+
+void logFlush()
+{
+  unique_lock<mutex> guard(ringLock);
+  drain(guard);
+}
+
+void setLogFile(const string & file)
+{
+  lock_guard<mutex> guard(ringLock);
+  logName = file;
+}
+
+void setLogSessions(bool separate)
+{
+  lock_guard<mutex> guard(ringLock);
+  separateSessions = separate;
+}
+
+void setLogRotate(unsigned long bytes)
+{
+  lock_guard<mutex> files(fileLock);
+  rotateBytes = bytes;
+}
+
+/************************************************************************
+ * logRestart  empties the log file of the current session, which then	*
+ *	starts with "Begin"						*
+ ************************************************************************/
+void logRestart()
+{
+  unique_lock<mutex> guard(ringLock);
+  drain(guard);
+  unsigned int id = currentFile();
+  lock_guard<mutex> lock(fileLock);
+  if (id < files.size() && files[id]) {
+    delete files[id];
+    files[id] = 0L;
+  }
+  { ofstream empty(fileNames[id].c_str(), ios::out | ios::trunc); }
+  writeEntry(id, fileNames[id], "Begin\n", 6);
+  flushFiles();
+}
@@ -0,0 +1,33 @@
+// solverlog.h	the log of the calls made to the solver, see solverlog.cpp
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOLVERLOG_INCLUDED
+#define SOLVERLOG_INCLUDED
+
+#include <string>
+
+void logCall(const std::string & call);		// writes "call;"
+void logResult(const std::string & result);	// its time, then "// result;"
+void logFlush();				// waits until all is written
+
+void setLogFile(const std::string & file);	// Solver.log unless set
+void logRestart();		// empties the log file, starting with "Begin"
+void setLogSessions(bool separate);	// a file for each session or not
+void setLogRotate(unsigned long bytes);	// 0 never rotates
+
+#endif
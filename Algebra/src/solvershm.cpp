@@ -0,0 +1,334 @@
+// solvershm.cpp
+//    Requests and results through shared memory, see solvershm.h
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+//  The segment holds two rings of ringBytes each, one for requests and
+//  one for results. Each ring has one writer and one reader, so it needs
+//  no lock: the writer alone moves tail, the reader alone moves head,
+//  and the bytes between them are the ones not yet read. Each side
+//  runs on as much of the stream as there is, like a pipe.
+//  A side with nothing to do spins for a while, since the answer to a
+//  small call usually comes within microseconds, and then sleeps on a
+//  futex: a word of the ring that the other side bumps, waking it only
+//  if it says it is waiting, when it has flushed (for data) or read
+//  (for room). Sleeps time out every waitMillis to see whether the
+//  other side has died, so a crashed solver is noticed.
+
+#include "solvershm.h"
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace std;
+
+static const char shmMagic[8] = { 'A','n','d','e','s','S','h','m' };
+static const uint32_t shmVersion = 1;
+static const int spinLimit = 20000;	// tries before sleeping
+static const int waitMillis = 100;
+
+struct shmRing {
+  alignas(64) atomic<uint64_t> head;	// bytes read, moved by the reader
+  atomic<uint32_t> room;		// bumped when bytes are read
+  atomic<uint32_t> roomWaiters;		// the writer is waiting for room
+  alignas(64) atomic<uint64_t> tail;	// bytes written, by the writer
+  atomic<uint32_t> data;		// bumped when the writer flushes
+  atomic<uint32_t> dataWaiters;		// the reader is waiting for data
+  atomic<uint32_t> closed;		// the writer is done
+};
+
+// followed by the bytes of rings[0] and then of rings[1]
+struct shmSegment {
+  char magic[8];
+  uint32_t version;
+  uint32_t ringBytes;			// a power of two
+  atomic<int32_t> pid[2];		// of the client and of the solver
+  shmRing rings[2];			// requests and results
+};
+
+static_assert(sizeof(atomic<uint64_t>) == 8 && sizeof(atomic<uint32_t>) == 4,
+	      "shared ring words must be plain words");
+
+static char * ringData(shmSegment * s, int k)
+{
+  return((char *) s + sizeof(shmSegment) + k * (size_t) s->ringBytes);
+}
+
+/************************************************************************
+ * futexWait(word, value)  sleeps while word is value, for at most	*
+ *	waitMillis; futexWake(word) wakes those sleeping on it. They	*
+ *	work across processes, the words being in shared memory.	*
+ ************************************************************************/
+#ifdef __linux__
+static void futexWait(atomic<uint32_t> & word, uint32_t value)
+{
+  struct timespec wait = { 0, waitMillis * 1000000L };
+  syscall(SYS_futex, (uint32_t *) &word, FUTEX_WAIT, value, &wait, 0L, 0);
+}
+static void futexWake(atomic<uint32_t> & word)
+{
+  syscall(SYS_futex, (uint32_t *) &word, FUTEX_WAKE, INT_MAX, 0L, 0L, 0);
+}
+#else	// no futex: poll
+static void futexWait(atomic<uint32_t> & word, uint32_t value)
+{
+  struct timespec wait = { 0, 50000L };
+  if (word.load() == value) nanosleep(&wait, 0L);
+}
+static void futexWake(atomic<uint32_t> &) {}
+#endif
+
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
+/************************************************************************
+ * create, attach  make and join the segment				*
+ ************************************************************************/
+shmChannel::shmChannel(const string & name, shmSegment * segment,
+		       size_t mapped, bool server)
+  : name(name), segment(segment), mapped(mapped), server(server), child(0),
+    dead(false)
+{}
+
+shmChannel * shmChannel::create(const string & name, size_t ringBytes)
+{
+  size_t bytes = 4096;
+  while (bytes < ringBytes) bytes *= 2;
+  size_t mapped = sizeof(shmSegment) + 2 * bytes;
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) throw(string("can't make shared memory ") + name);
+  if (ftruncate(fd, mapped) != 0) {
+    close(fd);
+    shm_unlink(name.c_str());
+    throw(string("can't size shared memory ") + name);
+  }
+  void * memory = mmap(0L, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw(string("can't map shared memory ") + name);
+  }
+  shmSegment * s = new(memory) shmSegment;
+  for (int k = 0; k < 2; k++) {
+    s->rings[k].head = 0;
+    s->rings[k].room = 0;
+    s->rings[k].roomWaiters = 0;
+    s->rings[k].tail = 0;
+    s->rings[k].data = 0;
+    s->rings[k].dataWaiters = 0;
+    s->rings[k].closed = 0;
+  }
+  s->version = shmVersion;
+  s->ringBytes = bytes;
+  s->pid[0] = getpid();
+  s->pid[1] = 0;
+  // the magic goes last, once the rest can be believed
+  atomic_thread_fence(memory_order_release);
+  memcpy(s->magic, shmMagic, sizeof(shmMagic));
+  return(new shmChannel(name, s, mapped, false));
+}
+
+shmChannel * shmChannel::attach(const string & name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) throw(string("can't open shared memory ") + name);
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(shmSegment)) {
+    close(fd);
+    throw(string("shared memory ") + name + " is not a solver channel");
+  }
+  size_t mapped = info.st_size;
+  void * memory = mmap(0L, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) throw(string("can't map shared memory ") + name);
+  // the name isn't needed once both sides have the segment mapped
+  shm_unlink(name.c_str());
+  shmSegment * s = (shmSegment *) memory;
+  atomic_thread_fence(memory_order_acquire);
+  if (memcmp(s->magic, shmMagic, sizeof(shmMagic)) != 0 ||
+      s->version != shmVersion ||
+      mapped != sizeof(shmSegment) + 2 * (size_t) s->ringBytes) {
+    munmap(memory, mapped);
+    throw(string("shared memory ") + name + " is not a solver channel");
+  }
+  s->pid[1] = getpid();
+  return(new shmChannel(name, s, mapped, true));
+}
+
+shmChannel::~shmChannel()
+{
+  segment->rings[server ? 1 : 0].closed.store(1);
+  flush();
+  munmap(segment, mapped);
+  // in case the solver never attached
+  if (!server) shm_unlink(name.c_str());
+}
+
+void shmChannel::watchChild(pid_t pid)
+{
+  child = pid;
+}
+
+bool shmChannel::peerGone()
+{
+  if (dead) return(true);
+  if (child > 0) {
+    int status;
+    if (waitpid(child, &status, WNOHANG) == child) dead = true;
+  } else {
+    pid_t peer = segment->pid[server ? 0 : 1];
+    if (peer > 0 && kill(peer, 0) < 0 && errno == ESRCH) dead = true;
+  }
+  return(dead);
+}
+
+/************************************************************************
+ * waitFor(data)  waits until the ring read by this side has data, or	*
+ *	the ring written has room; false if the other side is gone.	*
+ ************************************************************************/
+bool shmChannel::waitFor(bool data)
+{
+  shmRing & r = segment->rings[(data == server) ? 0 : 1];
+  shmRing & other = segment->rings[(data == server) ? 1 : 0];
+  uint64_t size = segment->ringBytes;
+  atomic<uint32_t> & word = data ? r.data : r.room;
+  atomic<uint32_t> & waiters = data ? r.dataWaiters : r.roomWaiters;
+  // With one core, the other side can't run while this one spins.
+  static const int spins = thread::hardware_concurrency() > 1 ? spinLimit : 0;
+  for (int k = 0; ; k++) {
+    bool ready = data ? (r.tail.load() != r.head.load() || r.closed.load()) :
+      (r.tail.load() - r.head.load() < size || other.closed.load());
+    if (ready) return(true);
+    if (k < spins) { cpuRelax(); continue; }
+    if (k > spins && peerGone()) return(false);
+    // the writer looks for waiters after moving tail, so either it
+    // sees this one or this one sees what it wrote
+    waiters.fetch_add(1);
+    uint32_t seen = word.load();
+    ready = data ? (r.tail.load() != r.head.load() || r.closed.load()) :
+      (r.tail.load() - r.head.load() < size || other.closed.load());
+    if (!ready) futexWait(word, seen);
+    waiters.fetch_sub(1);
+  }
+}
+
+/************************************************************************
+ * write, read, flush  see solvershm.h					*
+ ************************************************************************/
+size_t shmChannel::write(const char * data, size_t n)
+{
+  shmRing & r = segment->rings[server ? 1 : 0];
+  char * bytes = ringData(segment, server ? 1 : 0);
+  uint64_t size = segment->ringBytes;
+  for (;;) {
+    if (segment->rings[server ? 0 : 1].closed.load()) return(0);
+    uint64_t tail = r.tail.load(memory_order_relaxed);
+    uint64_t room = size - (tail - r.head.load(memory_order_acquire));
+    if (room > 0) {
+      size_t k = n < room ? n : room;
+      size_t at = tail & (size - 1);
+      size_t first = k < size - at ? k : size - at;
+      memcpy(bytes + at, data, first);
+      memcpy(bytes, data + first, k - first);
+      r.tail.store(tail + k, memory_order_release);
+      return(k);
+    }
+    flush();			// the reader must see what's there to make room
+    if (!waitFor(false)) return(0);
+  }
+}
+
+size_t shmChannel::read(char * data, size_t n)
+{
+  shmRing & r = segment->rings[server ? 0 : 1];
+  char * bytes = ringData(segment, server ? 0 : 1);
+  uint64_t size = segment->ringBytes;
+  for (;;) {
+    // closed is looked at first, since all was written before it was set
+    bool closed = r.closed.load(memory_order_acquire);
+    uint64_t head = r.head.load(memory_order_relaxed);
+    uint64_t available = r.tail.load(memory_order_acquire) - head;
+    if (available > 0) {
+      size_t k = n < available ? n : available;
+      size_t at = head & (size - 1);
+      size_t first = k < size - at ? k : size - at;
+      memcpy(data, bytes + at, first);
+      memcpy(data + first, bytes, k - first);
+      r.head.store(head + k, memory_order_release);
+      r.room.fetch_add(1);
+      if (r.roomWaiters.load()) futexWake(r.room);
+      return(k);
+    }
+    if (closed || !waitFor(true)) return(0);
+  }
+}
+
+void shmChannel::flush()
+{
+  shmRing & r = segment->rings[server ? 1 : 0];
+  r.data.fetch_add(1);
+  if (r.dataWaiters.load()) futexWake(r.data);
+}
+
+/************************************************************************
+ * shmbuf  a streambuf reading and writing a shmChannel			*
+ ************************************************************************/
+int shmbuf::underflow()
+{
+  size_t n = channel->read(in, sizeof(in));
+  if (n == 0) return(EOF);
+  setg(in, in, in + n);
+  return((unsigned char) *gptr());
+}
+
+int shmbuf::overflow(int c)
+{
+  for (char * p = pbase(); p < pptr(); ) {
+    size_t n = channel->write(p, pptr() - p);
+    if (n == 0) return(EOF);
+    p += n;
+  }
+  setp(out, out + sizeof(out));
+  if (c != EOF) { *pptr() = c; pbump(1); }
+  return(c == EOF ? 0 : c);
+}
+
+int shmbuf::sync()
+{
+  if (overflow(EOF) == EOF) return(-1);
+  channel->flush();
+  return(0);
+}
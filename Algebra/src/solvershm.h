@@ -0,0 +1,84 @@
+// solvershm.h	talking to solver-program through shared memory, see solvershm.cpp
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SOLVERSHM_INCLUDED
+#define SOLVERSHM_INCLUDED
+
+#include <string>
+#include <streambuf>
+#include <sys/types.h>
+
+struct shmSegment;
+
+// A shared memory segment holding two rings, one carrying requests to
+// solver-program and the other its results, each written by one side
+// and read by the other.
+class shmChannel
+{
+public:
+  // the client makes the segment, named "/something", before starting
+  // solver-program -shm name; throws a string if it can't
+  static shmChannel * create(const std::string & name, size_t ringBytes);
+  // solver-program attaches to it and removes the name; throws a string
+  static shmChannel * attach(const std::string & name);
+  ~shmChannel();			// closes this side's ring
+
+  // the client started the solver as child pid, so it can tell when
+  // the solver is gone even before it has attached
+  void watchChild(pid_t pid);
+
+  // copy up to n bytes to or from the rings, waiting until at least
+  // one can be; write returns 0 and read returns 0 once the other side
+  // has closed or died
+  size_t write(const char * data, size_t n);
+  size_t read(char * data, size_t n);
+  void flush();				// wakes the other side, if waiting
+
+private:
+  shmChannel(const std::string & name, shmSegment * segment, size_t mapped,
+	     bool server);
+  bool waitFor(bool data);
+  bool peerGone();
+  std::string name;
+  shmSegment * segment;
+  size_t mapped;
+  bool server;
+  pid_t child;
+  bool dead;				// the other side is known to be gone
+};
+
+// a streambuf on a shmChannel, so requests and results can be read and
+// written just as on stdin and stdout
+class shmbuf : public std::streambuf
+{
+public:
+  shmbuf(shmChannel * channel) : channel(channel) {
+    setg(in, in, in);
+    setp(out, out + sizeof(out));
+  }
+  ~shmbuf() { sync(); }
+protected:
+  int underflow();
+  int overflow(int c);
+  int sync();
+private:
+  shmChannel * channel;
+  char in[4096], out[4096];
+};
+
+#endif
@@ -0,0 +1,130 @@
+// solverstats.cpp
+//    Counts and times of the calls in Solver.h, see solverstats.h
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "decl.h"
+#include "extstruct.h"
+#include "solverstats.h"
+#include "nodearena.h"
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+// the commands in the order they were first called
+static vector<commandStats *> commands;
+static mutex commandsLock;
+
+static const memory_order relaxed = memory_order_relaxed;
+
+commandStats::commandStats(const char * const name) : name(name)
+{
+  clear();
+  lock_guard<mutex> guard(commandsLock);
+  commands.push_back(this);
+}
+
+void commandStats::clear()
+{
+  count.store(0, relaxed);
+  errors.store(0, relaxed);
+  usec.store(0, relaxed);
+  input.store(0, relaxed);
+  maxinput.store(0, relaxed);
+  vars.store(0, relaxed);
+  maxvars.store(0, relaxed);
+  for (int k = 0; k < buckets; k++) histogram[k].store(0, relaxed);
+}
+
+// raise most to at least x
+static void atLeast(atomic<unsigned long> & most, unsigned long x)
+{
+  unsigned long m = most.load(relaxed);
+  while (x > m && !most.compare_exchange_weak(m, x, relaxed)) ;
+}
+
+/************************************************************************
+ * done(result)  records the call, as having failed if result is a	*
+ *	solverError, and returns result					*
+ ************************************************************************/
+char * commandTimer::done(char * result)
+{
+  unsigned long t = chrono::duration_cast<chrono::microseconds>
+    (chrono::steady_clock::now() - start).count();
+  int bucket = 0;
+  while (bucket < commandStats::buckets - 1 && (t >> bucket) != 0) bucket++;
+  unsigned long nvars = canonvars ? canonvars->size() : 0;
+
+  stats.count.fetch_add(1, relaxed);
+  if (strncmp(result, "(solverError", 12) == 0) 
+    stats.errors.fetch_add(1, relaxed);
+  stats.usec.fetch_add(t, relaxed);
+  stats.input.fetch_add(inputsize, relaxed);
+  atLeast(stats.maxinput, inputsize);
+  stats.vars.fetch_add(nvars, relaxed);
+  atLeast(stats.maxvars, nvars);
+  stats.histogram[bucket].fetch_add(1, relaxed);
+  return(result);
+}
+
+/************************************************************************
+ * report  gives the counters as a property list, with the histogram	*
+ *	cut after its last non-zero bucket:				*
+ *	  (solveAdd :count 12 :errors 0 :usec 1234 :input 345 		*
+ *	   :max-input 80 :vars 30 :max-vars 5 :histogram (0 0 3 9))	*
+ ************************************************************************/
+string commandStats::report() const
+{
+  ostringstream out;
+  int last = buckets;
+  while (last > 0 && histogram[last-1].load(relaxed) == 0) last--;
+  out << "(" << name << " :count " << count.load(relaxed)
+      << " :errors " << errors.load(relaxed)
+      << " :usec " << usec.load(relaxed)
+      << " :input " << input.load(relaxed)
+      << " :max-input " << maxinput.load(relaxed)
+      << " :vars " << vars.load(relaxed)
+      << " :max-vars " << maxvars.load(relaxed) << " :histogram (";
+  for (int k = 0; k < last; k++) 
+    out << (k ? " " : "") << histogram[k].load(relaxed);
+  out << "))";
+  return(out.str());
+}
+
+// the commands called since the last reset
+string statsReport()
+{
+  lock_guard<mutex> guard(commandsLock);
+  string answer = "(";
+  for (size_t k = 0; k < commands.size(); k++)
+    if (commands[k]->count.load(relaxed) > 0) {
+      if (answer.size() > 1) answer += " ";
+      answer += commands[k]->report();
+    }
+  if (answer.size() > 1) answer += " ";
+  return(answer + nodeStatsReport() + ")");
+}
+
+void statsReset()
+{
+  lock_guard<mutex> guard(commandsLock);
+  for (size_t k = 0; k < commands.size(); k++) commands[k]->clear();
+  nodeStatsReset();
+}
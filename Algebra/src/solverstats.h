@@ -0,0 +1,80 @@
+// solverstats.h	counts and times of the calls in Solver.h
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+
+/************************************************************************
+ * Each routine of Solver.h has a commandStats, made the first time it	*
+ *	is called, holding the number of calls, how many gave errors,	*
+ *	the sizes of their input and a histogram of how long they took.	*
+ *	A commandTimer made at the start of the call records it when 	*
+ *	the call is done:						*
+ *	  COMMAND_STATS("solveAdd", strlen(lispExpression));		*
+ *	  ...								*
+ *	  return timer.done(result);					*
+ *   The counters are shared by all sessions and threads, and are	*
+ *	atomic, so recording a call takes no lock.			*
+ ************************************************************************/
+#ifndef SOLVERSTATS_INCLUDED
+#define SOLVERSTATS_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+class commandStats
+{
+public:
+  // bucket k of the histogram counts calls taking less than 2^k 
+  // microseconds, and at least 2^(k-1)
+  static const int buckets = 32;
+
+  const char * const name;
+  std::atomic<unsigned long> count;
+  std::atomic<unsigned long> errors;	// calls giving (solverError ...)
+  std::atomic<unsigned long> usec;	// total time
+  std::atomic<unsigned long> input;	// total length of the arguments
+  std::atomic<unsigned long> maxinput;
+  std::atomic<unsigned long> vars;	// total of canonvars at each call
+  std::atomic<unsigned long> maxvars;
+  std::atomic<unsigned long> histogram[buckets];
+
+  commandStats(const char * const name);	// also lists it
+  void clear();
+  std::string report() const;
+};
+
+class commandTimer
+{
+public:
+  commandTimer(commandStats & stats, size_t inputsize) : 
+    stats(stats), inputsize(inputsize), 
+    start(std::chrono::steady_clock::now()) { }
+  char * done(char * result);		// records the call, returns result
+private:
+  commandStats & stats;
+  size_t inputsize;
+  std::chrono::steady_clock::time_point start;
+};
+
+#define COMMAND_STATS(name, size) \
+  static commandStats thisCommand(name); \
+  commandTimer timer(thisCommand, size)
+
+std::string statsReport();		// all commands called so far
+void statsReset();			// clears all the counters
+
+#endif
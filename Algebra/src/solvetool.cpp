@@ -48,6 +48,7 @@
 #include "extstruct.h"
 #include <math.h>
 #include "binopfunctions.h"
+#include "nodearena.h"
 using namespace std;
 
 #define DBG(A) DBGF(NEWCKEQSOUT,A)
@@ -71,6 +72,7 @@ string powersolve(const int howstrong, const varindx sought,
 {
   int q;
   string answer;
+  scratchNodes scratch;		// for the trees tried and thrown away
   numpasses = 0;
   DBG( cout << "entering powersolve " << howstrong << ", " 
        << (*canonvars)[sought]->clipsname
@@ -99,7 +101,7 @@ string powersolve(const int howstrong, const varindx sought,
     if( (*canonvars)[(*vars)[q]]->isparam ){
       eqn.push_back((binopexp *) 
 		     new binopexp(&equals, new physvarptr((*vars)[q]),
-				  new numvalexp((double) rand()/RAND_MAX)));
+				  new numvalexp((double) rand_r(&randseed)/RAND_MAX)));
       DBG(cout << "add eqn for parameter " << 
 	  (*canonvars)[(*vars)[q]]->clipsname<< endl);
     }
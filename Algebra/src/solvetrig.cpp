@@ -98,10 +98,10 @@ void findtrigvars( expr * & ex, vector<expr *> * &trigvars)
 	    else 
 	      {
 		if ((ex->etype != n_op) ||
-		     ((*((n_opexp *)ex)->args)[1]->etype != function))
+		     (((n_opexp *)ex)->args[1]->etype != function))
 		  throw(string(
 			"lost trig function in findtrivars, impossible"));
-		exfun = (functexp *)(*((n_opexp *)ex)->args)[1];
+		exfun = (functexp *)((n_opexp *)ex)->args[1];
 	      }
 	    for (k = 0; k < trigvars->size(); k++)
 	      {
@@ -130,8 +130,8 @@ void findtrigvars( expr * & ex, vector<expr *> * &trigvars)
       findtrigvars(((binopexp *)ex)->rhs,trigvars);
       return;
     case n_op:
-      for (k = 0; k < ((n_opexp *)ex)->args->size(); k++)
-	findtrigvars((*((n_opexp *)ex)->args)[k],trigvars);
+      for (k = 0; k < ((n_opexp *)ex)->args.size(); k++)
+	findtrigvars(((n_opexp *)ex)->args[k],trigvars);
       return;
     case unknown:
     case fake:
@@ -346,7 +346,7 @@ bool trigsearch(const expr * const arg, expr * & coef,
 #define DEBUG_TRIGSEARCH 0
 #if DEBUG_TRIGSEARCH
 #ifdef WITHDBG // for debugging
-  static int trigsearchcall=0;    
+  static thread_local int trigsearchcall=0;    
   int thiscall=trigsearchcall++;  
 #endif
   DBG( cout << "trigsearch call " << thiscall << " with arg "
@@ -538,30 +538,30 @@ bool trigsearch(const expr * const arg, expr * & coef,
 	  cf = new n_opexp(&mult); // keep empty until cos/sin found
 	  ov = new n_opexp(&mult);
 	  bool iscosthis;
-	  for (k = 0; k < ((n_opexp *)ex)->args->size(); k++)
+	  for (k = 0; k < ((n_opexp *)ex)->args.size(); k++)
 	    {
-	      if (!trigsearch(arg,cfe,(*((n_opexp *)ex)->args)[k],
+	      if (!trigsearch(arg,cfe,((n_opexp *)ex)->args[k],
 			      iscosthis,ove)) goto abort;
 	      if ((cfe->etype != numval) || ((numvalexp *)cfe)->value != 0)
 		{  // cfe != 0
-		  if (cf->args->size() > 0) {
+		  if (cf->args.size() > 0) {
 		    cfe->destroy(); ove->destroy();
 		    goto abort;		// found product of two expressions
 		  }
-		  if(ov->args->size() > 0) cf->addarg(copyexpr(ov));
+		  if(ov->args.size() > 0) cf->addarg(copyexpr(ov));
 		  cf->addarg(cfe);
 		  iscos = iscosthis;
 		}
 	      else 
 		{  // cfe = 0
-		  if (cf->args->size() > 0) cf->addarg(copyexpr(ove));
+		  if (cf->args.size() > 0) cf->addarg(copyexpr(ove));
 		  cfe->destroy();
 		} 
 	      ov->addarg(ove); // always multiply constant
 	    }
 	  // the code inside the if was executed unconditionally before
 	  // 1/24/01, and the else not there. I think thats wrong
-	  if (cf->args->size() > 0)
+	  if (cf->args.size() > 0)
 	    {
 	      coef = cf;
 	      flatten(coef);
@@ -586,13 +586,13 @@ bool trigsearch(const expr * const arg, expr * & coef,
 	  cf = new n_opexp(&myplus);
 	  ov = new n_opexp(&myplus);
 	  bool iscosthis;
-	  for (k = 0; k < ((n_opexp *)ex)->args->size(); k++)
+	  for (k = 0; k < ((n_opexp *)ex)->args.size(); k++)
 	    {
-	      if (!trigsearch(arg,cfe,(*((n_opexp *)ex)->args)[k],
+	      if (!trigsearch(arg,cfe,((n_opexp *)ex)->args[k],
 			      iscosthis,ove)) goto abort;
 	      if ((cfe->etype != numval) || ((numvalexp *)cfe)->value != 0)
 		{  // cfe != 0
-		  if ((cf->args->size() > 0) && (iscos != iscosthis))
+		  if ((cf->args.size() > 0) && (iscos != iscosthis))
 		    {
 		      cfe->destroy(); ove->destroy();
 		      goto abort;	 // found one sine and one cosine
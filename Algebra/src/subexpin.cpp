@@ -70,8 +70,8 @@ bool subexpin(expr * & target, const binopexp * assign)
       {
 	changed = false;
 	DBG( cout << "trying n_op " << target->getInfix() << endl; );
-	for (int k = 0; k < ((n_opexp *)target)->args->size(); k++)
-	  if (subexpin((*((n_opexp *)target)->args)[k], assign)) 
+	for (int k = 0; k < ((n_opexp *)target)->args.size(); k++)
+	  if (subexpin(((n_opexp *)target)->args[k], assign)) 
 	    changed = true;
 	return(changed);
       }
@@ -98,8 +98,8 @@ bool exprcontains(expr * e, int var)
     case n_op:
       {
 	n_opexp * nop = (n_opexp *)e;
-	for (int k=0; k < nop->args->size(); k++)
-	  if ( exprcontains((*nop->args)[k],var)) return(true);
+	for (int k=0; k < nop->args.size(); k++)
+	  if ( exprcontains(nop->args[k],var)) return(true);
 	return(false);
       }
     case unknown:
@@ -61,8 +61,8 @@ bool substin(expr * & target, const binopexp * assign)
       return(answer);
     case n_op:
       {
-	for (int k = 0; k < ((n_opexp *)target)->args->size(); k++)
-	  answer = substin((*((n_opexp *)target)->args)[k], assign) || answer;
+	for (int k = 0; k < ((n_opexp *)target)->args.size(); k++)
+	  answer = substin(((n_opexp *)target)->args[k], assign) || answer;
 	return(answer);
       }
     case unknown:
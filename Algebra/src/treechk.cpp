@@ -66,8 +66,8 @@ bool treechk(const expr * const ex, vector<expr *> * vchk)
       treechk(((binopexp *)ex)->rhs,vchk);
       break;
     case n_op:
-      for (k = 0; k < ((n_opexp *) ex)->args->size(); k++)
-	treechk((*((n_opexp *)ex)->args)[k],vchk);
+      for (k = 0; k < ((n_opexp *) ex)->args.size(); k++)
+	treechk(((n_opexp *)ex)->args[k],vchk);
       break;
     default:
       throw(string("unknown expr type in treechk"));
@@ -44,20 +44,20 @@ void trigsimp(expr * & ex)
   if (exfun->arg->etype != n_op) return;
   n_opexp *theta = (n_opexp *)exfun->arg;
   cleanup(theta);
-  if (theta->args->size() < 2)
+  if (theta->args.size() < 2)
     { exfun->arg = theta; unnop(exfun->arg); return;}
   double sign = 1.;
   if ((theta->op->opty == pluse) && 		// if the arg is of form
-      ((*theta->args)[0]->etype == numval))	// coef * var + phi( a num), 
+      (theta->args[0]->etype == numval))	// coef * var + phi( a num), 
     {							//  ...
-      double phi = ((numvalexp *)(*theta->args)[0])->value;
+      double phi = ((numvalexp *)theta->args[0])->value;
       // make sure unknown (or first part of it) has positive coefficient
-      if (((*theta->args)[1]->etype == n_op) &&
-	  (((n_opexp *)((*theta->args)[1]))->op->opty == multe) &&
-	  ((*((n_opexp *)((*theta->args)[1]))->args)[0]->etype == numval))
+      if ((theta->args[1]->etype == n_op) &&
+	  (((n_opexp *)(theta->args[1]))->op->opty == multe) &&
+	  (((n_opexp *)(theta->args[1]))->args[0]->etype == numval))
 	{
 	  numvalexp *coef = (numvalexp *)	 // first make coef nonnegative
-	    (*((n_opexp *)((*theta->args)[1]))->args)[0];
+	    ((n_opexp *)(theta->args[1]))->args[0];
 	  if (coef->value < 0.) 
 	    { 
 	      coef->value *= -1.;
@@ -85,13 +85,13 @@ void trigsimp(expr * & ex)
 	    }
 	  if (exfun->f->opty == tane) phi += M_PI/2;
 	}
-      ((numvalexp *)(*theta->args)[0])->value = phi;
+      ((numvalexp *)theta->args[0])->value = phi;
     } // end of if theta is plus starting with numval
   if ((theta->op->opty == multe) &&
-      ((*theta->args)[0]->etype == numval) &&
-      (((numvalexp *)((*theta->args)[0]))->value < 0))
+      (theta->args[0]->etype == numval) &&
+      (((numvalexp *)(theta->args[0]))->value < 0))
     {
-      ((numvalexp *)(*theta->args)[0])->value *= -1.;
+      ((numvalexp *)theta->args[0])->value *= -1.;
       if ((exfun->f->opty == sine) || (exfun->f->opty == tane))
 	sign *= -1.;
     }
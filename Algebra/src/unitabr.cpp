@@ -61,7 +61,8 @@ struct pfx {
 #include "prefixes.h"
 };
 
-unitabrs unittable;
+// filled before main and only read after, so shared by all threads
+const unitabrs unittable;
 
 unitabrs::unitabrs()   // fill up tables from utab
 {			     
@@ -82,7 +83,7 @@ unitabrs::unitabrs()   // fill up tables from utab
   }}
 }
 
-string unitabrs::match(const dimens dim)
+string unitabrs::match(const dimens dim) const
 {
   int j;
   for (j=0; j < abbrev.size(); j++)
@@ -95,7 +96,7 @@ string unitabrs::match(const dimens dim)
  *  unitget  takes a string representing an SI unit (with/wout prefix)	*
  *	and returns a numval for it. returns NULL if not found		*
  ************************************************************************/
-numvalexp * unitabrs::unitget(const string & unitname)
+numvalexp * unitabrs::unitget(const string & unitname) const
 {
   int k, q;
   numvalexp * retval;
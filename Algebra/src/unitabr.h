@@ -34,7 +34,9 @@ class unitabrs
   vector<double> pfxvals;
 public:
   unitabrs(void); 
-  string match(dimens);
+  string match(dimens) const;
   //   int size();
-  numvalexp * unitget(const string & unitname);
+  numvalexp * unitget(const string & unitname) const;
 };
+
+extern const unitabrs unittable;	// in unitabr.cpp
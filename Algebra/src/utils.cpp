@@ -35,18 +35,18 @@ string dtostr(double value)
   // The number of digits are supposed to match DBL_EPSILON
   // don't truncate nonzero numbers near zero
   if ((value==0. || fabs(value)>0.5) && lookslikeint(value,q))
-    sprintf(valuenum,"%d",q);
+    snprintf(valuenum,sizeof(valuenum),"%d",q);
   else if ((fabs(value) < 1.) && (fabs(value)> 0.001))
-    sprintf(valuenum,"%.17lf",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lf",value);
   else
-    sprintf(valuenum,"%.17lG",value);
+    snprintf(valuenum,sizeof(valuenum),"%.17lG",value);
   return(string(valuenum));
 }
 
 string itostr(int val)
 {
   char buf[13];
-  sprintf(buf,"%d",val);
+  snprintf(buf,sizeof(buf),"%d",val);
   return(string(buf));
 }
 
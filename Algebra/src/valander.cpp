@@ -62,7 +62,7 @@ valander * getvnd(const expr * ex, const vector<physvar *> * vars,
                   const vector<double> * sols) {
 
 #ifdef WITHDBG
-  static unsigned int valcount=0;
+  static thread_local unsigned int valcount=0;
   unsigned int thisdbg=valcount++;
 #endif
   DBG( cout << "valander " << thisdbg << " with " << ex->getInfix() << endl);
@@ -227,9 +227,9 @@ valander * getvnd(const expr * ex, const vector<physvar *> * vars,
 	    ret->value = 0;
 	    double absval = 0;
 	    vector<double> absgrad(vars->size(),0.);
-	    for (q = 0; q < exnop->args->size(); q++)
+	    for (q = 0; q < exnop->args.size(); q++)
 	      {
-		argvnd = getvnd((*exnop->args)[q],vars,sols);
+		argvnd = getvnd(exnop->args[q],vars,sols);
 		ret->value += argvnd->value;
 		absval += fabs(argvnd->value);
 		for (k = 0; k < vars->size(); k++) {
@@ -249,9 +249,9 @@ valander * getvnd(const expr * ex, const vector<physvar *> * vars,
 	  }
         case multe:
           ret->value = 1;
-          for (q = 0; q < exnop->args->size(); q++) 
+          for (q = 0; q < exnop->args.size(); q++) 
             {
-              argvnd = getvnd((*exnop->args)[q],vars,sols);
+              argvnd = getvnd(exnop->args[q],vars,sols);
 	      vector<double> absgrad(vars->size(),0.);
               for (k = 0; k < vars->size(); k++)
                 {
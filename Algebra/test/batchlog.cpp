@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////////
+// batchlog.cpp -- check that a solverBatch is logged as one call, not
+//                 as the calls it is made of, and that solver-replay
+//                 gets the same results from the log
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../src/Solver.h"
+#include "testcheck.h"
+using namespace std;
+
+static const char * const logFile = "batchlog.log";
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  solverStartLog(logFile);
+  solverDoLog("t");
+  solveClear();
+  string batch = solverBatch("(solveAdd (SVAR m kg)) (solveAdd (SVAR a m/s^2))"
+			     " (solveAdd (SVAR F N))"
+			     " (solveAdd (= m (DNUM 2.0 |kg|)))"
+			     " (solveAdd (= F (DNUM 10 |N|)))"
+			     " (solveAdd (= F (* m a)))");
+  expect("solverBatch", batch, "(\"t\" \"t\" \"t\" \"t\" \"t\" \"t\")");
+  solveBubble();
+  solverDoLog("nil");			// which writes out the log
+
+  // the calls logged, the lines not starting with //
+  ifstream in(logFile);
+  string line, calls;
+  while (getline(in, line))
+    if (line.compare(0, 2, "//") != 0) calls += line.substr(0, 12) + "\n";
+  if (calls != "solveClear()\nsolverBatch(\nsolveBubble(\n")
+    fail("the log has calls\n%s", calls.c_str());
+
+  if (system("../../solver-replay batchlog.log > batchlog.out") != 0) {
+    fail("solver-replay of the log:\n");
+    if (system("cat batchlog.out >&2") != 0) failures++;
+  }
+  remove(logFile);
+  remove("batchlog.out");
+  return(testsDone("batchlog"));
+}
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////
+// bigresult.cpp -- check that results much longer than 4K come back
+//                  whole: a 100 variable problem with long names, whose
+//                  solution is about 500K
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/Solver.h"
+#include "testcheck.h"
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  const int numvars = 100;
+  const int namelength = 5000;
+  vector<string> names;
+
+  for (int k = 0; k < numvars; k++) {
+    ostringstream name;
+    name << "v" << k << "_" << string(namelength, 'x');
+    names.push_back(name.str());
+  }
+
+  // v_k = k+1 m, except the last which is v_0 + v_1
+  expect("solveClear", solveClear(), "t");
+  for (int k = 0; k < numvars; k++)
+    expect("solveAdd SVAR",
+	   solveAdd(("(SVAR " + names[k] + " m)").c_str()), "t");
+  for (int k = 0; k < numvars - 1; k++) {
+    ostringstream eq;
+    eq << "(= " << names[k] << " (DNUM " << k + 1 << ".0 |m|))";
+    expect("solveAdd =", solveAdd(eq.str().c_str()), "t");
+  }
+  expect("solveAdd =", solveAdd(("(= " + names[numvars-1] + " (+ " +
+				 names[0] + " " + names[1] + "))").c_str()),
+	 "t");
+
+  // the solution, one variable per line, each line longer than 4K
+  size_t total = 0;
+  int lines = 0;
+  for (string line = solveBubble(); line != "nil" && lines <= numvars;
+       line = solveMoreBubble()) {
+    ostringstream want;
+    want << "(SVAR " << names[lines] << " "
+	 << (lines < numvars - 1 ? lines + 1 : 3) << " m )";
+    expect("solution line", line, want.str());
+    total += line.size();
+    lines++;
+  }
+  if (lines != numvars) fail("solution had %d lines\n", lines);
+  if (total < 100 * 4096) fail("solution was only %zu chars\n", total);
+
+  // the same solution all at once
+  string all = "((";
+  for (int k = 0; k < numvars; k++) {
+    ostringstream line;
+    line << (k ? " " : "") << "(SVAR " << names[k] << " "
+	 << (k < numvars - 1 ? k + 1 : 3) << " m )";
+    all += line.str();
+  }
+  expect("solveAll", solveAll(), all + "))");
+
+  // an error quoting a long argument is not cut off
+  string eq = "((= " + names[0] + string(namelength, 'y') + " (DNUM 1 |m|)))";
+  string err = c_indyIsStudentEquationOkay(eq.c_str());
+  if (err.size() < eq.size() || err.compare(0,13,"(solverError ") != 0 ||
+      err.find(eq) == string::npos)
+    fail("long error was %s\n", shown(err).c_str());
+
+  // a batch result longer than 4K
+  string batch;
+  for (int k = 0; k < 2000; k++) batch += "(c_indyEmpty) ";
+  string answer = solverBatch(batch.c_str());
+  if (answer.size() != 2000 * 4 + 1)
+    fail("batch answer was %zu chars\n", answer.size());
+
+  return(testsDone("bigresult"));
+}
@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * capi.c -- check the C interface to the solver, from C: contexts hold
+ *           problems of their own, results and errors come back in the
+ *           caller's buffer with their codes, and nothing goes to stdout
+ * Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+ *  This file is part of the Andes Solver.
+ *
+ *  The Andes Solver is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The Andes Solver is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "../src/solverapi.h"
+#include "testcheck.h"
+
+/* command should give code and, if want isn't 0, the string want */
+static void expect(solver_context * s, const char * command, const char * arg,
+		   int code, const char * want)
+{
+  char out[256];
+  size_t length;
+  int got = solver_call(s, command, arg, out, sizeof(out), &length);
+  if (got != code || (want && strcmp(out, want) != 0)) {
+    fail("%s %s gave %s %s, expected %s %s\n", command, arg ? arg : "",
+	 solver_code_name(got), got == SOLVER_OK || got == SOLVER_FAILED ?
+	 out : "", solver_code_name(code), want ? want : "");
+  }
+}
+
+static void load(solver_context * s, const char * mass)
+{
+  char eq[80];
+  expect(s, "c_indyEmpty", 0, SOLVER_OK, "t");
+  expect(s, "c_indyAddVariable", "(m 2.0 kg)", SOLVER_OK, "t");
+  expect(s, "c_indyAddVariable", "(a 3.0 m/s^2)", SOLVER_OK, "t");
+  expect(s, "c_indyAddVariable", "(F 6.0 N)", SOLVER_OK, "t");
+  expect(s, "c_indyDoneAddVariable", 0, SOLVER_OK, "t");
+  snprintf(eq, sizeof(eq), "(0 (= m (DNUM %s |kg|)))", mass);
+  expect(s, "c_indyAddEquation", eq, SOLVER_OK, "t");
+  expect(s, "c_indyAddEquation", "(1 (= F (* m a)))", SOLVER_OK, "t");
+}
+
+/* solves a problem in s, taking each line of the solution as it comes,
+ * with size bytes of room first and fetching it again if that isn't
+ * enough, and leaves the lines one after the other in all
+ */
+static void solve(solver_context * s, size_t size, char * all, size_t room)
+{
+  char out[256];
+  const char * command = "solveBubble";
+  size_t length;
+  int k, code;
+  static const char * statements[] = {
+    "(SVAR m kg)", "(SVAR a m/s^2)", "(SVAR F N)",
+    "(= m (DNUM 2.0 |kg|))", "(= F (DNUM 10 |N|))", "(= F (* m a))" };
+  expect(s, "solveClear", 0, SOLVER_OK, "t");
+  for (k = 0; k < sizeof(statements) / sizeof(statements[0]); k++)
+    expect(s, "solveAdd", statements[k], SOLVER_OK, "t");
+  all[0] = 0;
+  for (k = 0; k < 10; k++, command = "solveMoreBubble") {
+    code = solver_call(s, command, 0, out, size, &length);
+    if (code == SOLVER_TOO_SMALL)
+      code = solver_fetch_result(s, out, sizeof(out), &length);
+    if (code != SOLVER_OK) {
+      fail("%s gave %s\n", command, solver_code_name(code));
+      return;
+    }
+    if (strcmp(out, "nil") == 0) return;
+    if (strlen(all) + strlen(out) + 2 > room) break;
+    strcat(all, out);
+    strcat(all, "\n");
+  }
+  fail("the solution doesn't end\n");
+}
+
+int main(int argc, char* argv[]) {
+  int stdout_pipe[2];
+  char out[8], seen[64], whole[1024], fetched[1024];
+  size_t length;
+  solver_context * one = solver_open();
+  solver_context * two = solver_open();
+  if (one == 0 || two == 0) {
+    fprintf(stderr, "FAIL solver_open\n");
+    return(1);
+  }
+
+  /* anything written to stdout from here on is caught */
+  fflush(stdout);
+  if (pipe(stdout_pipe) != 0 || dup2(stdout_pipe[1], 1) < 0) {
+    fprintf(stderr, "FAIL can't catch stdout\n");
+    return(1);
+  }
+  expect(one, "solverDebugLevel", "0xFFFFFFFF", SOLVER_OK, "t");
+
+  /* each context has its own problem */
+  load(one, "2.0");
+  load(two, "2.0");
+  expect(two, "c_indyEmpty", 0, SOLVER_OK, "t");
+  expect(one, "c_indyIsStudentEquationOkay", "(= F (* m a))", SOLVER_OK, "0");
+  expect(two, "c_indyIsStudentEquationOkay", "(= F (* m a))", SOLVER_FAILED, 0);
+
+  /* errors come back as their descriptions */
+  expect(one, "c_indyStudentAddEquationOkay", "(4 (= mmm 2))", SOLVER_FAILED,
+	 "variable mmm not declared");
+  expect(one, "solverRestore", "/nonexistent", SOLVER_FAILED,
+	 "can't read checkpoint /nonexistent");
+  expect(one, "solverCreateSession", "x", SOLVER_UNKNOWN_COMMAND, 0);
+  expect(one, "c_indyAddEquation", 0, SOLVER_BAD_ARGUMENT, 0);
+  expect(one, "solverDebugLevel", "lots", SOLVER_BAD_ARGUMENT, 0);
+  expect(0, "solveClear", 0, SOLVER_BAD_ARGUMENT, 0);
+  expect(one, "solverDebugLevel", "0", SOLVER_OK, "t");
+
+  /* a result too long for the buffer is kept, and the call not repeated */
+  if (solver_call(one, "c_indyAddVariable", "(g 9.8 m/s^2)", out, 1,
+		  &length) != SOLVER_TOO_SMALL || length != 2 || out[0] != 0) {
+    fail("SOLVER_TOO_SMALL\n");
+  }
+  if (solver_fetch_result(one, out, 1, &length) != SOLVER_TOO_SMALL ||
+      solver_fetch_result(one, out, sizeof(out), &length) != SOLVER_OK ||
+      length != 2 || strcmp(out, "t") != 0 ||
+      solver_fetch_result(one, out, sizeof(out), &length) !=
+      SOLVER_BAD_ARGUMENT) {
+    fail("solver_fetch_result\n");
+  }
+  solve(one, 256, whole, sizeof(whole));
+  solve(two, 8, fetched, sizeof(fetched));
+  if (strstr(whole, "(SVAR F 10") == 0 || strcmp(whole, fetched) != 0) {
+    fail("solving with a small buffer gave\n%s"
+	 "rather than\n%s", fetched, whole);
+  }
+  if (solver_call(one, "solverStats", 0, out, sizeof(out), &length) !=
+      SOLVER_TOO_SMALL || length <= sizeof(out) ||
+      strlen(out) != sizeof(out) - 1) {
+    fail("solverStats into a small buffer\n");
+  }
+
+  solver_close(one);
+  solver_close(two);
+
+  /* nothing was written to stdout */
+  close(1);
+  close(stdout_pipe[1]);
+  if (read(stdout_pipe[0], seen, sizeof(seen)) > 0) {
+    fail("the solver wrote to stdout\n");
+  }
+  return(testsDone("capi"));
+}
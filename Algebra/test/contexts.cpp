@@ -0,0 +1,176 @@
+//////////////////////////////////////////////////////////////////////////////
+// contexts.cpp -- check that two SolverContexts used alternately
+//                 don't see each other's problem, nor do sessions that
+//                 share a problem of a library
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/decl.h"
+#include "../src/extstruct.h"
+#include "../src/Solver.h"
+#include "../src/indysgg.h"
+#include "testcheck.h"
+using namespace std;
+
+void makeProblemLibrary(const string & file, const vector<string> & names,
+			const vector<string> & images);	// in checkpoint.cpp
+
+static const char * const imageFile = "contexts.img";
+static const char * const libraryFile = "contexts.lib";
+
+static bool hasVar(const string & name)
+{
+  for (size_t k = 0; k < canonvars->size(); k++)
+    if ((*canonvars)[k]->clipsname == name) return(true);
+  return(false);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  SolverContext a, b;
+
+  // Problem a: F = m a with m = 2 kg, a = 3 m/s^2
+  // Problem b: x = 5 m
+  // Steps alternate between the two.
+  useSolverContext(&a);
+  expect("a c_indyEmpty", c_indyEmpty(), "t");
+  useSolverContext(&b);
+  expect("b c_indyEmpty", c_indyEmpty(), "t");
+  useSolverContext(&a);
+  expect("a c_indyAddVariable", c_indyAddVariable("(m 2.0 kg)"), "t");
+  useSolverContext(&b);
+  expect("b c_indyAddVariable", c_indyAddVariable("(x 5.0 m)"), "t");
+  useSolverContext(&a);
+  expect("a c_indyAddVariable", c_indyAddVariable("(a 3.0 m/s^2)"), "t");
+  expect("a c_indyAddVariable", c_indyAddVariable("(F 6.0 N)"), "t");
+  useSolverContext(&b);
+  expect("b c_indyDoneAddVariable", c_indyDoneAddVariable(), "t");
+  useSolverContext(&a);
+  expect("a c_indyDoneAddVariable", c_indyDoneAddVariable(), "t");
+  expect("a c_indyAddEquation",
+	 c_indyAddEquation("(0 (= F (* m a)))"), "t");
+  useSolverContext(&b);
+  expect("b c_indyAddEquation",
+	 c_indyAddEquation("(0 (= x (DNUM 5.0 |m|)))"), "t");
+
+  // each context has only its own variables and equations
+  useSolverContext(&a);
+  if (canonvars->size() != 3 || !hasVar("F") || hasVar("x")) {
+    fail("context a has wrong variables\n");
+  }
+  if (canoneqf->size() != 1) {
+    fail("context a has %zu equations\n", canoneqf->size());
+  }
+  useSolverContext(&b);
+  if (canonvars->size() != 1 || !hasVar("x") || hasVar("F")) {
+    fail("context b has wrong variables\n");
+  }
+
+  // and checks student equations against its own solution point
+  expect("b c_indyIsStudentEquationOkay",
+	 c_indyIsStudentEquationOkay("((= x (DNUM 5 |m|)))"), "0");
+  expectError("b c_indyIsStudentEquationOkay",
+	      c_indyIsStudentEquationOkay("((= F (DNUM 6 |N|)))"));
+  useSolverContext(&a);
+  expect("a c_indyIsStudentEquationOkay",
+	 c_indyIsStudentEquationOkay("((= F (DNUM 6 |N|)))"), "0");
+  expectError("a c_indyIsStudentEquationOkay",
+	      c_indyIsStudentEquationOkay("((= x (DNUM 5 |m|)))"));
+
+  // the string returned belongs to the context that returned it
+  useSolverContext(&a);
+  char * ra = c_indyIsStudentEquationOkay("((= F (DNUM 7 |N|)))");
+  string saved = ra;
+  useSolverContext(&b);
+  c_indyIsStudentEquationOkay("((= x (DNUM 5 |m|)))");
+  expect("a result after call in b", ra, saved);
+
+  // a node freed with another context current goes back to its own
+  // context, to be used again there
+  useSolverContext(&a);
+  numvalexp * node = new numvalexp(1.0);
+  void * where = node;
+  useSolverContext(&b);
+  delete node;
+  useSolverContext(&a);
+  node = new numvalexp(2.0);
+  if ((void *) node != where) {
+    fail("node freed in b not used again in a\n");
+  }
+  delete node;
+
+  // sessions that load the same problem of a library share its
+  // variables and equations, and solve it as its own session would,
+  // until one changes them
+  SolverContext e;
+  useSolverContext(&e);
+  expect("e solveClear", solveClear(), "t");
+  expect("e c_indyAddVariable", c_indyAddVariable("(m 2.0 kg)"), "t");
+  expect("e c_indyAddVariable", c_indyAddVariable("(a 3.0 m/s^2)"), "t");
+  expect("e c_indyAddVariable", c_indyAddVariable("(F 6.0 N)"), "t");
+  expect("e c_indyDoneAddVariable", c_indyDoneAddVariable(), "t");
+  expect("e c_indyAddEquation", c_indyAddEquation("(0 (= F (* m a)))"), "t");
+  expect("e c_indyAddEquation",
+	 c_indyAddEquation("(1 (= m (DNUM 2.0 |kg|)))"), "t");
+  expect("e c_indyAddEquation",
+	 c_indyAddEquation("(2 (= a (DNUM 3.0 |m/s^2|)))"), "t");
+  expect("e solverWriteProblemImage", solverWriteProblemImage(imageFile), "t");
+  string solution = solveAll();
+  makeProblemLibrary(libraryFile, vector<string>(1, "a"),
+		     vector<string>(1, imageFile));
+  expect("solverOpenProblemLibrary", solverOpenProblemLibrary(libraryFile),
+	 "t");
+  {
+    SolverContext c, d;
+    useSolverContext(&c);
+    expect("c solverLoadLibraryProblem", solverLoadLibraryProblem("a"), "t");
+    vector<physvar *> * shared = canonvars;
+    useSolverContext(&d);
+    expect("d solverLoadLibraryProblem", solverLoadLibraryProblem("a"), "t");
+    if (canonvars != shared || !hasVar("F")) {
+      fail("sessions of a library problem don't share its variables\n");
+    }
+    expect("d solveAll", solveAll(), solution);
+    expect("d c_indyIsStudentEquationOkay",
+	   c_indyIsStudentEquationOkay("((= F (DNUM 6 |N|)))"), "0");
+    if (canonvars != shared) {
+      fail("solving a library problem copied its variables\n");
+    }
+    useSolverContext(&c);
+    expect("c solveAdd", solveAdd("(nonnegative F)"), "t");
+    if (canonvars == shared || canoneqf->size() != 3) {
+      fail("c changed the variables it shares\n");
+    }
+    useSolverContext(&d);
+    for (size_t k = 0; k < canonvars->size(); k++)
+      if ((*canonvars)[k]->isnonneg)
+	fail("d sees the change made by c\n");
+  }
+  remove(imageFile);
+  remove(libraryFile);
+
+  // the default context has seen none of this
+  useSolverContext(0L);
+  if (canonvars != 0L && canonvars->size() != 0) {
+    fail("default context has variables\n");
+  }
+
+  return(testsDone("contexts"));
+}
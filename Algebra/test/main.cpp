@@ -16,7 +16,6 @@ RETURN_CSTRING solverDoLog(const char* const src);
 using namespace std; 
 
 #define LOGn(s) cout << s << endl
-extern vector<indyset> *listofsets;
 
 int indyCanonHowIndy(int setID, int eqnID, vector<int> * & linexpand,
 		     vector<int> * & mightdepend );
@@ -25,8 +24,6 @@ int indyStudHowIndy(int setID, int eqnID, vector<int> * & linexpand,
 string powersolve(const int howstrong, const string varname, 
 		  const int destslot);
 
-extern vector<valander *> *canongrads;
-extern vector<valander *> studgrads;
 void doinitinit();
 
 //////////////////////////////////////////////////////////////////////////////
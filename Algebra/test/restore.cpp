@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////
+// restore.cpp -- check that a checkpoint cut short or with bytes changed
+//                is refused, or read, without harm to the problem
+// Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+//  This file is part of the Andes Solver.
+//
+//  The Andes Solver is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  The Andes Solver is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include "../src/Solver.h"
+#include "testcheck.h"
+using namespace std;
+
+static const char * const goodFile = "restore.ckp";
+static const char * const badFile = "restore.bad";
+
+// what the problem answers, which a bad checkpoint must not change
+static string answers()
+{
+  return(string(c_indyCanonHowIndy("(0 1)")) + " " +
+	 c_indyStudHowIndy("(0 3)") + " " +
+	 c_indyIsStudentEquationOkay("((= F (DNUM 6 |N|)))"));
+}
+
+static void writeBytes(const string & bytes)
+{
+  ofstream out(badFile, ios::binary);
+  out.write(bytes.data(), bytes.size());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+  expect("solveClear", solveClear(), "t");
+  expect("c_indyEmpty", c_indyEmpty(), "t");
+  expect("c_indyAddVariable", c_indyAddVariable("(F 6.0 N)"), "t");
+  expect("c_indyAddVariable", c_indyAddVariable("(a 3.0 m/s^2)"), "t");
+  expect("c_indyAddVariable", c_indyAddVariable("(m 2.0 kg)"), "t");
+  expect("c_indyDoneAddVariable", c_indyDoneAddVariable(), "t");
+  expect("c_indyAddEquation", c_indyAddEquation("(0 (= F (* m a)))"), "t");
+  expect("c_indyAddEquation",
+	 c_indyAddEquation("(1 (= m (DNUM 2.0 |kg|)))"), "t");
+  expect("c_indyAddEq2Set", c_indyAddEq2Set("(0 0)"), "t");
+  c_indyStudentAddEquationOkay("(3 (= F (* m a)))");
+  string want = answers();
+
+  expect("solverCheckpoint", solverCheckpoint(goodFile), "t");
+  string bytes;
+  {
+    ifstream in(goodFile, ios::binary);
+    bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+  }
+
+  // every checkpoint cut short is refused, and the problem stays
+  for (size_t k = 0; k < bytes.size(); k++) {
+    writeBytes(bytes.substr(0, k));
+    if (string(solverRestore(badFile)) == "t") {
+      fail("solverRestore of the first %zu bytes worked\n", k);
+    }
+  }
+  expect("after cut checkpoints, answers", answers(), want);
+
+  // a changed byte may make a checkpoint which is still good, but nothing
+  // read from it may take the solver down, then or when it is replaced
+  for (size_t k = 0; k < bytes.size(); k++) {
+    string changed = bytes;
+    changed[k] ^= 0xff;
+    writeBytes(changed);
+    if (string(solverRestore(badFile)) == "t")
+      expect("solverRestore", solverRestore(goodFile), "t");
+  }
+  expect("after changed checkpoints, answers", answers(), want);
+
+  expect("solverRestore", solverRestore(goodFile), "t");
+  expect("after restore, answers", answers(), want);
+
+  remove(goodFile);
+  remove(badFile);
+  return(testsDone("restore"));
+}
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * testcheck.h -- what the test programs share: counting the checks that
+ *                fail, reporting them, and saying at the end whether all
+ *                passed. Reports go to stderr, as the solver may write
+ *                to stdout (and capi.c checks that it doesn't).
+ * Copyright 2009 by Kurt Vanlehn and Brett van de Sande
+ *  This file is part of the Andes Solver.
+ *
+ *  The Andes Solver is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The Andes Solver is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the Andes Solver.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+#ifndef TESTCHECK_INCLUDED
+#define TESTCHECK_INCLUDED
+
+#include <stdarg.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+/* a check failed: says what went wrong, as printf would */
+static inline void fail(const char * format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  fputs("FAIL ", stderr);
+  vfprintf(stderr, format, args);
+  va_end(args);
+  failures++;
+}
+
+/* the exit status of test name, having said if all passed */
+static inline int testsDone(const char * name)
+{
+  if (failures == 0) fprintf(stderr, "%s: all tests passed\n", name);
+  return(failures == 0 ? 0 : 1);
+}
+
+#ifdef __cplusplus
+#include <string>
+
+/* s, cut short if it is long */
+static inline std::string shown(const std::string & s)
+{
+  if (s.size() <= 80) return(s);
+  return(s.substr(0,80) + "... (" + std::to_string(s.size()) + " chars)");
+}
+
+/* call returned string should be want */
+static inline void expect(const std::string & call, const std::string & got,
+			  const std::string & want)
+{
+  if (got != want)
+    fail("%s returned %s, expected %s\n", call.c_str(), shown(got).c_str(),
+	 shown(want).c_str());
+}
+
+/* call should have returned a solverError */
+static inline void expectError(const std::string & call,
+			       const std::string & got)
+{
+  if (got.compare(0,13,"(solverError ") != 0)
+    fail("%s returned %s, expected an error\n", call.c_str(),
+	 shown(got).c_str());
+}
+#endif
+
+#endif
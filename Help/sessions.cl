@@ -146,7 +146,7 @@
 	  match::*word-count-memo*
 	  ;; Solver process (could easily be replaced by function argument
 	  ;; in solver-load and solver-unload)
-	  *process*
+	  *process* *solver-session* *solver-context*
 	  ;; slot mapping for Algebra/solver.cl
 	  *id-solver-slot-map* *solver-free-slots*
 	  ;; Session-specific variables in Help/Interface.cl
@@ -95,21 +95,19 @@ The solver,
     
 (defun send-solution-elements (Elts)
   "Send the list of elements to the solver checking for errors."
-  (let ((R))
-    (dolist (E Elts)
-      (setq R (Solver-send-problem-statement E))
-      (error-test R (list 'send-statement E)))))
+  (let ((R (solver-batch (mapcar #'solver-problem-statement-item Elts))))
+    (error-test (if (listp R) t R) 'send-statements)
+    (loop for E in Elts
+	  for Ri in R
+	  do (error-test Ri (list 'send-statement E)))))
 
 
 (defun collect-result-vals ()
-  "Collect the result values up to the specified StopVal."
-  (let ((S) (R (solver-solve-problem)))
+  "Collect the result values, last first, from the whole solution."
+  (let ((R (solver-solve-all)))
     (error-test R 'Solve-problem)
-    (loop while (not (null R))
-	do (push R S)
-	   (setq R (solver-solve-more-problem))
-	   (error-test R 'Solve-Problem))
-    S))
+    ;; the solved variables, then each tag followed by its lines
+    (reverse (apply #'append R))))
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ;; Debugging code.
@@ -107,15 +107,16 @@
   "Prime the Independence system with the vars and eqns indicies."
   (setq *Indy-Var-index* Vars)
   (setq *Indy-Eqn-Index* Eqns)
-  (solver-indyEmpty)
+  (reset-solver-slots)
   (setf *indyset0-in-use* NIL)
 
-  (dolist (v Vars)
-    (solver-indyAddVar V))
-  (solver-indyDoneAddVar)
-  
-  (dolist (E Eqns)
-    (apply #'solver-indyAddEquation E)))
+  ;; one solver turn for the lot
+  (solver-batch 
+   (append (list (list "c_indyEmpty"))
+	   (mapcar #'solver-indyAddVar-item Vars)
+	   (list (list "c_indyDoneAddVariable"))
+	   (mapcar #'(lambda (E) (apply #'solver-indyAddEquation-item E)) 
+		   Eqns))))
 
 
 ;;=============================================================================